@@ -23,14 +23,14 @@ copy ..\ACompiler\x64\Release\ACompiler.exe  %outputDir%\ACompiler.exe"
 
 
 :search_for_ascript
-@echo searching for AScript.lib
-if exist "ArtLibGenerator.exe" goto :lib_found
-	@echo file AScript.lib not found, git clone ArtCore to download it
+@echo generating AScript.lib
+python generate_artlib.py
+if not errorlevel 1 goto :lib_found
+	@echo generate_artlib.py failed, python 3 is needed to generate AScript.lib
 	pause
 	exit
 	
 :lib_found
-start ArtLibGenerator.exe
 copy AScript.lib  %outputDir%\AScript.lib"
 
 if not exist "x64\Release_windows\ArtCore.exe" goto :win_skip
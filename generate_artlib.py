@@ -0,0 +1,117 @@
+# Generate AScript.lib and CodeExecutor_functions_map.cpp from comments of built-in functions
+# in src/ArtCore/CodeExecutor/CodeExecutor_functions.cpp. Order of functions is function index
+# in bytecode. ArtCore.vcxproj run it before every build, files are written only if they change.
+# --check only compare generated files with files on disk, exit code is 1 if they differ.
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+SOURCE = os.path.join(ROOT, "src", "ArtCore", "CodeExecutor", "CodeExecutor_functions.cpp")
+MAP = os.path.join(ROOT, "src", "ArtCore", "CodeExecutor", "CodeExecutor_functions_map.cpp")
+LIB = os.path.join(ROOT, "AScript.lib")
+
+START = "//#AUTO_GENERATOR_START"
+SCOPES = {"//#PURE": "PURE", "//#LOCAL": "LOCAL"}
+MAX_ARGUMENTS = 10
+TYPES = {
+    "null": "NUL", "int": "INT", "float": "FLOAT", "bool": "BOOL", "instance": "INSTANCE",
+    "object": "OBJECT", "sprite": "SPRITE", "texture": "TEXTURE", "sound": "SOUND",
+    "music": "MUSIC", "font": "FONT", "point": "POINT", "rectangle": "RECT", "color": "COLOR",
+    "string": "STRING", "list": "LIST",
+}
+DECLARATION = re.compile(r"^//([A-Za-z]+) (\w+)\(([^)]*)\);")
+
+
+def variable_type(name, function):
+    if name.lower() not in TYPES:
+        sys.exit(f"{function}: unknown type '{name}'")
+    return "T::" + TYPES[name.lower()]
+
+
+def read_functions():
+    with open(SOURCE, encoding="utf-8") as file:
+        lines = file.read().split("\n")
+    if START not in lines:
+        sys.exit(f"{START} not found in {SOURCE}")
+    functions = []
+    scope = "GLOBAL"
+    for line in lines[lines.index(START) + 1:]:
+        if line in SCOPES:
+            scope = SCOPES[line]
+            continue
+        match = DECLARATION.match(line)
+        if match is None:
+            continue
+        return_type, name, arguments = match.groups()
+        arguments = [argument.split()[0] for argument in arguments.split(",") if argument.strip()]
+        if len(arguments) > MAX_ARGUMENTS:
+            sys.exit(f"{name}: more than {MAX_ARGUMENTS} arguments")
+        functions.append({
+            "declaration": line[2:],
+            "name": name,
+            "return": variable_type(return_type, name),
+            "arguments": [variable_type(argument, name) for argument in arguments],
+            "scope": scope,
+        })
+        scope = "GLOBAL"
+    return functions
+
+
+def read(path):
+    if not os.path.exists(path):
+        return None
+    with open(path, encoding="utf-8", newline="") as file:
+        return file.read()
+
+
+def write(path, text, check):
+    # unchanged file keep its time, so build do not compile it again
+    if read(path) == text:
+        return True
+    if check:
+        print(f"{path} is not generated from current comments, run generate_artlib.py")
+        return False
+    with open(path, "w", encoding="utf-8", newline="\n") as file:
+        file.write(text)
+    return True
+
+
+def main():
+    check = "--check" in sys.argv[1:]
+    functions = read_functions()
+    lib = "".join(function["declaration"] + "\n" for function in functions)
+
+    table = []
+    for function in functions:
+        arguments = "{ " + ", ".join(function["arguments"]) + " }" if function["arguments"] else "{}"
+        table.append(f'\t{{ "{function["name"]}", &CodeExecutor::{function["name"]}, {function["return"]}, '
+                     f'{arguments}, {len(function["arguments"])}, FunctionScope::{function["scope"]} }},\n')
+    table = ("#include \"CodeExecutor.h\"\n"
+             "//this file is generated by generate_artlib.py from comments in CodeExecutor_functions.cpp\n"
+             "//do not edit anything bellow, change comments and run generator again\n"
+             "#define T ArtCode::variable_type\n"
+             "constexpr CodeExecutor::BuiltinFunction CodeExecutor::Builtins[] = {\n"
+             + "".join(table) +
+             "};\n"
+             "#undef T\n"
+             "constexpr size_t CodeExecutor::BuiltinsCount = std::size(CodeExecutor::Builtins);\n"
+             "\n"
+             "void CodeExecutor::MapFunctions()\n"
+             "{\n"
+             "\tFunctionsMap.clear();\n"
+             "\tfor (const BuiltinFunction& function : Builtins) {\n"
+             "\t\tFunctionsMap[function.Name] = function.Function;\n"
+             "\t}\n"
+             "}\n"
+             "//end of file\n")
+    # both files are always tested, so every stale one is reported
+    valid = write(LIB, lib, check)
+    valid = write(MAP, table, check) and valid
+    if not valid:
+        sys.exit(1)
+    print(f"{len(functions)} functions in AScript.lib and CodeExecutor_functions_map.cpp")
+
+
+if __name__ == "__main__":
+    main()
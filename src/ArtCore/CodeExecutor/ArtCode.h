@@ -67,6 +67,7 @@ public:
 		(COLOR)
 		(STRING)
 		(ENUM) // as string, editor is responsible for good assign
+		(LIST) // after ENUM to keep values of older bytecode
 	)
 
 		const std::string Keywords[4] = {
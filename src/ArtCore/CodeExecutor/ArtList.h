@@ -0,0 +1,110 @@
+#pragma once
+#include <algorithm>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "SDL2/IncludeAll.h"
+
+// List variable of instance. Values are kept in one contiguous vector of element type,
+// type is set by first pushed value and reset by Clear. Functions return false if index
+// is out of range or value have other type than list.
+class ArtList final
+{
+public:
+	template <typename T>
+	bool Push(const T& value)
+	{
+		if (std::holds_alternative<std::monostate>(_data)) {
+			_data = std::vector<T>();
+		}
+		std::vector<T>* data = std::get_if<std::vector<T>>(&_data);
+		if (data == nullptr) return false;
+		data->push_back(value);
+		return true;
+	}
+
+	template <typename T>
+	bool Pop(T* value)
+	{
+		std::vector<T>* data = std::get_if<std::vector<T>>(&_data);
+		if (data == nullptr || data->empty()) return false;
+		*value = std::move(data->back());
+		data->pop_back();
+		return true;
+	}
+
+	template <typename T>
+	bool Get(const int index, T* value) const
+	{
+		const std::vector<T>* data = std::get_if<std::vector<T>>(&_data);
+		if (data == nullptr || index < 0 || index >= static_cast<int>(data->size())) return false;
+		*value = (*data)[index];
+		return true;
+	}
+
+	template <typename T>
+	bool Set(const int index, const T& value)
+	{
+		std::vector<T>* data = std::get_if<std::vector<T>>(&_data);
+		if (data == nullptr || index < 0 || index >= static_cast<int>(data->size())) return false;
+		(*data)[index] = value;
+		return true;
+	}
+
+	// index of first equal value or -1
+	template <typename T>
+	[[nodiscard]] int Find(const T& value) const
+	{
+		const std::vector<T>* data = std::get_if<std::vector<T>>(&_data);
+		if (data == nullptr) return -1;
+		for (size_t i = 0; i < data->size(); i++) {
+			if (Equal((*data)[i], value)) return static_cast<int>(i);
+		}
+		return -1;
+	}
+
+	[[nodiscard]] int Size() const
+	{
+		return std::visit([](const auto& data) -> int
+		{
+			if constexpr (std::is_same_v<std::decay_t<decltype(data)>, std::monostate>) return 0;
+			else return static_cast<int>(data.size());
+		}, _data);
+	}
+
+	void Clear()
+	{
+		_data = std::monostate();
+	}
+
+	// index of value type in variant, 0 if list do not have type yet
+	[[nodiscard]] int GetTypeIndex() const { return static_cast<int>(_data.index()); }
+	// values of list, nullptr if list have other type
+	template <typename T>
+	[[nodiscard]] const std::vector<T>* GetValues() const { return std::get_if<std::vector<T>>(&_data); }
+	// set type and return empty values
+	template <typename T>
+	std::vector<T>& SetValues() { return _data.emplace<std::vector<T>>(); }
+
+	// ascending, points by x and then by y
+	void Sort()
+	{
+		std::visit([](auto& data)
+		{
+			if constexpr (!std::is_same_v<std::decay_t<decltype(data)>, std::monostate>) {
+				std::ranges::sort(data, [](const auto& a, const auto& b) { return Less(a, b); });
+			}
+		}, _data);
+	}
+
+private:
+	std::variant<std::monostate, std::vector<int>, std::vector<float>, std::vector<SDL_FPoint>, std::vector<std::string>> _data;
+
+	template <typename T>
+	static bool Equal(const T& a, const T& b) { return a == b; }
+	static bool Equal(const SDL_FPoint& a, const SDL_FPoint& b) { return a.x == b.x && a.y == b.y; }
+	template <typename T>
+	static bool Less(const T& a, const T& b) { return a < b; }
+	static bool Less(const SDL_FPoint& a, const SDL_FPoint& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); }
+};
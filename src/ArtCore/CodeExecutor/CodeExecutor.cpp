@@ -8,6 +8,7 @@
 #include "CodeExecutor.h"
 
 #include <algorithm>
+#include <cctype>
 #include <ranges>
 
 #include "ArtCore/main.h"
@@ -15,100 +16,69 @@
 #include "ArtCore/Graphic/BackGroundRenderer.h"
 #include "ArtCore/Gui/Gui.h"
 #include "ArtCore/System/Core.h"
+#include "ArtCore/Scene/InstancePool.h"
 #include "ArtCore/Scene/Scene.h"
 #include "ArtCore/System/AssetManager.h"
 #include "ArtCore/Functions/SDL_FPoint_extend.h"
 #include "ArtCore/Functions/SDL_Color_extend.h"
 
-AStack<int> CodeExecutor::GlobalStack_int = AStack<int>();
-AStack<float> CodeExecutor::GlobalStack_float = AStack<float>();
-AStack<bool> CodeExecutor::GlobalStack_bool = AStack<bool>();
-AStack<Instance*> CodeExecutor::GlobalStack_instance = AStack<Instance*>();
-AStack<SDL_FPoint> CodeExecutor::GlobalStack_point = AStack<SDL_FPoint>();
-AStack<Rect> CodeExecutor::GlobalStack_rect = AStack<Rect>();
-AStack<SDL_Color> CodeExecutor::GlobalStack_color = AStack<SDL_Color>();
-AStack<std::string> CodeExecutor::GlobalStack_string = AStack<std::string>();
-
-std::vector<CodeExecutor::SuspendCodeStruct> CodeExecutor::_suspended_code;
-bool CodeExecutor::_have_suspended_code;
+std::vector<CodeExecutor::SuspendedFrame> CodeExecutor::_suspended_frames;
+int CodeExecutor::_suspended_frames_free = -1;
+std::vector<CodeExecutor::SuspendedTimer> CodeExecutor::_suspended_timers;
+Uint64 CodeExecutor::_suspended_sequence = 0;
+double CodeExecutor::_suspended_clock = 0.0;
+SDL_SpinLock CodeExecutor::_suspended_code_lock = 0;
 CodeExecutor::CodeExecutor()
 {
-	FunctionsMap = std::map<std::string, void(*)(Instance*)>();
-	FunctionsList = std::vector<void(*)(Instance*)>() ;
+	FunctionsMap = std::map<std::string, void(*)(ExecutionContext*, Instance*)>();
+	FunctionsList = std::vector<void(*)(ExecutionContext*, Instance*)>() ;
 	_instance_definitions = std::vector<InstanceDefinition>();
-	_suspended_code = std::vector<CodeExecutor::SuspendCodeStruct>();
-	_have_suspended_code = false;
 }
 
 bool CodeExecutor::LoadArtLib()
 {
 	MapFunctions();
+	FunctionsList.clear();
+	FunctionsList.reserve(BuiltinsCount);
+	FunctionsSignature.clear();
+	FunctionsSignature.reserve(BuiltinsCount);
+	for (size_t i = 0; i < BuiltinsCount; i++) {
+		const BuiltinFunction& function = Builtins[i];
+		FunctionsList.push_back(function.Function);
+		FunctionsSignature.push_back({ function.Return, { function.Arguments, function.Arguments + function.ArgumentsCount }, function.Scope });
+	}
+	return h_check_art_lib();
+}
+
+bool CodeExecutor::h_check_art_lib()
+{
 	const char* buffer = Func::ArchiveGetFileBuffer("files/AScript.lib", nullptr);
 	if (buffer == nullptr) {
-		return false;
+		// lib is only needed by editor
+		return true;
 	}
-	const std::string data(buffer);
-	Func::str_vec lines = Func::Explode(data, '\n');
-	
-	if (lines.empty()) {
-		return false;
-	}
-
-	FunctionsList.clear();
-	FunctionsList.reserve(FunctionsMap.size());
-
-	for (std::string& line : lines) {
-		if (line.substr(0,2) == "//") continue;
-		// tokenize
-		int phase = 0;
-		std::string tmp;
-		for (const char c : line)
-		{
-			switch (phase) {
-			case 0:
-				if (c == ' ') {
-					phase++;
-					tmp = "";
-				}
-				else {
-					tmp += c;
-				}
-				break;
-			case 1:
-				if (c == '(') {
-					phase++;
-					if (FunctionsMap.contains(tmp)) {
-						FunctionsList.push_back(FunctionsMap[tmp]);
-						//FunctionsMap.erase(tmp);
-					}
-					else {
-						FunctionsList.push_back(nullptr);
-						Console::WriteLine("function '"+ tmp+ "' not found");
-					}
-					tmp = "";
-					break;
-				}
-				else {
-					tmp += c;
-				}
-				break;
-			}
+	// only names are compared, types of call are checked by verifier
+	size_t index = 0;
+	for (const std::string& line : Func::Explode(std::string(buffer), '\n')) {
+		if (line.empty() || line.substr(0, 2) == "//") continue;
+		const size_t name_begin = line.find(' ') + 1;
+		const size_t name_end = line.find('(');
+		if (name_begin == 0 || name_end == std::string::npos || name_end < name_begin) continue;
+		const std::string name = line.substr(name_begin, name_end - name_begin);
+		if (index >= BuiltinsCount || name != Builtins[index].Name) {
+			Console::WriteLine("AScript.lib: function " + std::to_string(index) + " '" + name + "' is not in registry, game is compiled for other core version");
+			return false;
 		}
+		index++;
 	}
-	/*
-	if (!FunctionsMap.empty()) {
-		for (const auto& key : FunctionsMap | std::views::keys) {
-			Console::WriteLine("Function: '" + key + "' not found");
-		}
+	if (index != BuiltinsCount) {
+		Console::WriteLine("AScript.lib: declare " + std::to_string(index) + " functions, core have " + std::to_string(BuiltinsCount));
 	}
-	*/
-	FunctionsList.shrink_to_fit();
-	// free memory
-	//FunctionsMap.clear();
 	return true;
 }
 
 #define COMMAND ArtCode::Command
+#define OPCODE Instruction::Opcode
 
 // create new inspector, remember to delete it
 Inspector* CodeExecutor::CreateInspector(const std::string& code_file) const
@@ -203,7 +173,11 @@ bool CodeExecutor::LoadObjectDefinitions(const BackGroundRenderer* bgr, const in
 					Console::WriteLine("instance: '" + o_name + "' - wrong event '" + e_name + "'"); SDL_assert(false); return false;
 				}
 
-				instance._events.push_back(InstanceDefinition::EventData{ Event_fromString(e_name), static_cast<int>(f_size), f_code });
+				InstanceDefinition::EventData event_data{ Event_fromString(e_name), static_cast<int>(f_size), f_code, Program() };
+				if (!h_decode_program(event_data.code, f_code, f_size, o_name + "::" + e_name)) {
+					Console::WriteLine("instance: '" + o_name + "' - can not decode event '" + e_name + "'"); SDL_assert(false); return false;
+				}
+				instance.AddEvent(std::move(event_data));
 			}
 			else {
 				Console::WriteLine("instance: '" + o_name + "' - expected 'FUNCTION_DEFINITION' but " + std::to_string(code->Current()) + " is given"); SDL_assert(false); return false;
@@ -219,15 +193,14 @@ bool CodeExecutor::LoadObjectDefinitions(const BackGroundRenderer* bgr, const in
 		// give name if every is ok
 		instance.Template->Name = o_name;
 		// if have at least one event sort and add to definitions
-		if (!instance._events.empty()) {
-			std::sort(instance._events.begin(), instance._events.end());
+		if (instance.HandlerMask != 0) {
 			_instance_definitions.push_back(instance);
 
-			for (const InstanceDefinition::EventData& event : instance._events) {
-				instance.Template->EventFlag = (instance.Template->EventFlag | EventBitFromEvent(event.event));
+			for (int event = Event::EventInvalid + 1; event < Event::EventEND; event++) {
+				if (instance.HaveEvent(static_cast<Event>(event))) {
+					instance.Template->EventFlag = (instance.Template->EventFlag | EventBitFromEvent(static_cast<Event>(event)));
+				}
 			}
-
-			ExecuteScript(instance.Template, Event::DEF_VALUES);
 		}
 
 		bgr->SetProgress(
@@ -241,6 +214,71 @@ bool CodeExecutor::LoadObjectDefinitions(const BackGroundRenderer* bgr, const in
 		);
 
 	}
+
+	// other can point to any definition, so verify when all are loaded
+	for (const InstanceDefinition& definition : _instance_definitions) {
+		for (int event = Event::EventInvalid + 1; event < Event::EventEND; event++) {
+			if (definition.HaveEvent(static_cast<Event>(event)) && !h_verify_program(definition._events[event].code, definition)) {
+				Console::WriteLine("instance: '" + definition.Name + "' - event '" + Event_toString(static_cast<Event>(event)) + "' rejected by verifier"); SDL_assert(false); return false;
+			}
+		}
+	}
+	int resolved = 0;
+	for (InstanceDefinition& definition : _instance_definitions) {
+		for (int event = Event::EventInvalid + 1; event < Event::EventEND; event++) {
+			if (definition.HaveEvent(static_cast<Event>(event))) {
+				resolved += h_resolve_program(definition._events[event].code);
+			}
+		}
+	}
+	Console::WriteLine("constant names resolved in " + std::to_string(resolved) + " calls");
+	// local steps are executed on all workers before other steps
+	int step_count = 0;
+	int local_step_count = 0;
+	for (InstanceDefinition& definition : _instance_definitions) {
+		if (!definition.HaveEvent(Event::EvStep)) continue;
+		step_count++;
+		definition.LocalStep = h_is_local_program(definition._events[Event::EvStep].code);
+		if (definition.LocalStep) local_step_count++;
+	}
+	Console::WriteLine("step events: " + std::to_string(local_step_count) + " of " + std::to_string(step_count) + " are local");
+	// setup file: LowPriorityObjects=obj_a,obj_b
+	for (const std::string& name : Func::Split(Core::SD_GetString("LowPriorityObjects", ""), ',')) {
+		if (name.empty()) continue;
+		const auto it = std::ranges::find_if(_instance_definitions, [&](const InstanceDefinition& definition) { return definition.Name == name; });
+		if (it == _instance_definitions.end()) {
+			Console::WriteLine("LowPriorityObjects: object '" + name + "' not exists");
+			continue;
+		}
+		it->LowPriority = true;
+	}
+	for (InstanceDefinition& definition : _instance_definitions) {
+		int fused = 0;
+		for (int event = Event::EventInvalid + 1; event < Event::EventEND; event++) {
+			if (definition.HaveEvent(static_cast<Event>(event))) {
+				fused += h_fuse_program(definition._events[event].code);
+			}
+		}
+		if (fused > 0) {
+			Console::WriteLine("instance: '" + definition.Name + "' - fused " + std::to_string(fused) + " instructions");
+		}
+	}
+	// prefer transpiled scripts, code in editor can be newer so they are found by hash
+	if (NativeRegistry::Size() > 0) {
+		int native = 0;
+		for (InstanceDefinition& definition : _instance_definitions) {
+			for (int event = Event::EventInvalid + 1; event < Event::EventEND; event++) {
+				if (!definition.HaveEvent(static_cast<Event>(event))) continue;
+				InstanceDefinition::EventData& event_data = definition._events[event];
+				event_data.native = NativeRegistry::Find(NativeRegistry::Hash(event_data.data, event_data.size));
+				if (event_data.native != nullptr) native++;
+			}
+		}
+		Console::WriteLine("native scripts: " + std::to_string(native) + " of " + std::to_string(NativeRegistry::Size()) + " found");
+	}
+	for (const InstanceDefinition& definition : _instance_definitions) {
+		ExecuteScript(definition.Template, Event::DEF_VALUES);
+	}
 	return (!_instance_definitions.empty());
 }
 
@@ -280,6 +318,7 @@ bool CodeExecutor::LoadSceneTriggers()
 		} // variables
 
 		// events
+		int fused = 0;
 		while (code->GetNextCommand() != COMMAND::END || code->IsEnd()) {
 			if (code->GetCurrentCommand() != COMMAND::FUNCTION_DEFINITION) {
 				Console::WriteLine("LoadSceneTriggers: '" + o_name + "' - expected 'FUNCTION_DEFINITION' but " + std::to_string(code->Current()) + " is given");
@@ -302,6 +341,12 @@ bool CodeExecutor::LoadSceneTriggers()
 				}
 				// scene accept only def values event, every other is trigger
 				if (Event_fromString(e_name) == Event::DEF_VALUES) {
+					const Program* program = GetProgram(f_code, f_size, o_name + "::" + e_name, instance);
+					if (program == nullptr)
+					{
+						ASSERT(false, "x08"); return false;
+					}
+					fused += program->Fused;
 					std::pair def_values_code = { f_code, static_cast<Sint64>(f_size) };
 					ExecuteCode(instance.Template, &def_values_code);
 				}else
@@ -313,6 +358,13 @@ bool CodeExecutor::LoadSceneTriggers()
 						ASSERT(false, "x04"); return false;
 					}else
 					{
+						// decode now, not when trigger is executed
+						const Program* program = GetProgram(f_code, f_size, o_name + "::" + e_name, instance);
+						if (program == nullptr)
+						{
+							ASSERT(false, "x08"); return false;
+						}
+						fused += program->Fused;
 						if(trigger_type[0] == "scene")
 						{
 							// triggers
@@ -350,6 +402,9 @@ bool CodeExecutor::LoadSceneTriggers()
 			Console::WriteLine("LoadSceneTriggers 'END' but " + std::to_string(code->Current()) + " is given");
 			ASSERT(false, "x07"); return false;
 		}
+		if (fused > 0) {
+			Console::WriteLine("LoadSceneTriggers: '" + o_name + "' - fused " + std::to_string(fused) + " instructions");
+		}
 
 		// execute only starting event
 		Core::GetCurrentScene()->SetVariableHolder( new Instance(*instance.Template) );
@@ -365,31 +420,13 @@ void CodeExecutor::Delete()
 	_instance_definitions.clear();
 }
 
-int CodeExecutor::GetGlobalStackSize()
+int CodeExecutor::GetGlobalStackSize() const
 {
-	int size = 0;
-	size += GlobalStack_int.Size();
-	size += GlobalStack_float.Size();
-	size += GlobalStack_bool.Size();
-	size += GlobalStack_instance.Size();
-	size += GlobalStack_point.Size();
-	size += GlobalStack_rect.Size();
-	size += GlobalStack_color.Size();
-	size += GlobalStack_string.Size();
-	return size;
+	return _main_context.Stack.Size();
 }
-int CodeExecutor::GetGlobalStackCapacity()
+int CodeExecutor::GetGlobalStackCapacity() const
 {
-	int size = 0;
-	size += GlobalStack_int.Capacity();
-	size += GlobalStack_float.Capacity();
-	size += GlobalStack_bool.Capacity();
-	size += GlobalStack_instance.Capacity();
-	size += GlobalStack_point.Capacity();
-	size += GlobalStack_rect.Capacity();
-	size += GlobalStack_color.Capacity();
-	size += GlobalStack_string.Capacity();
-	return size;
+	return _main_context.Stack.Capacity();
 }
 
 #ifdef _DEBUG
@@ -408,16 +445,16 @@ std::string CodeExecutor::DebugGetTrackInfo()
 		_return += "No target, turn console and use spy <id>";
 		return _return;
 	}
-	_return += "Name: [" + _debug_tracked_instance->Name + "]\n";
+	_return += "Name: [" + _debug_tracked_instance->Name.Str() + "]\n";
 	if (_debug_tracked_instance->GetInstanceDefinitionId() >= 0) { // instance or scene
-		_return += "Tag: [" + _debug_tracked_instance->Tag + "]\n";
+		_return += "Tag: [" + _debug_tracked_instance->Tag.Str() + "]\n";
 		_return += "ID: [" + std::to_string(_debug_tracked_instance->GetId()) + "]\n";
 		_return += "Build in vars\n";
-		_return += "Position: " + std::to_string(_debug_tracked_instance->PosX) + "," + std::to_string(_debug_tracked_instance->PosY) + "\n";
-		_return += "Direction: [" + std::to_string(_debug_tracked_instance->Direction) + "(" + std::to_string(Convert::RadiansToDegree(_debug_tracked_instance->Direction)) + ")" + "]\n";
-		_return += "In view: [" + std::string(_debug_tracked_instance->InView ? "true" : "false") + "]\n";
+		_return += "Position: " + std::to_string(_debug_tracked_instance->PosX()) + "," + std::to_string(_debug_tracked_instance->PosY()) + "\n";
+		_return += "Direction: [" + std::to_string(_debug_tracked_instance->Direction()) + "(" + std::to_string(Convert::RadiansToDegree(_debug_tracked_instance->Direction())) + ")" + "]\n";
+		_return += "In view: [" + std::string(_debug_tracked_instance->InView() ? "true" : "false") + "]\n";
 		_return += "Collider: [" + std::string(_debug_tracked_instance->IsCollider ? "true" : "false") + "]\n";
-		_return += "Alive: [" + std::string(_debug_tracked_instance->Alive ? "true" : "false") + "]\n";
+		_return += "Alive: [" + std::string(_debug_tracked_instance->Alive() ? "true" : "false") + "]\n";
 		_return += "Body type: [" + Instance::BodyType::Body_toString(_debug_tracked_instance->Body.Type) + "]" + " value: " +std::to_string(_debug_tracked_instance->Body.Value) + "\n";
 		_return += "Sprite data\n";
 		if (_debug_tracked_instance->SelfSprite == nullptr)
@@ -454,97 +491,117 @@ std::string CodeExecutor::DebugGetTrackInfo()
 				_return += basic_string + ": [";
 				switch (val.first) {
 				case ArtCode::INT:
-					_return += std::to_string(_debug_tracked_instance->Variables_int[i]);
+					_return += std::to_string(_debug_tracked_instance->Variables.Get<ArtCode::INT>(i));
 					break;
 				case ArtCode::FLOAT:
-					_return += std::to_string(_debug_tracked_instance->Variables_float[i]);
+					_return += std::to_string(_debug_tracked_instance->Variables.Get<ArtCode::FLOAT>(i));
 					break;
 				case ArtCode::BOOL:
-					_return += _debug_tracked_instance->Variables_bool[i] ? "true" : "false";
+					_return += _debug_tracked_instance->Variables.Get<ArtCode::BOOL>(i) ? "true" : "false";
 					break;
 				case ArtCode::INSTANCE:
-					if(_debug_tracked_instance->Variables_instance[i] == nullptr)
+					if(const Instance* target = h_instance(_debug_tracked_instance->Variables.Get<ArtCode::INSTANCE>(i)); target == nullptr)
 					{
 						_return += "<null>";
 					}
 					else {
-						_return += _debug_tracked_instance->Variables_instance[i]->Name + "#" + _debug_tracked_instance->Variables_instance[i]->Tag + "(" + std::to_string(_debug_tracked_instance->Variables_instance[i]->GetId()) + ")";
+						_return += target->Name.Str() + "#" + target->Tag.Str() + "(" + std::to_string(target->GetId()) + ")";
 					}
 					break;
 				case ArtCode::OBJECT:
-					if (_debug_tracked_instance->Variables_object[i] == -1)
+					if (_debug_tracked_instance->Variables.Get<ArtCode::OBJECT>(i) == -1)
 					{
 						_return += "<null>";
 					}
 					else {
-						_return += _instance_definitions[_debug_tracked_instance->Variables_object[i]].Name;
+						_return += _instance_definitions[_debug_tracked_instance->Variables.Get<ArtCode::OBJECT>(i)].Name;
 					}
 					break;
 				case ArtCode::SPRITE:
-					if (_debug_tracked_instance->Variables_sprite[i] == -1)
+					if (_debug_tracked_instance->Variables.Get<ArtCode::SPRITE>(i) == -1)
 					{
 						_return += "<null>";
 					}
 					else {
-						_return += Core::GetAssetManager()->Debug_List_sprite_name[_debug_tracked_instance->Variables_sprite[i]];
+						_return += Core::GetAssetManager()->Debug_List_sprite_name[_debug_tracked_instance->Variables.Get<ArtCode::SPRITE>(i)];
 					}
 					break;
 				case ArtCode::TEXTURE:
-					if (_debug_tracked_instance->Variables_texture[i] == -1)
+					if (_debug_tracked_instance->Variables.Get<ArtCode::TEXTURE>(i) == -1)
 					{
 						_return += "<null>";
 					}
 					else {
-						_return += Core::GetAssetManager()->Debug_List_texture_name[_debug_tracked_instance->Variables_texture[i]];
+						_return += Core::GetAssetManager()->Debug_List_texture_name[_debug_tracked_instance->Variables.Get<ArtCode::TEXTURE>(i)];
 					}
 					break;
 				case ArtCode::SOUND:
-					if (_debug_tracked_instance->Variables_sound[i] == -1)
+					if (_debug_tracked_instance->Variables.Get<ArtCode::SOUND>(i) == -1)
 					{
 						_return += "<null>";
 					}
 					else {
-						_return += Core::GetAssetManager()->Debug_List_sound_name[_debug_tracked_instance->Variables_sound[i]];
+						_return += Core::GetAssetManager()->Debug_List_sound_name[_debug_tracked_instance->Variables.Get<ArtCode::SOUND>(i)];
 					}
 					break;
 				case ArtCode::MUSIC:
-					if (_debug_tracked_instance->Variables_music[i] == -1)
+					if (_debug_tracked_instance->Variables.Get<ArtCode::MUSIC>(i) == -1)
 					{
 						_return += "<null>";
 					}
 					else {
-						_return += Core::GetAssetManager()->Debug_List_music_name[_debug_tracked_instance->Variables_music[i]];
+						_return += Core::GetAssetManager()->Debug_List_music_name[_debug_tracked_instance->Variables.Get<ArtCode::MUSIC>(i)];
 					}
 					break;
 				case ArtCode::FONT:
-					if (_debug_tracked_instance->Variables_font[i] == -1)
+					if (_debug_tracked_instance->Variables.Get<ArtCode::FONT>(i) == -1)
 					{
 						_return += "<null>";
 					}
 					else {
-						_return += Core::GetAssetManager()->Debug_List_font_name[_debug_tracked_instance->Variables_font[i]];
+						_return += Core::GetAssetManager()->Debug_List_font_name[_debug_tracked_instance->Variables.Get<ArtCode::FONT>(i)];
 					}
 					break;
 				case ArtCode::POINT:
-					_return += "<" + std::to_string(_debug_tracked_instance->Variables_point[i].x) + ", " + std::to_string(_debug_tracked_instance->Variables_point[i].y) + ">";
+					_return += "<" + std::to_string(_debug_tracked_instance->Variables.Get<ArtCode::POINT>(i).x) + ", " + std::to_string(_debug_tracked_instance->Variables.Get<ArtCode::POINT>(i).y) + ">";
 					break;
 				case ArtCode::RECT:
 					_return += "<" + 
-						std::to_string(_debug_tracked_instance->Variables_rect[i].X) + ", " + 
-						std::to_string(_debug_tracked_instance->Variables_rect[i].Y) + ", " + 
-						std::to_string(_debug_tracked_instance->Variables_rect[i].W) + ", " + 
-						std::to_string(_debug_tracked_instance->Variables_rect[i].H) + ">";
+						std::to_string(_debug_tracked_instance->Variables.Get<ArtCode::RECT>(i).X) + ", " + 
+						std::to_string(_debug_tracked_instance->Variables.Get<ArtCode::RECT>(i).Y) + ", " + 
+						std::to_string(_debug_tracked_instance->Variables.Get<ArtCode::RECT>(i).W) + ", " + 
+						std::to_string(_debug_tracked_instance->Variables.Get<ArtCode::RECT>(i).H) + ">";
 					break;
 				case ArtCode::COLOR:
 					_return += "(" +
-						std::to_string(_debug_tracked_instance->Variables_color[i].r) + ", " +
-						std::to_string(_debug_tracked_instance->Variables_color[i].g) + ", " +
-						std::to_string(_debug_tracked_instance->Variables_color[i].b) + ", " +
-						std::to_string(_debug_tracked_instance->Variables_color[i].a) + ") ";
-					_return += Convert::Color2Hex(_debug_tracked_instance->Variables_color[i]);
+						std::to_string(_debug_tracked_instance->Variables.Get<ArtCode::COLOR>(i).r) + ", " +
+						std::to_string(_debug_tracked_instance->Variables.Get<ArtCode::COLOR>(i).g) + ", " +
+						std::to_string(_debug_tracked_instance->Variables.Get<ArtCode::COLOR>(i).b) + ", " +
+						std::to_string(_debug_tracked_instance->Variables.Get<ArtCode::COLOR>(i).a) + ") ";
+					_return += Convert::Color2Hex(_debug_tracked_instance->Variables.Get<ArtCode::COLOR>(i));
 					break;
 				case ArtCode::STRING:
-					_return += _debug_tracked_instance->Variables_string[i];
+					_return += _debug_tracked_instance->Variables.Get<ArtCode::STRING>(i);
+					break;
+				case ArtCode::LIST:
+				{
+					const ArtList& list = _debug_tracked_instance->Variables.Get<ArtCode::LIST>(i);
+					_return += "size " + std::to_string(list.Size()) + ":";
+					// long lists are cut, panel have limited height
+					constexpr size_t max_shown = 16;
+					auto values = [&]<typename T>(const std::vector<T>* data, auto to_string)
+					{
+						if (data == nullptr) return;
+						for (size_t v = 0; v < data->size() && v < max_shown; v++) {
+							_return += " " + to_string((*data)[v]);
+						}
+						if (data->size() > max_shown) _return += " ...";
+					};
+					values(list.GetValues<int>(), [](const int value) { return std::to_string(value); });
+					values(list.GetValues<float>(), [](const float value) { return std::to_string(value); });
+					values(list.GetValues<SDL_FPoint>(), [](const SDL_FPoint value) { return "<" + std::to_string(value.x) + ", " + std::to_string(value.y) + ">"; });
+					values(list.GetValues<std::string>(), [](const std::string& value) { return "\"" + value + "\""; });
+				}
 					break;
 				}
 				_return += "]\n";
@@ -557,308 +614,708 @@ std::string CodeExecutor::DebugGetTrackInfo()
 
 Instance* CodeExecutor::SpawnInstance(const std::string& name) const
 {
-	int id = -1;
-	for (auto& ins : _instance_definitions) {
-		id++;
-		if (ins.Name == name) {
-			return SpawnInstance(id);
+	const int id = FindInstanceDefinitionId(name);
+	return id == -1 ? nullptr : SpawnInstance(id);
+}
+
+int CodeExecutor::FindInstanceDefinitionId(const std::string& name) const
+{
+	for (size_t id = 0; id < _instance_definitions.size(); id++) {
+		if (_instance_definitions[id].Name == name) {
+			return static_cast<int>(id);
 		}
 	}
-	return nullptr;
+	return -1;
 }
 
 Instance* CodeExecutor::SpawnInstance(const int id) const
 {
-	Instance* instance = new Instance(*_instance_definitions[id].Template);
-	return instance->GiveId();
+	return InstancePool::Create(*_instance_definitions[id].Template);
+}
+
+Instance* CodeExecutor::h_spawn_instance(ExecutionContext* context, const std::string& name, const float x, const float y)
+{
+	Instance* instance = Core::Executor()->SpawnInstance(name);
+	if (instance == nullptr) return nullptr;
+	instance->PosX() = x;
+	instance->PosY() = y;
+	// reference can be stored before instance is added to scene
+	Core::GetCurrentScene()->InstanceHandles.Add(instance);
+	context->Commands.SpawnInstance(instance);
+	return instance;
+}
+
+Instance* CodeExecutor::h_spawn_instance(ExecutionContext* context, const int id, const float x, const float y)
+{
+	// id can be also given by script variable
+	if (id < 0 || static_cast<size_t>(id) >= Core::Executor()->_instance_definitions.size()) return nullptr;
+	Instance* instance = Core::Executor()->SpawnInstance(id);
+	instance->PosX() = x;
+	instance->PosY() = y;
+	Core::GetCurrentScene()->InstanceHandles.Add(instance);
+	context->Commands.SpawnInstance(instance);
+	return instance;
+}
+
+Instance* CodeExecutor::h_instance(const InstanceHandle handle)
+{
+	return Core::GetCurrentScene()->InstanceHandles.Get(handle);
+}
+
+InstanceHandle CodeExecutor::h_handle(const Instance* instance)
+{
+	return instance == nullptr ? InstanceHandle() : instance->GetHandle();
 }
 
 void CodeExecutor::ExecuteCode(Instance* instance, std::pair<const unsigned char*, Sint64>* code_data)
 {
-	if (code_data == nullptr) return;
-	_if_test_result.Erase();
+	ExecuteCode(&_main_context, instance, code_data);
+}
 
-#ifndef _DEBUG
-	Inspector code(code_data->first, code_data->second);
-#else
-	Inspector code(code_data->first, code_data->second, "Execute script");
-#endif
-	h_execute_script(&code, instance);
+void CodeExecutor::ExecuteCode(ExecutionContext* context, Instance* instance, std::pair<const unsigned char*, Sint64>* code_data)
+{
+	if (code_data == nullptr) return;
+	const Program* program = FindProgram(code_data->first);
+	if (program == nullptr) {
+		Console::WriteLine("CodeExecutor::ExecuteCode() - code is not loaded");
+		return;
+	}
+	context->IfTestResult.Erase();
+
+	const bool profile = ScriptProfiler::Enabled;
+	if (profile) context->Profile.BeginScript(program);
+	// triggers can be executed from other script
+	ProgramFrame* previous_frame = context->Frame;
+	const OperandStack::Mark stack_mark = context->Stack.GetMark();
+	ProgramFrame code(program);
+	h_execute_script(context, &code, instance);
+	context->Stack.Truncate(stack_mark);
+	context->Frame = previous_frame;
+	if (profile) context->Profile.End();
 }
 
 void CodeExecutor::ExecuteScript(Instance* instance, const Event script)
+{
+	ExecuteScript(&_main_context, instance, script);
+}
+
+void CodeExecutor::ExecuteScript(ExecutionContext* context, Instance* instance, const Event script)
 {
 	if (instance == nullptr) return;
 	if (script == Event::EventInvalid) return;
 	CodeExecutor::InstanceDefinition::EventData* code_data = CodeExecutor::GetEventData(instance->GetInstanceDefinitionId(), script);
 	// no error because GetEventData print error
 	if (code_data == nullptr) return;
-	_if_test_result.Erase();
-	
-#ifndef _DEBUG
-	Inspector code(code_data->data, code_data->size);
-#else
-	Inspector code(code_data->data, code_data->size, Event_toString(script));
-#endif
-	h_execute_script(&code, instance);
+	context->IfTestResult.Erase();
+
+	const bool profile = ScriptProfiler::Enabled;
+	if (profile) context->Profile.BeginScript(&code_data->code);
+	ProgramFrame* previous_frame = context->Frame;
+	// values not used by script are dropped, so stack do not grow every frame
+	const OperandStack::Mark stack_mark = context->Stack.GetMark();
+	ProgramFrame code(&code_data->code);
+	if (code_data->native != nullptr) {
+		context->Frame = &code;
+		code_data->native(this, context, &code, instance);
+	}
+	else {
+		h_execute_script(context, &code, instance);
+	}
+	context->Stack.Truncate(stack_mark);
+	context->Frame = previous_frame;
+	if (profile) context->Profile.End();
 }
 
+bool CodeExecutor::h_decode_program(Program& program, const unsigned char* code, const Sint64 size, const std::string& name)
+{
+	if (!program.Decode(code, size, name)) return false;
+	program.Thread(OpHandlers);
+	return true;
+}
 
+int CodeExecutor::h_fuse_program(Program& program)
+{
+	const int fused = program.Fuse();
+	if (fused > 0) {
+		program.Thread(OpHandlers);
+	}
+	return fused;
+}
 
-void CodeExecutor::EraseGlobalStack()
+namespace
 {
-	GlobalStack_int.Erase();
-	GlobalStack_float.Erase();
-	GlobalStack_bool.Erase();
-	GlobalStack_instance.Erase();
-	GlobalStack_point.Erase();
-	GlobalStack_rect.Erase();
-	GlobalStack_color.Erase(); 
-	GlobalStack_string.Erase();
+	enum class ConstantName { SPRITE, TEXTURE, MUSIC, SOUND, FONT, OBJECT };
+	// built-ins that take name as first argument
+	struct ConstantCall
+	{
+		const char* Function;
+		// same function that take id, nullptr if call is replaced by id
+		const char* FastFunction;
+		ConstantName Name;
+	};
+	constexpr ConstantCall ConstantCalls[] = {
+		{ "get_sprite", nullptr, ConstantName::SPRITE },
+		{ "get_texture", nullptr, ConstantName::TEXTURE },
+		{ "get_music", nullptr, ConstantName::MUSIC },
+		{ "get_sound", nullptr, ConstantName::SOUND },
+		{ "get_font", nullptr, ConstantName::FONT },
+		{ "instance_spawn", "instance_spawn_id", ConstantName::OBJECT },
+		{ "instance_spawn_on_point", "instance_spawn_on_point_id", ConstantName::OBJECT },
+		{ "instance_create", "instance_create_id", ConstantName::OBJECT },
+		{ "instance_create_point", "instance_create_point_id", ConstantName::OBJECT },
+	};
+}
+
+int CodeExecutor::h_resolve_program(Program& program) const
+{
+	const auto function_index = [](const std::string_view name)
+	{
+		for (size_t i = 0; i < BuiltinsCount; i++) {
+			if (name == Builtins[i].Name) return static_cast<int>(i);
+		}
+		return -1;
+	};
+	const auto resolve = [&](const ConstantName name, const std::string& value)
+	{
+		switch (name) {
+		case ConstantName::SPRITE:	return Core::GetAssetManager()->GetSpriteId(value);
+		case ConstantName::TEXTURE:	return Core::GetAssetManager()->GetTextureId(value);
+		case ConstantName::MUSIC:	return Core::GetAssetManager()->GetMusicId(value);
+		case ConstantName::SOUND:	return Core::GetAssetManager()->GetSoundId(value);
+		case ConstantName::FONT:	return Core::GetAssetManager()->GetFontId(value);
+		case ConstantName::OBJECT:	return FindInstanceDefinitionId(value);
+		}
+		return -1;
+	};
+
+	// values of current statement, first instruction that push it
+	struct Value
+	{
+		int Start;
+		bool Literal;
+	};
+	std::vector<Value> stack;
+	std::vector<bool> removed(program.Code.size(), false);
+	size_t statement = 0;
+	int resolved = 0;
+	for (int i = 0; i < program.GetSize(); i++) {
+		Instruction& instruction = program.Code[i];
+		while (statement < program.Statements.size() && program.Statements[statement] <= i) {
+			stack.clear();
+			statement++;
+		}
+		switch (instruction.Op) {
+		case OPCODE::PUSH_INT:
+		case OPCODE::PUSH_FLOAT:
+		case OPCODE::PUSH_BOOL:
+		case OPCODE::PUSH_INSTANCE:
+		case OPCODE::PUSH_POINT:
+		case OPCODE::PUSH_RECT:
+		case OPCODE::PUSH_COLOR:
+		case OPCODE::PUSH_LOCAL:
+		case OPCODE::PUSH_OTHER:
+			stack.push_back({ i, false });
+			break;
+		case OPCODE::PUSH_STRING:
+			stack.push_back({ i, true });
+			break;
+		case OPCODE::CALL: {
+			const size_t count = std::min(static_cast<size_t>(instruction.B), stack.size());
+			const int start = count > 0 ? stack[stack.size() - count].Start : i;
+			const bool literal = count > 0 && stack[stack.size() - count].Literal;
+			stack.resize(stack.size() - count);
+			// null arguments are not pushed, first one is known only if all are on stack
+			if (literal && instruction.A == instruction.B) {
+				const std::string_view name = Builtins[instruction.Operand].Name;
+				const auto call = std::ranges::find_if(ConstantCalls, [&](const ConstantCall& c) { return name == c.Function; });
+				if (call != std::end(ConstantCalls)) {
+					Instruction& argument = program.Code[start];
+					const int fast_function = call->FastFunction == nullptr ? -1 : function_index(call->FastFunction);
+					// unknown name is reported by function when it is called
+					if (const int id = resolve(call->Name, program.LiteralString[argument.Operand]); id != -1 && (call->FastFunction == nullptr || fast_function != -1)) {
+						argument = Instruction{ OPCODE::PUSH_INT, 0, 0, 0, id };
+						if (fast_function == -1) {
+							removed[i] = true;
+						}
+						else {
+							instruction.Operand = fast_function;
+						}
+						resolved++;
+					}
+				}
+			}
+			if (FunctionsSignature[instruction.Operand].Return != ArtCode::variable_type::NUL) {
+				stack.push_back({ start, false });
+			}
+		}break;
+		default:
+			// set and if use every value of statement
+			stack.clear();
+			break;
+		}
+	}
+	if (resolved > 0) {
+		program.Remove(removed);
+		program.Thread(OpHandlers);
+	}
+	return resolved;
 }
 
+const Program* CodeExecutor::GetProgram(const unsigned char* code, const Sint64 size, const std::string& name, const InstanceDefinition& definition)
+{
+	if (const Program* program = FindProgram(code); program != nullptr) {
+		return program;
+	}
+	Program program;
+	if (!h_decode_program(program, code, size, name)) {
+		Console::WriteLine("CodeExecutor::GetProgram() - can not decode '" + name + "'");
+		return nullptr;
+	}
+	if (!h_verify_program(program, definition)) {
+		Console::WriteLine("CodeExecutor::GetProgram() - '" + name + "' rejected by verifier");
+		return nullptr;
+	}
+	h_resolve_program(program);
+	h_fuse_program(program);
+	return &(_code_programs[code] = std::move(program));
+}
 
-void CodeExecutor::Break()
+void CodeExecutor::ClearScenePrograms()
 {
-	Core::Executor()->_current_inspector->Break = true;
+	// suspended frames can point to program, they are stopped with scene
+	SDL_assert(_suspended_timers.empty());
+	_code_programs.clear();
+}
+
+const Program* CodeExecutor::FindProgram(const unsigned char* code) const
+{
+	if (const auto it = _code_programs.find(code); it != _code_programs.end()) {
+		return &it->second;
+	}
+	return nullptr;
+}
+
+
+
+std::vector<std::string> CodeExecutor::GetFunctionsNames() const
+{
+	std::vector<std::string> functions_names(FunctionsList.size());
+	for (size_t i = 0; i < FunctionsList.size(); i++) {
+		for (const auto& [name, function] : FunctionsMap) {
+			if (FunctionsList[i] != nullptr && function == FunctionsList[i]) {
+				functions_names[i] = name;
+				break;
+			}
+		}
+	}
+	return functions_names;
 }
 
 void CodeExecutor::SuspendedCodeStop()
 {
-	_suspended_code.clear();
-	_have_suspended_code = false;
+	_suspended_frames.clear();
+	_suspended_frames_free = -1;
+	_suspended_timers.clear();
+	_suspended_sequence = 0;
+	_suspended_clock = 0.0;
+}
+
+bool CodeExecutor::h_suspended_timer_later(const SuspendedTimer& a, const SuspendedTimer& b)
+{
+	if (a.WakeTime != b.WakeTime) return a.WakeTime > b.WakeTime;
+	return a.Sequence > b.Sequence;
 }
 
-void CodeExecutor::SuspendedCodeAdd(const double time, Instance* sender)
+void CodeExecutor::h_suspended_frame_free(const int slot)
 {
-	if (sender->SuspendedCodeAdd()) {
-		_suspended_code.emplace_back(time, Core::Executor()->_current_inspector, sender, Core::Executor()->_if_test_result);
+	SuspendedFrame& frame = _suspended_frames[slot];
+	// unlink from sender list
+	if (frame.Prev != -1) {
+		_suspended_frames[frame.Prev].Next = frame.Next;
 	}
+	else {
+		frame.Sender->SuspendedCodeSetFirst(frame.Next);
+	}
+	if (frame.Next != -1) {
+		_suspended_frames[frame.Next].Prev = frame.Prev;
+	}
+	frame.Sender = nullptr;
+	frame.Generation++;
+	frame.Prev = -1;
+	frame.Next = _suspended_frames_free;
+	_suspended_frames_free = slot;
 }
 
-void CodeExecutor::SuspendedCodeExecute()
+void CodeExecutor::SuspendedCodeAdd(ExecutionContext* context, const double time, Instance* sender)
 {
-	if (!_have_suspended_code) return;
+	if (!sender->SuspendedCodeAdd()) return;
+
+	// script is stopped after code_wait, so if test results can be taken from context
+	Uint64 if_test_state = 0;
+	int if_test_count = 0;
+	while (!context->IfTestResult.IsEmpty()) {
+		if (if_test_count == 64) {
+			Console::WriteLine("code_wait: too many nested if, only 64 are restored");
+			context->IfTestResult.Erase();
+			break;
+		}
+		if (context->IfTestResult.Get()) if_test_state |= Uint64(1) << if_test_count;
+		if_test_count++;
+	}
+	h_suspended_frame_add(sender, *context->Frame, if_test_state, if_test_count, time);
+}
+
+void CodeExecutor::h_suspended_frame_add(Instance* sender, const ProgramFrame& code, const Uint64 if_test_state, const int if_test_count, const double time)
+{
+	SDL_AtomicLock(&_suspended_code_lock);
+	int slot = _suspended_frames_free;
+	if (slot != -1) {
+		_suspended_frames_free = _suspended_frames[slot].Next;
+	}
+	else {
+		slot = static_cast<int>(_suspended_frames.size());
+		_suspended_frames.emplace_back();
+	}
+	SuspendedFrame& frame = _suspended_frames[slot];
+	frame.CodeData = code;
+	frame.Sender = sender;
+	frame.IfTestState = if_test_state;
+	frame.IfTestCount = if_test_count;
+	// link as first frame of sender
+	frame.Prev = -1;
+	frame.Next = sender->SuspendedCodeFirst();
+	if (frame.Next != -1) {
+		_suspended_frames[frame.Next].Prev = slot;
+	}
+	sender->SuspendedCodeSetFirst(slot);
 
-	for (auto it = _suspended_code.begin(); it != _suspended_code.end(); )
+	_suspended_timers.push_back({ _suspended_clock + time, _suspended_sequence++, slot, frame.Generation });
+	std::ranges::push_heap(_suspended_timers, h_suspended_timer_later);
+	SDL_AtomicUnlock(&_suspended_code_lock);
+}
+
+void CodeExecutor::SuspendedCodeExecute()
+{
+	_suspended_clock += 1000.0 * Core::DeltaTime;
+	// code suspended again while executing wait to next frame
+	const Uint64 last_sequence = _suspended_sequence;
+	while (!_suspended_timers.empty())
 	{
-		(*it).Time -= 1000.0 * Core::DeltaTime;
-		if ((*it).Time <= 0.0)
-		{
-			if ((*it).Sender->SuspendedCodePop()) {
-				// restore script break data
-				(*it).CodeData.Break = false;
-				// flip ifs status, to continue execute
-				Core::Executor()->_if_test_result = (*it).IfTestState;
-				Core::Executor()->h_execute_script(&(*it).CodeData, (*it).Sender);
-			}
-			it = _suspended_code.erase(it);
-		}
-		else {
-			++it;
+		const SuspendedTimer timer = _suspended_timers.front();
+		if (timer.WakeTime > _suspended_clock || timer.Sequence >= last_sequence) break;
+		std::ranges::pop_heap(_suspended_timers, h_suspended_timer_later);
+		_suspended_timers.pop_back();
+
+		// cancelled frame, slot is free or used by other code
+		if (_suspended_frames[timer.Slot].Generation != timer.Generation) continue;
+
+		// copy, script can suspend again and pool can grow
+		const SuspendedFrame frame = _suspended_frames[timer.Slot];
+		h_suspended_frame_free(timer.Slot);
+		if (!frame.Sender->SuspendedCodePop()) continue;
+
+		ProgramFrame code = frame.CodeData;
+		// restore script break data
+		code.Break = false;
+		// restore if tests, deepest first
+		ExecutionContext* context = Core::Executor()->GetMainContext();
+		context->IfTestResult.Erase();
+		for (int i = frame.IfTestCount - 1; i >= 0; i--) {
+			context->IfTestResult.Add((frame.IfTestState >> i & 1) != 0);
 		}
+		const OperandStack::Mark stack_mark = context->Stack.GetMark();
+		Core::Executor()->h_execute_script(context, &code, frame.Sender);
+		context->Stack.Truncate(stack_mark);
 	}
 }
 
 void CodeExecutor::SuspendedCodeDeleteInstance(const Instance* sender)
 {
-	if (!_have_suspended_code) return;
-	for (auto it = _suspended_code.begin(); it != _suspended_code.end(); )
+	// only frames of this instance are visited, timers are dropped when they expire
+	while (sender->SuspendedCodeFirst() != -1)
 	{
-		if((*it).Sender->GetId() == sender->GetId())
-		{
-			it = _suspended_code.erase(it);
-			// no return, one instance can have many suspended code
-		}
-		else {
-			++it;
-		}
+		h_suspended_frame_free(sender->SuspendedCodeFirst());
 	}
 }
 
-void CodeExecutor::h_operation_global(Instance* instance, const int operation, const ArtCode::variable_type type, const int index)
+void CodeExecutor::h_operation_global(ExecutionContext* context, Instance* instance, const int operation, const ArtCode::variable_type type, const int index)
 {
 	switch (type) {
-	case ArtCode::variable_type::INT:		instance->Variables_int[index] = h_operation_int(operation, instance->Variables_int[index], GlobalStack_int.Get()); break;
-	case ArtCode::variable_type::FLOAT:		instance->Variables_float[index] = h_operation_float(operation, instance->Variables_float[index], GlobalStack_float.Get()); break;
-	case ArtCode::variable_type::BOOL:		instance->Variables_bool[index] = h_operation_bool(operation, instance->Variables_bool[index], GlobalStack_bool.Get()); break;
-	case ArtCode::variable_type::INSTANCE:	instance->Variables_instance[index] = h_operation_instance(operation, instance->Variables_instance[index], GlobalStack_instance.Get()); break;
-	case ArtCode::variable_type::OBJECT:	instance->Variables_object[index] = h_operation_object(operation, instance->Variables_object[index], GlobalStack_int.Get()); break;
-	case ArtCode::variable_type::SPRITE:	instance->Variables_sprite[index] = h_operation_sprite(operation, instance->Variables_sprite[index], GlobalStack_int.Get()); break;
-	case ArtCode::variable_type::TEXTURE:	instance->Variables_texture[index] = h_operation_texture(operation, instance->Variables_texture[index], GlobalStack_int.Get()); break;
-	case ArtCode::variable_type::SOUND:		instance->Variables_sound[index] = h_operation_sound(operation, instance->Variables_sound[index], GlobalStack_int.Get()); break;
-	case ArtCode::variable_type::MUSIC:		instance->Variables_music[index] = h_operation_music(operation, instance->Variables_music[index], GlobalStack_int.Get()); break;
-	case ArtCode::variable_type::FONT:		instance->Variables_font[index] = h_operation_font(operation, instance->Variables_font[index], GlobalStack_int.Get()); break;
-	case ArtCode::variable_type::POINT:		instance->Variables_point[index] = h_operation_point(operation, instance->Variables_point[index], GlobalStack_point.Get()); break;
-	case ArtCode::variable_type::RECT:		instance->Variables_rect[index] = h_operation_rect(operation, instance->Variables_rect[index], GlobalStack_rect.Get()); break;
-	case ArtCode::variable_type::COLOR:		instance->Variables_color[index] = h_operation_color(operation, instance->Variables_color[index], GlobalStack_color.Get()); break;
-	case ArtCode::variable_type::STRING:	instance->Variables_string[index] = h_operation_string(operation, instance->Variables_string[index], GlobalStack_string.Get()); break;
+	case ArtCode::variable_type::INT:		instance->Variables.Get<ArtCode::INT>(index) = h_operation_int(operation, instance->Variables.Get<ArtCode::INT>(index), context->Stack.PopInt()); break;
+	case ArtCode::variable_type::FLOAT:		instance->Variables.Get<ArtCode::FLOAT>(index) = h_operation_float(operation, instance->Variables.Get<ArtCode::FLOAT>(index), context->Stack.PopFloat()); break;
+	case ArtCode::variable_type::BOOL:		instance->Variables.Get<ArtCode::BOOL>(index) = h_operation_bool(operation, instance->Variables.Get<ArtCode::BOOL>(index), context->Stack.PopBool()); break;
+	case ArtCode::variable_type::INSTANCE:	instance->Variables.Get<ArtCode::INSTANCE>(index) = h_handle(h_operation_instance(operation, h_instance(instance->Variables.Get<ArtCode::INSTANCE>(index)), context->Stack.PopInstance())); break;
+	case ArtCode::variable_type::OBJECT:	instance->Variables.Get<ArtCode::OBJECT>(index) = h_operation_object(operation, instance->Variables.Get<ArtCode::OBJECT>(index), context->Stack.PopInt()); break;
+	case ArtCode::variable_type::SPRITE:	instance->Variables.Get<ArtCode::SPRITE>(index) = h_operation_sprite(operation, instance->Variables.Get<ArtCode::SPRITE>(index), context->Stack.PopInt()); break;
+	case ArtCode::variable_type::TEXTURE:	instance->Variables.Get<ArtCode::TEXTURE>(index) = h_operation_texture(operation, instance->Variables.Get<ArtCode::TEXTURE>(index), context->Stack.PopInt()); break;
+	case ArtCode::variable_type::SOUND:		instance->Variables.Get<ArtCode::SOUND>(index) = h_operation_sound(operation, instance->Variables.Get<ArtCode::SOUND>(index), context->Stack.PopInt()); break;
+	case ArtCode::variable_type::MUSIC:		instance->Variables.Get<ArtCode::MUSIC>(index) = h_operation_music(operation, instance->Variables.Get<ArtCode::MUSIC>(index), context->Stack.PopInt()); break;
+	case ArtCode::variable_type::FONT:		instance->Variables.Get<ArtCode::FONT>(index) = h_operation_font(operation, instance->Variables.Get<ArtCode::FONT>(index), context->Stack.PopInt()); break;
+	case ArtCode::variable_type::POINT:		instance->Variables.Get<ArtCode::POINT>(index) = h_operation_point(operation, instance->Variables.Get<ArtCode::POINT>(index), context->Stack.PopPoint()); break;
+	case ArtCode::variable_type::RECT:		instance->Variables.Get<ArtCode::RECT>(index) = h_operation_rect(operation, instance->Variables.Get<ArtCode::RECT>(index), context->Stack.PopRect()); break;
+	case ArtCode::variable_type::COLOR:		instance->Variables.Get<ArtCode::COLOR>(index) = h_operation_color(operation, instance->Variables.Get<ArtCode::COLOR>(index), context->Stack.PopColor()); break;
+	case ArtCode::variable_type::STRING:	instance->Variables.Get<ArtCode::STRING>(index) = h_operation_string(operation, instance->Variables.Get<ArtCode::STRING>(index), context->Stack.PopString()); break;
 	}
 }
 
-void CodeExecutor::h_execute_script(Inspector* code, Instance* instance)
+void CodeExecutor::h_operation_local(Instance* instance, const int operation, const ArtCode::variable_type type, const int index, const int source)
+{
+	switch (type) {
+	case ArtCode::variable_type::INT:		instance->Variables.Get<ArtCode::INT>(index) = h_operation_int(operation, instance->Variables.Get<ArtCode::INT>(index), instance->Variables.Get<ArtCode::INT>(source)); break;
+	case ArtCode::variable_type::FLOAT:		instance->Variables.Get<ArtCode::FLOAT>(index) = h_operation_float(operation, instance->Variables.Get<ArtCode::FLOAT>(index), instance->Variables.Get<ArtCode::FLOAT>(source)); break;
+	case ArtCode::variable_type::BOOL:		instance->Variables.Get<ArtCode::BOOL>(index) = h_operation_bool(operation, instance->Variables.Get<ArtCode::BOOL>(index), instance->Variables.Get<ArtCode::BOOL>(source)); break;
+	case ArtCode::variable_type::INSTANCE:	instance->Variables.Get<ArtCode::INSTANCE>(index) = h_handle(h_operation_instance(operation, h_instance(instance->Variables.Get<ArtCode::INSTANCE>(index)), h_instance(instance->Variables.Get<ArtCode::INSTANCE>(source)))); break;
+	case ArtCode::variable_type::OBJECT:	instance->Variables.Get<ArtCode::OBJECT>(index) = h_operation_object(operation, instance->Variables.Get<ArtCode::OBJECT>(index), instance->Variables.Get<ArtCode::OBJECT>(source)); break;
+	case ArtCode::variable_type::SPRITE:	instance->Variables.Get<ArtCode::SPRITE>(index) = h_operation_sprite(operation, instance->Variables.Get<ArtCode::SPRITE>(index), instance->Variables.Get<ArtCode::SPRITE>(source)); break;
+	case ArtCode::variable_type::TEXTURE:	instance->Variables.Get<ArtCode::TEXTURE>(index) = h_operation_texture(operation, instance->Variables.Get<ArtCode::TEXTURE>(index), instance->Variables.Get<ArtCode::TEXTURE>(source)); break;
+	case ArtCode::variable_type::SOUND:		instance->Variables.Get<ArtCode::SOUND>(index) = h_operation_sound(operation, instance->Variables.Get<ArtCode::SOUND>(index), instance->Variables.Get<ArtCode::SOUND>(source)); break;
+	case ArtCode::variable_type::MUSIC:		instance->Variables.Get<ArtCode::MUSIC>(index) = h_operation_music(operation, instance->Variables.Get<ArtCode::MUSIC>(index), instance->Variables.Get<ArtCode::MUSIC>(source)); break;
+	case ArtCode::variable_type::FONT:		instance->Variables.Get<ArtCode::FONT>(index) = h_operation_font(operation, instance->Variables.Get<ArtCode::FONT>(index), instance->Variables.Get<ArtCode::FONT>(source)); break;
+	case ArtCode::variable_type::POINT:		instance->Variables.Get<ArtCode::POINT>(index) = h_operation_point(operation, instance->Variables.Get<ArtCode::POINT>(index), instance->Variables.Get<ArtCode::POINT>(source)); break;
+	case ArtCode::variable_type::RECT:		instance->Variables.Get<ArtCode::RECT>(index) = h_operation_rect(operation, instance->Variables.Get<ArtCode::RECT>(index), instance->Variables.Get<ArtCode::RECT>(source)); break;
+	case ArtCode::variable_type::COLOR:		instance->Variables.Get<ArtCode::COLOR>(index) = h_operation_color(operation, instance->Variables.Get<ArtCode::COLOR>(index), instance->Variables.Get<ArtCode::COLOR>(source)); break;
+	case ArtCode::variable_type::STRING:	instance->Variables.Get<ArtCode::STRING>(index) = h_operation_string(operation, instance->Variables.Get<ArtCode::STRING>(index), instance->Variables.Get<ArtCode::STRING>(source)); break;
+	}
+}
+
+void CodeExecutor::h_execute_script(ExecutionContext* context, ProgramFrame* code, Instance* instance)
 {
 	/*
 	*						WriteCommand(Command::OTHER);
 							WriteBit(ref->CodeId);
 							WriteValue(var->Type, var->index);
 	* */
-	_current_inspector = code;
+	context->Frame = code;
 	if (code->Break) return;
-	while (!code->IsEnd()) {
-		if (code->Break) return;
-		switch (code->GetNextCommand()) {
-		case COMMAND::SET: {
-			const int operation = (int)code->GetBit();
-			// variable - type,index
-			// variable to set
-			const ArtCode::variable_type type = static_cast<ArtCode::variable_type>(code->GetBit());
-			ASSERT(type != ArtCode::variable_type::variable_typeInvalid, "[command::SET] type = variable_type::Invalid")
-			const int index = (int)code->GetBit();
-
-			h_get_value(code, instance);
-			h_operation_global(instance, operation, type, index);
-		}break;
-
-		case COMMAND::OTHER: {
-			const int instance_type = (int)code->GetBit();
-			Instance* other = Core::GetCurrentScene()->CurrentCollisionInstance;
-			if (other == nullptr) {
-				Break();
-				return;
-				// error - other is null
-			}
-			if (instance_type != other->GetInstanceDefinitionId()) {
-				Break();
-				// error - wrong type
-			}
-			const ArtCode::variable_type type = static_cast<ArtCode::variable_type>(code->GetBit());
-			ASSERT(type != ArtCode::variable_type::variable_typeInvalid, "command::SET")
-			const int index = (int)code->GetBit();
-			// operator 
-			const int operation = (int)code->GetBit();
-			
-			h_get_value(code, instance);
-			h_operation_global(other, operation, type, index);
-		} break;
-
-		case COMMAND::FUNCTION: {
-			h_execute_function(code, instance);
-		} break;
-
-		case COMMAND::IF_TEST: {
-			code->Skip(h_if_test(code, instance));
-		} break;
-		case COMMAND::ELSE:
-			const unsigned char skip_2_bit[2]
-			{
-				code->GetBit(), code->GetBit()
-			};
-			unsigned int skip;
-			Convert::TwoByteCharToUint32(skip_2_bit, &skip);
-			if (_if_test_result.Get() == true)
-			{
-				// skip else
-				code->Skip(static_cast<int>(skip));
-			}
-			break;
+	const Instruction* instructions = code->Code->GetCode();
+	if (ScriptProfiler::Enabled || OpcodeCounter::Enabled) {
+		// the same loop that count instructions, normal loops stay untouched
+		for (;;) {
+			const int position = code->Position++;
+			if (ScriptProfiler::Enabled) context->Profile.CountInstruction();
+			if (OpcodeCounter::Enabled) context->Counter.Count(code->Code, position);
+			if (!OpHandlers[static_cast<int>(instructions[position].Op)](this, context, code, instance, instructions[position])) return;
+		}
+	}
+#if ART_CODE_THREADED_DISPATCH
+	// only handlers that can break script check break flag
+	const Program::OpHandler* handlers = code->Code->GetHandlers();
+	for (;;) {
+		const int position = code->Position++;
+		if (!handlers[position](this, context, code, instance, instructions[position])) return;
+	}
+#else
+	for (;;) {
+		const Instruction& instruction = instructions[code->Position++];
+		switch (instruction.Op) {
+#define X(name) case OPCODE::name: if (!op_##name(this, context, code, instance, instruction)) return; break;
+			ART_CODE_OPCODES(X)
+#undef X
+		case OPCODE::INVALID: return;
 		}
 	}
+#endif
 }
 
-int CodeExecutor::h_if_test(Inspector* code, Instance* instance) {
-	if (code->Break) return 0;
-	bool have_operator = false;
-	int operator_index = -1;
-	// get value to compare
-	while (!code->IsEnd()) {
-		if (code->Break) return 0;
-		switch (code->GetNextCommand()) {
-		case COMMAND::LOCAL_VARIABLE:
-		{
-			h_get_local_value(code, instance);
-		}break;
+const Program::OpHandler CodeExecutor::OpHandlers[static_cast<int>(Instruction::Opcode::INVALID)] = {
+#define X(name) &CodeExecutor::op_##name,
+	ART_CODE_OPCODES(X)
+#undef X
+};
 
-		case COMMAND::OTHER: {
-			const int instance_type = (int)code->GetBit();
-			const Instance* other = Core::GetCurrentScene()->CurrentCollisionInstance;
-			if (other == nullptr) {
-				Break();
-				return -1;
-				// error - other is null
-			}
-			if (instance_type != other->GetInstanceDefinitionId()) {
-				Break();
-				// error - wrong type
-			}
-			h_get_local_value(code, Core::GetCurrentScene()->CurrentCollisionInstance);
-		} break;
+bool CodeExecutor::op_PUSH_INT(CodeExecutor*, ExecutionContext* context, ProgramFrame*, Instance*, const Instruction& instruction)
+{
+	context->Stack.PushInt(instruction.Operand);
+	return true;
+}
 
-		case COMMAND::FUNCTION:
-		{
-			h_execute_function(code, instance);
-			// add on stack return value
-		}break;
+bool CodeExecutor::op_PUSH_FLOAT(CodeExecutor*, ExecutionContext* context, ProgramFrame* code, Instance*, const Instruction& instruction)
+{
+	context->Stack.PushFloat(code->Code->LiteralFloat[instruction.Operand]);
+	return true;
+}
 
-		case COMMAND::VALUE:
-		{
-			if (have_operator) {
-				// in this cace return to previous command
-				code->Skip(-1);
-				h_get_value(code, instance);
-			}
-			else {
-				Break();
-			}
-		}break;
+bool CodeExecutor::op_PUSH_BOOL(CodeExecutor*, ExecutionContext* context, ProgramFrame*, Instance*, const Instruction& instruction)
+{
+	context->Stack.PushBool(instruction.Operand != 0);
+	return true;
+}
 
-		case COMMAND::OPERATOR:
-		{
-			const int index = (int)code->GetBit();
-			if (index > 7) {
-				Break();
-			}
-			operator_index = index;
-			have_operator = true;
-		}break;
+bool CodeExecutor::op_PUSH_INSTANCE(CodeExecutor*, ExecutionContext* context, ProgramFrame*, Instance*, const Instruction& instruction)
+{
+	context->Stack.PushInstance(Core::GetCurrentScene()->GetInstanceById(instruction.Operand));
+	return true;
+}
 
-		case COMMAND::IF_BODY: {
-			const int type = (int)code->GetBit();
-			const unsigned char skip_2_bit[2]
-			{
-				code->GetBit(), code->GetBit()
-			};
-			unsigned int skip;
-			Convert::TwoByteCharToUint32(skip_2_bit, &skip);
-			if (have_operator) {
-				//GlobalStack_int.Add(operator_index);
-				if (h_compare(type, operator_index)) {
-					_if_test_result.Add(true);
-					return 0;
-				}
-				else {
-					_if_test_result.Add(false);
-					return static_cast<int>(skip);
-				}
-			}
-			else {
-				if (const bool test = GlobalStack_bool.Get()) {
-					_if_test_result.Add(true);
-					return 0;
-				}
-				else {
-					_if_test_result.Add(false);
-					return static_cast<int>(skip);
-				}
-			}
-		}break;
+bool CodeExecutor::op_PUSH_POINT(CodeExecutor*, ExecutionContext* context, ProgramFrame* code, Instance*, const Instruction& instruction)
+{
+	context->Stack.PushPoint(code->Code->LiteralPoint[instruction.Operand]);
+	return true;
+}
+
+bool CodeExecutor::op_PUSH_RECT(CodeExecutor*, ExecutionContext* context, ProgramFrame* code, Instance*, const Instruction& instruction)
+{
+	context->Stack.PushRect(code->Code->LiteralRect[instruction.Operand]);
+	return true;
+}
+
+bool CodeExecutor::op_PUSH_COLOR(CodeExecutor*, ExecutionContext* context, ProgramFrame* code, Instance*, const Instruction& instruction)
+{
+	context->Stack.PushColor(code->Code->LiteralColor[instruction.Operand]);
+	return true;
+}
+
+bool CodeExecutor::op_PUSH_STRING(CodeExecutor*, ExecutionContext* context, ProgramFrame* code, Instance*, const Instruction& instruction)
+{
+	context->Stack.PushString(code->Code->LiteralString[instruction.Operand], code->Code->LiteralStringId[instruction.Operand]);
+	return true;
+}
+
+bool CodeExecutor::op_PUSH_LOCAL(CodeExecutor*, ExecutionContext* context, ProgramFrame*, Instance* instance, const Instruction& instruction)
+{
+	h_get_local_value(context, static_cast<ArtCode::variable_type>(instruction.A), instruction.B, instance);
+	return true;
+}
+
+bool CodeExecutor::op_PUSH_OTHER(CodeExecutor*, ExecutionContext* context, ProgramFrame* code, Instance*, const Instruction& instruction)
+{
+	Instance* other = Core::GetCurrentScene()->CurrentCollisionInstance;
+	if (other == nullptr || instruction.A != other->GetInstanceDefinitionId()) {
+		// error - other is null or wrong type
+		code->Break = true;
+		return false;
+	}
+	h_get_local_value(context, static_cast<ArtCode::variable_type>(instruction.B), instruction.C, other);
+	return true;
+}
+
+bool CodeExecutor::op_CALL(CodeExecutor* executor, ExecutionContext* context, ProgramFrame* code, Instance* instance, const Instruction& instruction)
+{
+	executor->h_execute_function(context, code, instruction.Operand, instance);
+	// function can break script
+	return !code->Break;
+}
 
+bool CodeExecutor::op_SET(CodeExecutor*, ExecutionContext* context, ProgramFrame*, Instance* instance, const Instruction& instruction)
+{
+	const ArtCode::variable_type type = static_cast<ArtCode::variable_type>(instruction.B);
+#if !ART_CODE_UNCHECKED
+	ASSERT(type != ArtCode::variable_type::variable_typeInvalid, "[command::SET] type = variable_type::Invalid")
+#endif
+	h_operation_global(context, instance, instruction.A, type, instruction.C);
+	return true;
+}
+
+bool CodeExecutor::op_SET_OTHER(CodeExecutor*, ExecutionContext* context, ProgramFrame* code, Instance*, const Instruction& instruction)
+{
+	Instance* other = Core::GetCurrentScene()->CurrentCollisionInstance;
+	if (other == nullptr || instruction.A != other->GetInstanceDefinitionId()) {
+		// error - other is null or wrong type
+		code->Break = true;
+		return false;
+	}
+	const ArtCode::variable_type type = static_cast<ArtCode::variable_type>(instruction.B);
+#if !ART_CODE_UNCHECKED
+	ASSERT(type != ArtCode::variable_type::variable_typeInvalid, "command::SET")
+#endif
+	h_operation_global(context, other, instruction.Operand, type, instruction.C);
+	return true;
+}
+
+bool CodeExecutor::op_IF(CodeExecutor*, ExecutionContext* context, ProgramFrame* code, Instance*, const Instruction& instruction)
+{
+	bool test;
+	if (instruction.B != Instruction::NO_OPERATOR) {
+		test = h_compare(context, instruction.A, instruction.B);
+	}
+	else {
+		test = context->Stack.PopBool();
+	}
+	context->IfTestResult.Add(test);
+	if (!test) {
+		code->Position = instruction.Operand;
+	}
+#if ART_CODE_UNCHECKED
+	// operator is verified
+	return true;
+#else
+	// wrong operator break script
+	return !code->Break;
+#endif
+}
+
+bool CodeExecutor::op_ELSE(CodeExecutor*, ExecutionContext* context, ProgramFrame* code, Instance*, const Instruction& instruction)
+{
+	if (context->IfTestResult.Get() == true)
+	{
+		// skip else
+		code->Position = instruction.Operand;
+	}
+	return true;
+}
+
+bool CodeExecutor::op_BREAK(CodeExecutor*, ExecutionContext*, ProgramFrame* code, Instance*, const Instruction&)
+{
+	code->Break = true;
+	return false;
+}
+
+bool CodeExecutor::op_END(CodeExecutor*, ExecutionContext*, ProgramFrame* code, Instance*, const Instruction&)
+{
+	// stay on end, suspended code can not continue after it
+	code->Position--;
+	return false;
+}
+
+bool CodeExecutor::op_SET_LOCAL(CodeExecutor*, ExecutionContext*, ProgramFrame*, Instance* instance, const Instruction& instruction)
+{
+	h_operation_local(instance, instruction.A, static_cast<ArtCode::variable_type>(instruction.B), instruction.C, instruction.Operand);
+	return true;
+}
+
+bool CodeExecutor::op_CALL_SET(CodeExecutor* executor, ExecutionContext* context, ProgramFrame* code, Instance* instance, const Instruction& instruction)
+{
+	executor->h_execute_function(context, code, instruction.Operand, instance);
+	// function can break script
+	if (code->Break) return false;
+	h_operation_global(context, instance, instruction.A, static_cast<ArtCode::variable_type>(instruction.B), instruction.C);
+	return true;
+}
+
+namespace
+{
+	// same result as h_compare, but without stack
+	template <typename T>
+	bool CompareValue(const int operation, const T left, const T right)
+	{
+		switch (operation) {
+		case 2: return left < right;	//	"<<",
+		case 3: return left > right;	//	">>",
+		case 4: return left >= right;	//	">=",
+		case 5: return left <= right;	//	"<=",
+		case 6: return left != right;	//	"!=",
+		case 7: return left == right;	//	"=="
 		}
+		return false;
 	}
-	// error
-	Break();
-	return 0;
 }
+
+bool CodeExecutor::op_IF_LOCAL(CodeExecutor*, ExecutionContext* context, ProgramFrame* code, Instance* instance, const Instruction& instruction)
+{
+	const bool test = instruction.B == ArtCode::variable_type::INT
+		? CompareValue(instruction.A, instance->Variables.Get<ArtCode::INT>(instruction.C), instruction.Operand)
+		: CompareValue(instruction.A, instance->Variables.Get<ArtCode::FLOAT>(instruction.C), code->Code->LiteralFloat[instruction.Operand]);
+	context->IfTestResult.Add(test);
+	// next instruction is if, it have only jump target
+	if (test) {
+		code->Position++;
+	}
+	else {
+		code->Position = (&instruction)[1].Operand;
+	}
+	return true;
+}
+
 /*
 case 0: // "+=",
 case 1: //" -=",
@@ -1066,306 +1523,265 @@ std::string CodeExecutor::h_operation_string(const int _operator, std::string va
 	return val2;
 }
 
-bool CodeExecutor::h_compare(const int type, const int operation)
+bool CodeExecutor::h_compare(ExecutionContext* context, const int type, const int operation)
 {
 	//	0		1		2		3		4		5		6		7
 	//	"||",	"&&",	"<<",	">>",	">=",	"<=",	"!=",	"=="
-	//int operation = GlobalStack_int.Get();
+	//int operation = context->Stack.PopInt();
 
 	switch (operation) {
 	case 0://	"||",
 	{
 		switch (type) {
-		//case ArtCode::variable_type::INT:		return (GlobalStack_int.Get() || GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::FLOAT:		return (GlobalStack_float.Get() || GlobalStack_float.Get());  break;
-		case ArtCode::variable_type::BOOL:		return (GlobalStack_bool.Get() || GlobalStack_bool.Get());  break;
-		//case ArtCode::variable_type::INSTANCE:	return (GlobalStack_instance.Get() || GlobalStack_instance.Get());  break;
-		//case ArtCode::variable_type::OBJECT:		return (GlobalStack_int.Get() || GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::Sprite:		return (GlobalStack_int.Get() || GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::TEXTURE:	return (GlobalStack_int.Get() || GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::SOUND:		return (GlobalStack_int.Get() || GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::MUSIC:		return (GlobalStack_int.Get() || GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::FONT:		return (GlobalStack_int.Get() || GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::POINT:		return (GlobalStack_point.Get() || GlobalStack_point.Get());  break;
-		//case ArtCode::variable_type::Rect:		return (GlobalStack_rect.Get() || GlobalStack_rect.Get());  break;
-		//case ArtCode::variable_type::COLOR:		return (GlobalStack_color.Get() || GlobalStack_color.Get());  break;
-		//case ArtCode::variable_type::STRING:		return (GlobalStack_string.Get() || GlobalStack_string.Get());  break;
+		//case ArtCode::variable_type::INT:		return (context->Stack.PopInt() || context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::FLOAT:		return (context->Stack.PopFloat() || context->Stack.PopFloat());  break;
+		case ArtCode::variable_type::BOOL:		return (context->Stack.PopBool() || context->Stack.PopBool());  break;
+		//case ArtCode::variable_type::INSTANCE:	return (context->Stack.PopInstance() || context->Stack.PopInstance());  break;
+		//case ArtCode::variable_type::OBJECT:		return (context->Stack.PopInt() || context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::Sprite:		return (context->Stack.PopInt() || context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::TEXTURE:	return (context->Stack.PopInt() || context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::SOUND:		return (context->Stack.PopInt() || context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::MUSIC:		return (context->Stack.PopInt() || context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::FONT:		return (context->Stack.PopInt() || context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::POINT:		return (context->Stack.PopPoint() || context->Stack.PopPoint());  break;
+		//case ArtCode::variable_type::Rect:		return (context->Stack.PopRect() || context->Stack.PopRect());  break;
+		//case ArtCode::variable_type::COLOR:		return (context->Stack.PopColor() || context->Stack.PopColor());  break;
+		//case ArtCode::variable_type::STRING:		return (context->Stack.PopString() || context->Stack.PopString());  break;
 		default: return false; break; // wrong operator
 		}
 	}
 		break;
 	case 1://	"&&",
 	{
-		//bool com2 = Convert::Str2Bool(GlobalStack.Get());
-		//bool com1 = Convert::Str2Bool(GlobalStack.Get());
+		//bool com2 = Convert::Str2Bool(context->Stack.Get());
+		//bool com1 = Convert::Str2Bool(context->Stack.Get());
 		//return (com2 && com1);
 		switch (type) {
-		//case ArtCode::variable_type::INT:		return (GlobalStack_int.Get() && GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::FLOAT:		return (GlobalStack_float.Get() && GlobalStack_float.Get());  break;
-		case ArtCode::variable_type::BOOL:		return (GlobalStack_bool.Get() && GlobalStack_bool.Get());  break;
-		//case ArtCode::variable_type::INSTANCE:	return (GlobalStack_instance.Get() && GlobalStack_instance.Get());  break;
-		//case ArtCode::variable_type::OBJECT:		return (GlobalStack_int.Get() && GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::Sprite:		return (GlobalStack_int.Get() && GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::TEXTURE:	return (GlobalStack_int.Get() && GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::SOUND:		return (GlobalStack_int.Get() && GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::MUSIC:		return (GlobalStack_int.Get() && GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::FONT:		return (GlobalStack_int.Get() && GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::POINT:		return (GlobalStack_point.Get() && GlobalStack_point.Get());  break;
-		//case ArtCode::variable_type::Rect:		return (GlobalStack_rect.Get() && GlobalStack_rect.Get());  break;
-		//case ArtCode::variable_type::COLOR:		return (GlobalStack_color.Get() && GlobalStack_color.Get());  break;
-		//case ArtCode::variable_type::STRING:		return (GlobalStack_string.Get() && GlobalStack_string.Get());  break;
+		//case ArtCode::variable_type::INT:		return (context->Stack.PopInt() && context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::FLOAT:		return (context->Stack.PopFloat() && context->Stack.PopFloat());  break;
+		case ArtCode::variable_type::BOOL:		return (context->Stack.PopBool() && context->Stack.PopBool());  break;
+		//case ArtCode::variable_type::INSTANCE:	return (context->Stack.PopInstance() && context->Stack.PopInstance());  break;
+		//case ArtCode::variable_type::OBJECT:		return (context->Stack.PopInt() && context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::Sprite:		return (context->Stack.PopInt() && context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::TEXTURE:	return (context->Stack.PopInt() && context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::SOUND:		return (context->Stack.PopInt() && context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::MUSIC:		return (context->Stack.PopInt() && context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::FONT:		return (context->Stack.PopInt() && context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::POINT:		return (context->Stack.PopPoint() && context->Stack.PopPoint());  break;
+		//case ArtCode::variable_type::Rect:		return (context->Stack.PopRect() && context->Stack.PopRect());  break;
+		//case ArtCode::variable_type::COLOR:		return (context->Stack.PopColor() && context->Stack.PopColor());  break;
+		//case ArtCode::variable_type::STRING:		return (context->Stack.PopString() && context->Stack.PopString());  break;
 		default: return false; break; // wrong operator
 		}
 	}
 		break;
 	case 2://	"<<",
 	{
-		//float com2 = Func::TryGetFloat(GlobalStack.Get());
-		//float com1 = Func::TryGetFloat(GlobalStack.Get());
+		//float com2 = Func::TryGetFloat(context->Stack.Get());
+		//float com1 = Func::TryGetFloat(context->Stack.Get());
 		//return (com1 < com2);
 		switch (type) { // values get are opposite
-		case ArtCode::variable_type::INT:		return (GlobalStack_int.Get() > GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::FLOAT:		return (GlobalStack_float.Get() > GlobalStack_float.Get());  break;
-		//case ArtCode::variable_type::BOOL:		return (GlobalStack_bool.Get() > GlobalStack_bool.Get());  break;
-		//case ArtCode::variable_type::INSTANCE:	return (GlobalStack_instance.Get() > GlobalStack_instance.Get());  break;
-		//case ArtCode::variable_type::OBJECT:		return (GlobalStack_int.Get() > GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::Sprite:		return (GlobalStack_int.Get() > GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::TEXTURE:	return (GlobalStack_int.Get() > GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::SOUND:		return (GlobalStack_int.Get() > GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::MUSIC:		return (GlobalStack_int.Get() > GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::FONT:		return (GlobalStack_int.Get() > GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::POINT:		return (GlobalStack_point.Get() > GlobalStack_point.Get());  break;
-		//case ArtCode::variable_type::Rect:		return (GlobalStack_rect.Get() > GlobalStack_rect.Get());  break;
-		//case ArtCode::variable_type::COLOR:		return (GlobalStack_color.Get() > GlobalStack_color.Get());  break;
-		//case ArtCode::variable_type::STRING:		return (GlobalStack_string.Get() > GlobalStack_string.Get());  break;
+		case ArtCode::variable_type::INT:		return (context->Stack.PopInt() > context->Stack.PopInt());  break;
+		case ArtCode::variable_type::FLOAT:		return (context->Stack.PopFloat() > context->Stack.PopFloat());  break;
+		//case ArtCode::variable_type::BOOL:		return (context->Stack.PopBool() > context->Stack.PopBool());  break;
+		//case ArtCode::variable_type::INSTANCE:	return (context->Stack.PopInstance() > context->Stack.PopInstance());  break;
+		//case ArtCode::variable_type::OBJECT:		return (context->Stack.PopInt() > context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::Sprite:		return (context->Stack.PopInt() > context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::TEXTURE:	return (context->Stack.PopInt() > context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::SOUND:		return (context->Stack.PopInt() > context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::MUSIC:		return (context->Stack.PopInt() > context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::FONT:		return (context->Stack.PopInt() > context->Stack.PopInt());  break;
+		case ArtCode::variable_type::POINT:		return (context->Stack.PopPoint() > context->Stack.PopPoint());  break;
+		//case ArtCode::variable_type::Rect:		return (context->Stack.PopRect() > context->Stack.PopRect());  break;
+		//case ArtCode::variable_type::COLOR:		return (context->Stack.PopColor() > context->Stack.PopColor());  break;
+		//case ArtCode::variable_type::STRING:		return (context->Stack.PopString() > context->Stack.PopString());  break;
 		default: return false; break; // wrong operator
 		}
 	}
 		break;
 	case 3://	">>"
 	{
-		//float com2 = Func::TryGetFloat(GlobalStack.Get());
-		//float com1 = Func::TryGetFloat(GlobalStack.Get());
+		//float com2 = Func::TryGetFloat(context->Stack.Get());
+		//float com1 = Func::TryGetFloat(context->Stack.Get());
 		//return (com1 > com2);
 		switch (type) {// values get are opposite
-		case ArtCode::variable_type::INT:		return (GlobalStack_int.Get() < GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::FLOAT:		return (GlobalStack_float.Get() < GlobalStack_float.Get());  break;
-		//case ArtCode::variable_type::BOOL:		return (GlobalStack_bool.Get() < GlobalStack_bool.Get());  break;
-		//case ArtCode::variable_type::INSTANCE:	return (GlobalStack_instance.Get() < GlobalStack_instance.Get());  break;
-		//case ArtCode::variable_type::OBJECT:		return (GlobalStack_int.Get() < GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::Sprite:		return (GlobalStack_int.Get() < GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::TEXTURE:	return (GlobalStack_int.Get() < GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::SOUND:		return (GlobalStack_int.Get() < GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::MUSIC:		return (GlobalStack_int.Get() < GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::FONT:		return (GlobalStack_int.Get() < GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::POINT:		return (GlobalStack_point.Get() < GlobalStack_point.Get());  break;
-		//case ArtCode::variable_type::Rect:		return (GlobalStack_rect.Get() < GlobalStack_rect.Get());  break;
-		//case ArtCode::variable_type::COLOR:		return (GlobalStack_color.Get() < GlobalStack_color.Get());  break;
-		//case ArtCode::variable_type::STRING:		return (GlobalStack_string.Get() < GlobalStack_string.Get());  break;
+		case ArtCode::variable_type::INT:		return (context->Stack.PopInt() < context->Stack.PopInt());  break;
+		case ArtCode::variable_type::FLOAT:		return (context->Stack.PopFloat() < context->Stack.PopFloat());  break;
+		//case ArtCode::variable_type::BOOL:		return (context->Stack.PopBool() < context->Stack.PopBool());  break;
+		//case ArtCode::variable_type::INSTANCE:	return (context->Stack.PopInstance() < context->Stack.PopInstance());  break;
+		//case ArtCode::variable_type::OBJECT:		return (context->Stack.PopInt() < context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::Sprite:		return (context->Stack.PopInt() < context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::TEXTURE:	return (context->Stack.PopInt() < context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::SOUND:		return (context->Stack.PopInt() < context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::MUSIC:		return (context->Stack.PopInt() < context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::FONT:		return (context->Stack.PopInt() < context->Stack.PopInt());  break;
+		case ArtCode::variable_type::POINT:		return (context->Stack.PopPoint() < context->Stack.PopPoint());  break;
+		//case ArtCode::variable_type::Rect:		return (context->Stack.PopRect() < context->Stack.PopRect());  break;
+		//case ArtCode::variable_type::COLOR:		return (context->Stack.PopColor() < context->Stack.PopColor());  break;
+		//case ArtCode::variable_type::STRING:		return (context->Stack.PopString() < context->Stack.PopString());  break;
 		default: return false; break; // wrong operator
 		}
 	}
 		break;
 	case 4://	">=",
 	{
-		//float com2 = Func::TryGetFloat(GlobalStack.Get());
-		//float com1 = Func::TryGetFloat(GlobalStack.Get());
+		//float com2 = Func::TryGetFloat(context->Stack.Get());
+		//float com1 = Func::TryGetFloat(context->Stack.Get());
 		//return (com1 >= com2);
 		switch (type) {// values get are opposite
-		case ArtCode::variable_type::INT:		return (GlobalStack_int.Get() <= GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::FLOAT:		return (GlobalStack_float.Get() <= GlobalStack_float.Get());  break;
-		//case ArtCode::variable_type::BOOL:		return (GlobalStack_bool.Get() <= GlobalStack_bool.Get());  break;
-		//case ArtCode::variable_type::INSTANCE:	return (GlobalStack_instance.Get() <= GlobalStack_instance.Get());  break;
-		//case ArtCode::variable_type::OBJECT:		return (GlobalStack_int.Get() <= GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::Sprite:		return (GlobalStack_int.Get() <= GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::TEXTURE:	return (GlobalStack_int.Get() <= GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::SOUND:		return (GlobalStack_int.Get() <= GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::MUSIC:		return (GlobalStack_int.Get() <= GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::FONT:		return (GlobalStack_int.Get() <= GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::POINT:		return (GlobalStack_point.Get() <= GlobalStack_point.Get());  break;
-		//case ArtCode::variable_type::Rect:		return (GlobalStack_rect.Get() <= GlobalStack_rect.Get());  break;
-		//case ArtCode::variable_type::COLOR:		return (GlobalStack_color.Get() <= GlobalStack_color.Get());  break;
-		//case ArtCode::variable_type::STRING:		return (GlobalStack_string.Get() <= GlobalStack_string.Get());  break;
+		case ArtCode::variable_type::INT:		return (context->Stack.PopInt() <= context->Stack.PopInt());  break;
+		case ArtCode::variable_type::FLOAT:		return (context->Stack.PopFloat() <= context->Stack.PopFloat());  break;
+		//case ArtCode::variable_type::BOOL:		return (context->Stack.PopBool() <= context->Stack.PopBool());  break;
+		//case ArtCode::variable_type::INSTANCE:	return (context->Stack.PopInstance() <= context->Stack.PopInstance());  break;
+		//case ArtCode::variable_type::OBJECT:		return (context->Stack.PopInt() <= context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::Sprite:		return (context->Stack.PopInt() <= context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::TEXTURE:	return (context->Stack.PopInt() <= context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::SOUND:		return (context->Stack.PopInt() <= context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::MUSIC:		return (context->Stack.PopInt() <= context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::FONT:		return (context->Stack.PopInt() <= context->Stack.PopInt());  break;
+		case ArtCode::variable_type::POINT:		return (context->Stack.PopPoint() <= context->Stack.PopPoint());  break;
+		//case ArtCode::variable_type::Rect:		return (context->Stack.PopRect() <= context->Stack.PopRect());  break;
+		//case ArtCode::variable_type::COLOR:		return (context->Stack.PopColor() <= context->Stack.PopColor());  break;
+		//case ArtCode::variable_type::STRING:		return (context->Stack.PopString() <= context->Stack.PopString());  break;
 		default: return false; break; // wrong operator
 		}
 	}
 		break;
 	case 5://	"<=",
 	{
-		//float com2 = Func::TryGetFloat(GlobalStack.Get());
-		//float com1 = Func::TryGetFloat(GlobalStack.Get());
+		//float com2 = Func::TryGetFloat(context->Stack.Get());
+		//float com1 = Func::TryGetFloat(context->Stack.Get());
 		//return (com1 <= com2);
 		switch (type) {
-		case ArtCode::variable_type::INT:		return (GlobalStack_int.Get() >= GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::FLOAT:		return (GlobalStack_float.Get() >= GlobalStack_float.Get());  break;
-		//case ArtCode::variable_type::BOOL:		return (GlobalStack_bool.Get() >= GlobalStack_bool.Get());  break;
-		//case ArtCode::variable_type::INSTANCE:	return (GlobalStack_instance.Get() >= GlobalStack_instance.Get());  break;
-		//case ArtCode::variable_type::OBJECT:		return (GlobalStack_int.Get() >= GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::Sprite:		return (GlobalStack_int.Get() >= GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::TEXTURE:	return (GlobalStack_int.Get() >= GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::SOUND:		return (GlobalStack_int.Get() >= GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::MUSIC:		return (GlobalStack_int.Get() >= GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::FONT:		return (GlobalStack_int.Get() >= GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::POINT:		return (GlobalStack_point.Get() >= GlobalStack_point.Get());  break;
-		//case ArtCode::variable_type::Rect:		return (GlobalStack_rect.Get() >= GlobalStack_rect.Get());  break;
-		//case ArtCode::variable_type::COLOR:		return (GlobalStack_color.Get() >= GlobalStack_color.Get());  break;
-		//case ArtCode::variable_type::STRING:		return (GlobalStack_string.Get() >= GlobalStack_string.Get());  break;
+		case ArtCode::variable_type::INT:		return (context->Stack.PopInt() >= context->Stack.PopInt());  break;
+		case ArtCode::variable_type::FLOAT:		return (context->Stack.PopFloat() >= context->Stack.PopFloat());  break;
+		//case ArtCode::variable_type::BOOL:		return (context->Stack.PopBool() >= context->Stack.PopBool());  break;
+		//case ArtCode::variable_type::INSTANCE:	return (context->Stack.PopInstance() >= context->Stack.PopInstance());  break;
+		//case ArtCode::variable_type::OBJECT:		return (context->Stack.PopInt() >= context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::Sprite:		return (context->Stack.PopInt() >= context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::TEXTURE:	return (context->Stack.PopInt() >= context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::SOUND:		return (context->Stack.PopInt() >= context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::MUSIC:		return (context->Stack.PopInt() >= context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::FONT:		return (context->Stack.PopInt() >= context->Stack.PopInt());  break;
+		case ArtCode::variable_type::POINT:		return (context->Stack.PopPoint() >= context->Stack.PopPoint());  break;
+		//case ArtCode::variable_type::Rect:		return (context->Stack.PopRect() >= context->Stack.PopRect());  break;
+		//case ArtCode::variable_type::COLOR:		return (context->Stack.PopColor() >= context->Stack.PopColor());  break;
+		//case ArtCode::variable_type::STRING:		return (context->Stack.PopString() >= context->Stack.PopString());  break;
 		default: return false; break; // wrong operator
 		}
 	}
 		break;
 	case 6://	"!=",
 	{
-		//std::string com2 = GlobalStack.Get();
-		//std::string com1 = GlobalStack.Get();
+		//std::string com2 = context->Stack.Get();
+		//std::string com1 = context->Stack.Get();
 		//return (com1 != com2);
 		switch (type) {
-		case ArtCode::variable_type::INT:		return (GlobalStack_int.Get() != GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::FLOAT:		return (GlobalStack_float.Get() != GlobalStack_float.Get());  break;
-		case ArtCode::variable_type::BOOL:		return (GlobalStack_bool.Get() != GlobalStack_bool.Get());  break;
-		case ArtCode::variable_type::INSTANCE:	return (GlobalStack_instance.Get() != GlobalStack_instance.Get());  break;
-		case ArtCode::variable_type::OBJECT:		return (GlobalStack_int.Get() != GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::SPRITE:		return (GlobalStack_int.Get() != GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::TEXTURE:	return (GlobalStack_int.Get() != GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::SOUND:		return (GlobalStack_int.Get() != GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::MUSIC:		return (GlobalStack_int.Get() != GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::FONT:		return (GlobalStack_int.Get() != GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::POINT:		return (GlobalStack_point.Get() != GlobalStack_point.Get());  break;
-		case ArtCode::variable_type::RECT:		return (GlobalStack_rect.Get() != GlobalStack_rect.Get());  break;
-		//case ArtCode::variable_type::COLOR:		return (GlobalStack_color.Get() != GlobalStack_color.Get());  break;
-		case ArtCode::variable_type::STRING:		return (GlobalStack_string.Get() != GlobalStack_string.Get());  break;
+		case ArtCode::variable_type::INT:		return (context->Stack.PopInt() != context->Stack.PopInt());  break;
+		case ArtCode::variable_type::FLOAT:		return (context->Stack.PopFloat() != context->Stack.PopFloat());  break;
+		case ArtCode::variable_type::BOOL:		return (context->Stack.PopBool() != context->Stack.PopBool());  break;
+		case ArtCode::variable_type::INSTANCE:	return (context->Stack.PopInstance() != context->Stack.PopInstance());  break;
+		case ArtCode::variable_type::OBJECT:		return (context->Stack.PopInt() != context->Stack.PopInt());  break;
+		case ArtCode::variable_type::SPRITE:		return (context->Stack.PopInt() != context->Stack.PopInt());  break;
+		case ArtCode::variable_type::TEXTURE:	return (context->Stack.PopInt() != context->Stack.PopInt());  break;
+		case ArtCode::variable_type::SOUND:		return (context->Stack.PopInt() != context->Stack.PopInt());  break;
+		case ArtCode::variable_type::MUSIC:		return (context->Stack.PopInt() != context->Stack.PopInt());  break;
+		case ArtCode::variable_type::FONT:		return (context->Stack.PopInt() != context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::POINT:		return (context->Stack.PopPoint() != context->Stack.PopPoint());  break;
+		case ArtCode::variable_type::RECT:		return (context->Stack.PopRect() != context->Stack.PopRect());  break;
+		//case ArtCode::variable_type::COLOR:		return (context->Stack.PopColor() != context->Stack.PopColor());  break;
+		case ArtCode::variable_type::STRING:		return !context->Stack.PopStringsEqual();  break;
 		default: return false; break; // wrong operator
 		}
 	}
 		break;
 	case 7://	"=="
 	{
-		//std::string com2 = GlobalStack.Get();
-		//std::string com1 = GlobalStack.Get();
+		//std::string com2 = context->Stack.Get();
+		//std::string com1 = context->Stack.Get();
 		//return (com1 == com2);
 		switch (type) {
-		case ArtCode::variable_type::INT:		return (GlobalStack_int.Get() == GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::FLOAT:		return (GlobalStack_float.Get() == GlobalStack_float.Get());  break;
-		case ArtCode::variable_type::BOOL:		return (GlobalStack_bool.Get() == GlobalStack_bool.Get());  break;
-		case ArtCode::variable_type::INSTANCE:	return (GlobalStack_instance.Get() == GlobalStack_instance.Get());  break;
-		case ArtCode::variable_type::OBJECT:		return (GlobalStack_int.Get() == GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::SPRITE:		return (GlobalStack_int.Get() == GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::TEXTURE:	return (GlobalStack_int.Get() == GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::SOUND:		return (GlobalStack_int.Get() == GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::MUSIC:		return (GlobalStack_int.Get() == GlobalStack_int.Get());  break;
-		case ArtCode::variable_type::FONT:		return (GlobalStack_int.Get() == GlobalStack_int.Get());  break;
-		//case ArtCode::variable_type::POINT:		return (GlobalStack_point.Get() == GlobalStack_point.Get());  break;
-		case ArtCode::variable_type::RECT:		return (GlobalStack_rect.Get() == GlobalStack_rect.Get());  break;
-		case ArtCode::variable_type::COLOR:		return (GlobalStack_color.Get() == GlobalStack_color.Get());  break;
-		case ArtCode::variable_type::STRING:		return (GlobalStack_string.Get() == GlobalStack_string.Get());  break;
+		case ArtCode::variable_type::INT:		return (context->Stack.PopInt() == context->Stack.PopInt());  break;
+		case ArtCode::variable_type::FLOAT:		return (context->Stack.PopFloat() == context->Stack.PopFloat());  break;
+		case ArtCode::variable_type::BOOL:		return (context->Stack.PopBool() == context->Stack.PopBool());  break;
+		case ArtCode::variable_type::INSTANCE:	return (context->Stack.PopInstance() == context->Stack.PopInstance());  break;
+		case ArtCode::variable_type::OBJECT:		return (context->Stack.PopInt() == context->Stack.PopInt());  break;
+		case ArtCode::variable_type::SPRITE:		return (context->Stack.PopInt() == context->Stack.PopInt());  break;
+		case ArtCode::variable_type::TEXTURE:	return (context->Stack.PopInt() == context->Stack.PopInt());  break;
+		case ArtCode::variable_type::SOUND:		return (context->Stack.PopInt() == context->Stack.PopInt());  break;
+		case ArtCode::variable_type::MUSIC:		return (context->Stack.PopInt() == context->Stack.PopInt());  break;
+		case ArtCode::variable_type::FONT:		return (context->Stack.PopInt() == context->Stack.PopInt());  break;
+		//case ArtCode::variable_type::POINT:		return (context->Stack.PopPoint() == context->Stack.PopPoint());  break;
+		case ArtCode::variable_type::RECT:		return (context->Stack.PopRect() == context->Stack.PopRect());  break;
+		case ArtCode::variable_type::COLOR:		return (context->Stack.PopColor() == context->Stack.PopColor());  break;
+		case ArtCode::variable_type::STRING:		return context->Stack.PopStringsEqual();  break;
 		default: return false; break; // wrong operator
 		}
 	}
 		break;
 	default://	wrong operator
-		Break();
+		context->Break();
 		return false;
 		break;
 	}
 }
 
-void CodeExecutor::h_get_local_value(Inspector* code, Instance* instance)
+void CodeExecutor::h_get_local_value(ExecutionContext* context, const ArtCode::variable_type type, const int index, Instance* instance)
 {
-	const ArtCode::variable_type type = static_cast<ArtCode::variable_type>(code->GetBit());
+#if !ART_CODE_UNCHECKED
 	ASSERT(type != ArtCode::variable_type::variable_typeInvalid, "variable_type::Invalid");
-	const int index = (int)code->GetBit();
-	//GlobalStack.Add(instance->variables[type][index]);
+#endif
 	switch (type) {
-	case ArtCode::variable_type::INT:		GlobalStack_int.Add(instance->Variables_int[index]); break;
-	case ArtCode::variable_type::FLOAT:		GlobalStack_float.Add(instance->Variables_float[index]); break;
-	case ArtCode::variable_type::BOOL:		GlobalStack_bool.Add(instance->Variables_bool[index]); break;
-	case ArtCode::variable_type::INSTANCE:	GlobalStack_instance.Add(instance->Variables_instance[index]); break;
-	case ArtCode::variable_type::OBJECT:		GlobalStack_int.Add(instance->Variables_object[index]); break;
-	case ArtCode::variable_type::SPRITE:		GlobalStack_int.Add(instance->Variables_sprite[index]); break;
-	case ArtCode::variable_type::TEXTURE:	GlobalStack_int.Add(instance->Variables_texture[index]); break;
-	case ArtCode::variable_type::SOUND:		GlobalStack_int.Add(instance->Variables_sound[index]); break;
-	case ArtCode::variable_type::MUSIC:		GlobalStack_int.Add(instance->Variables_music[index]); break;
-	case ArtCode::variable_type::FONT:		GlobalStack_int.Add(instance->Variables_font[index]); break;
-	case ArtCode::variable_type::POINT:		GlobalStack_point.Add(instance->Variables_point[index]); break;
-	case ArtCode::variable_type::RECT:		GlobalStack_rect.Add(instance->Variables_rect[index]); break;
-	case ArtCode::variable_type::COLOR:		GlobalStack_color.Add(instance->Variables_color[index]); break;
-	case ArtCode::variable_type::STRING:		GlobalStack_string.Add(instance->Variables_string[index]); break;
+	case ArtCode::variable_type::INT:		context->Stack.PushInt(instance->Variables.Get<ArtCode::INT>(index)); break;
+	case ArtCode::variable_type::FLOAT:		context->Stack.PushFloat(instance->Variables.Get<ArtCode::FLOAT>(index)); break;
+	case ArtCode::variable_type::BOOL:		context->Stack.PushBool(instance->Variables.Get<ArtCode::BOOL>(index)); break;
+	case ArtCode::variable_type::INSTANCE:	context->Stack.PushInstance(h_instance(instance->Variables.Get<ArtCode::INSTANCE>(index))); break;
+	case ArtCode::variable_type::OBJECT:		context->Stack.PushInt(instance->Variables.Get<ArtCode::OBJECT>(index)); break;
+	case ArtCode::variable_type::SPRITE:		context->Stack.PushInt(instance->Variables.Get<ArtCode::SPRITE>(index)); break;
+	case ArtCode::variable_type::TEXTURE:	context->Stack.PushInt(instance->Variables.Get<ArtCode::TEXTURE>(index)); break;
+	case ArtCode::variable_type::SOUND:		context->Stack.PushInt(instance->Variables.Get<ArtCode::SOUND>(index)); break;
+	case ArtCode::variable_type::MUSIC:		context->Stack.PushInt(instance->Variables.Get<ArtCode::MUSIC>(index)); break;
+	case ArtCode::variable_type::FONT:		context->Stack.PushInt(instance->Variables.Get<ArtCode::FONT>(index)); break;
+	case ArtCode::variable_type::POINT:		context->Stack.PushPoint(instance->Variables.Get<ArtCode::POINT>(index)); break;
+	case ArtCode::variable_type::RECT:		context->Stack.PushRect(instance->Variables.Get<ArtCode::RECT>(index)); break;
+	case ArtCode::variable_type::COLOR:		context->Stack.PushColor(instance->Variables.Get<ArtCode::COLOR>(index)); break;
+	case ArtCode::variable_type::STRING:		context->Stack.PushString(instance->Variables.Get<ArtCode::STRING>(index)); break;
+	case ArtCode::variable_type::LIST:		context->Stack.PushList(&instance->Variables.Get<ArtCode::LIST>(index)); break;
 	}
-
 }
 
-void CodeExecutor::h_get_value(Inspector* code, Instance* instance) {
-	if (code->Break) return;
-	switch (code->GetNextCommand()) {
-	case COMMAND::FUNCTION:
-		h_execute_function(code, instance);
-		break;
-	case COMMAND::LOCAL_VARIABLE:
-		h_get_local_value(code, instance);
-		break;
-	case COMMAND::VALUE: {
-		const int type = (int)code->GetBit(); // ignore for now
-		//GlobalStack.Add(code->GetString());
-		switch (type) {
-		case ArtCode::variable_type::INT:		GlobalStack_int.Add(Func::TryGetInt( code->GetString() )); break;
-		case ArtCode::variable_type::FLOAT:		GlobalStack_float.Add(Func::TryGetFloat(code->GetString())); break;
-		case ArtCode::variable_type::BOOL:		GlobalStack_bool.Add( Convert::Str2Bool( code->GetString()) ); break;
-		case ArtCode::variable_type::INSTANCE:	GlobalStack_instance.Add( Core::GetCurrentScene()->GetInstanceById(Func::TryGetInt(code->GetString())) ); break;
-		case ArtCode::variable_type::OBJECT:		GlobalStack_int.Add(Func::TryGetInt(code->GetString())); break;
-		case ArtCode::variable_type::SPRITE:		GlobalStack_int.Add(Func::TryGetInt(code->GetString())); break;
-		case ArtCode::variable_type::TEXTURE:	GlobalStack_int.Add(Func::TryGetInt(code->GetString())); break;
-		case ArtCode::variable_type::SOUND:		GlobalStack_int.Add(Func::TryGetInt(code->GetString())); break;
-		case ArtCode::variable_type::MUSIC:		GlobalStack_int.Add(Func::TryGetInt(code->GetString())); break;
-		case ArtCode::variable_type::FONT:		GlobalStack_int.Add(Func::TryGetInt(code->GetString())); break;
-		case ArtCode::variable_type::POINT:		GlobalStack_point.Add( Convert::Str2FPoint(code->GetString()) ); break;
-		case ArtCode::variable_type::RECT:		GlobalStack_rect.Add(Convert::Str2Rect(code->GetString())); break;
-		case ArtCode::variable_type::COLOR:		GlobalStack_color.Add(Convert::Hex2Color(code->GetString())); break;
-		case ArtCode::variable_type::STRING:		GlobalStack_string.Add(code->GetString()); break;
-		}
-	}
-		break;
-	case COMMAND::NULL_VALUE:
-		// do nothing
-		break;
-	default:
-
-		break;
-	}
-
-}
-
-
-void CodeExecutor::h_execute_function(Inspector* code, Instance* instance)
+void CodeExecutor::h_execute_function(ExecutionContext* context, [[maybe_unused]] const ProgramFrame* code, const int function_index, Instance* instance)
 {
-	if (code->Break) return;
-	while (!code->IsEnd()) {
-		if (code->Break) return;
-		const int function_index = (int)code->GetBit();
-		int args = (int)code->GetBit();
-		while (args-- > 0) {
-			h_get_value(code, instance);
-		}
+	if (ScriptProfiler::Enabled) {
+		context->Profile.BeginFunction(function_index);
 		if (FunctionsList[function_index] != nullptr) {
-			FunctionsList[function_index](instance);
+			FunctionsList[function_index](context, instance);
 		}
-		else {
+		context->Profile.End();
+		return;
+	}
+#if ART_CODE_UNCHECKED
+	// verifier reject code with missing functions
+	FunctionsList[function_index](context, instance);
+#else
+	if (FunctionsList[function_index] != nullptr) {
+		FunctionsList[function_index](context, instance);
+	}
+	else {
 #ifdef _DEBUG
-			Console::WriteLine(instance->Name + " script error, function not found, event name:'" + code->DebugGetFName() + "' token pos:" + std::to_string(code->DebugGetCurrentPos()) + " function index: " + std::to_string(function_index));
+		Console::WriteLine(instance->Name.Str() + " script error, function not found, event name:'" + code->Code->Name + "' instruction:" + std::to_string(code->Position - 1) + " function index: " + std::to_string(function_index));
 #endif
-		}
-		break;
 	}
-
+#endif
 }
 
 
+#undef OPCODE
 #undef COMMAND
 CodeExecutor::InstanceDefinition::EventData* CodeExecutor::GetEventData(const int id, const Event event)
 {
-	for (auto& e : _instance_definitions[id]._events) {
-		if (event == e.event) {
-			return &e;
-		}
-	}
-	return nullptr;
+	if (id < 0) return nullptr;
+	InstanceDefinition& definition = _instance_definitions[id];
+	if (!definition.HaveEvent(event)) return nullptr;
+	return &definition._events[event];
 }
@@ -1,17 +1,27 @@
 #pragma once
+#include <array>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Stack.h"
+#include "OperandStack.h"
 #include "ArtCode.h"
+#include "ExecutionContext.h"
 #include "Inspector.h"
+#include "NativeScript.h"
+#include "Program.h"
 #include "ArtCore/Enums/Event.h"
 #include "ArtCore/Scene/Instance.h"
 
 class BackGroundRenderer;
 class CodeExecutor
 {
+	// generated by Transpile, call built-in functions directly
+	friend class NativeScripts;
+	// read programs and suspended code
+	friend class SceneSnapshot;
 public:
 	// init
 	CodeExecutor();
@@ -19,26 +29,54 @@ public:
 	bool LoadArtLib();
 	bool LoadObjectDefinitions(const BackGroundRenderer* bgr, const int p_min, const int p_max);
 	bool LoadSceneTriggers();
+	// drop decoded triggers of scene, code of unloaded scene can not be executed after it
+	void ClearScenePrograms();
 	void Delete();
 
-	static int GetGlobalStackSize();
-	static int GetGlobalStackCapacity();
+	// run reference script and print instructions per second to console
+	void Benchmark(int iterations);
+	// write loaded object definitions as c++ source of native scripts
+	bool Transpile(const std::string& file) const;
+	// built-in function names by index, empty if function is not implemented
+	[[nodiscard]] std::vector<std::string> GetFunctionsNames() const;
+
+	// context of main thread, used by scene events, triggers and console
+	[[nodiscard]] ExecutionContext* GetMainContext() { return &_main_context; }
+	[[nodiscard]] int GetGlobalStackSize() const;
+	[[nodiscard]] int GetGlobalStackCapacity() const;
 
 private:
 	struct InstanceDefinition {
 	public:
 		struct EventData {
 		public:
-			Event event;
-			int size;
-			const unsigned char* data;
-
-			bool operator < (const EventData& str) const
-			{
-				return (event < str.event);
-			}
+			Event event = Event::EventInvalid;
+			int size = 0;
+			const unsigned char* data = nullptr;
+			// decoded data
+			Program code;
+			// transpiled version of data, used instead of code if set
+			NativeScript native = nullptr;
 		}; 
-		std::vector<EventData> _events;
+		// dense table indexed by Event, valid only if bit is set in HandlerMask
+		std::array<EventData, Event::EventEND> _events;
+		// bit (1 << Event) is set if definition have handler for this event
+		Uint32 HandlerMask = 0;
+		// step touch only own instance, can be executed on worker threads
+		bool LocalStep = false;
+		// step can be delayed to next frames when script budget is exceeded
+		bool LowPriority = false;
+		static_assert(Event::EventEND <= 32, "Event do not fit in HandlerMask");
+
+		[[nodiscard]] bool HaveEvent(const Event event) const
+		{
+			return (HandlerMask & (1u << event)) != 0u;
+		}
+		void AddEvent(EventData&& event_data)
+		{
+			HandlerMask |= (1u << event_data.event);
+			_events[event_data.event] = std::move(event_data);
+		}
 		
 		//		type, fields
 		std::string Name;
@@ -49,7 +87,6 @@ private:
 		{
 			Template = nullptr;
 			Name = "";
-			_events = std::vector<EventData>();
 			VariablesNames = std::map<ArtCode::variable_type, Func::str_vec>();
 			for (
 				ArtCode::variable_type v = (ArtCode::variable_type)(ArtCode::variable_type::variable_typeInvalid+1);
@@ -63,49 +100,9 @@ private:
 
 		void AddVariable(int type, const std::string& name) {
 			VariablesNames[(ArtCode::variable_type)type].emplace_back(name);
-			switch (type) {
-				case ArtCode::INT:
-					Template->Variables_int.emplace_back(0);
-					break;
-				case ArtCode::FLOAT:
-					Template->Variables_float.emplace_back(0.0f);
-					break;
-				case ArtCode::BOOL:
-					Template->Variables_bool.emplace_back(false);
-					break;
-				case ArtCode::INSTANCE:
-					Template->Variables_instance.emplace_back(nullptr);
-					break;
-				case ArtCode::OBJECT:
-					Template->Variables_object.emplace_back(-1);
-					break;
-				case ArtCode::SPRITE:
-					Template->Variables_sprite.emplace_back(-1);
-					break;
-				case ArtCode::TEXTURE:
-					Template->Variables_texture.emplace_back(-1);
-					break;
-				case ArtCode::SOUND:
-					Template->Variables_sound.emplace_back(-1);
-					break;
-				case ArtCode::MUSIC:
-					Template->Variables_music.emplace_back(-1);
-					break;
-				case ArtCode::FONT:
-					Template->Variables_font.emplace_back(-1);
-					break;
-				case ArtCode::POINT:
-					Template->Variables_point.emplace_back();
-					break;
-				case ArtCode::RECT:
-					Template->Variables_rect.emplace_back();
-					break;
-				case ArtCode::COLOR:
-					Template->Variables_color.emplace_back();
-					break;
-				case ArtCode::STRING:
-					Template->Variables_string.emplace_back();
-					break;
+			// enum is only editor type, values are stored as string
+			if (type > ArtCode::NUL && type < ArtCode::variable_typeEND && type != ArtCode::ENUM) {
+				Template->Variables.Add(static_cast<ArtCode::variable_type>(type));
 			}
 		}
 		
@@ -123,74 +120,159 @@ public:
 	[[nodiscard]] Instance* SpawnInstance(const std::string& name) const;
 	// not safe! use only in inner functions. this not error-proof
 	[[nodiscard]] Instance* SpawnInstance(int id) const; 
+	// index of instance definition, -1 if not exists
+	[[nodiscard]] int FindInstanceDefinitionId(const std::string& name) const;
+	// empty if not exists
+	[[nodiscard]] std::string GetInstanceDefinitionName(const int id) const
+	{
+		return id >= 0 && static_cast<size_t>(id) < _instance_definitions.size() ? _instance_definitions[id].Name : "";
+	}
 	void ExecuteScript(Instance* instance, Event script);
+	// only read executor data, can be called from many threads with different contexts
+	void ExecuteScript(ExecutionContext* context, Instance* instance, Event script);
+	// check if instance definition have handler for event, no need to call ExecuteScript if not
+	[[nodiscard]] bool HaveEvent(const Instance* instance, const Event event) const
+	{
+		const int id = instance->GetInstanceDefinitionId();
+		return id >= 0 && _instance_definitions[id].HaveEvent(event);
+	}
+	// true if step event of instance can run parallel with other local steps
+	[[nodiscard]] bool IsStepLocal(const Instance* instance) const
+	{
+		const int id = instance->GetInstanceDefinitionId();
+		return id >= 0 && _instance_definitions[id].LocalStep;
+	}
+	// true if step event of instance can be delayed by frame budget
+	[[nodiscard]] bool IsStepLowPriority(const Instance* instance) const
+	{
+		const int id = instance->GetInstanceDefinitionId();
+		return id >= 0 && _instance_definitions[id].LowPriority;
+	}
 	void ExecuteCode(Instance* instance, std::pair<const unsigned char*, Sint64>* code_data);
+	void ExecuteCode(ExecutionContext* context, Instance* instance, std::pair<const unsigned char*, Sint64>* code_data);
 
-	std::map<std::string, void(*)(Instance*)> FunctionsMap;
-	std::vector<void(*)(Instance*)> FunctionsList;
-
-	static void EraseGlobalStack();
-
-	static AStack<int> GlobalStack_int;
-	static AStack<float> GlobalStack_float;
-	static AStack<bool> GlobalStack_bool;
-	static AStack<Instance*> GlobalStack_instance;
-	static AStack<SDL_FPoint> GlobalStack_point;
-	static AStack<Rect> GlobalStack_rect;
-	static AStack<SDL_Color> GlobalStack_color;
-	static AStack<std::string> GlobalStack_string;
+	std::map<std::string, void(*)(ExecutionContext*, Instance*)> FunctionsMap;
+	std::vector<void(*)(ExecutionContext*, Instance*)> FunctionsList;
+	// what built-in function can read and write, set by //#PURE and //#LOCAL comment
+	enum class FunctionScope
+	{
+		// anything, step that call it is executed on main thread
+		GLOBAL,
+		// arguments, own instance, assets and input, write only own instance
+		LOCAL,
+		// result depend only on arguments and function do not change anything
+		PURE
+	};
+	// declaration from registry, same index as FunctionsList
+	struct FunctionSignature
+	{
+		ArtCode::variable_type Return = ArtCode::variable_type::NUL;
+		std::vector<ArtCode::variable_type> Arguments;
+		FunctionScope Scope = FunctionScope::GLOBAL;
+	};
+	std::vector<FunctionSignature> FunctionsSignature;
+	// built-in function as declared by comment in CodeExecutor_functions.cpp,
+	// order is the same as in AScript.lib so index is function index in bytecode
+	struct BuiltinFunction
+	{
+		static constexpr int MAX_ARGUMENTS = 10;
+		const char* Name;
+		void (*Function)(ExecutionContext*, Instance*);
+		ArtCode::variable_type Return;
+		ArtCode::variable_type Arguments[MAX_ARGUMENTS];
+		int ArgumentsCount;
+		FunctionScope Scope;
+	};
+	// generated in CodeExecutor_functions_map.cpp by generate_artlib.py
+	static const BuiltinFunction Builtins[];
+	static const size_t BuiltinsCount;
+	// slot used on operand stack by variable type
+	static OperandStack::SlotType h_slot_type(int type);
 private:
 	[[nodiscard]] Inspector* CreateInspector(const std::string& code_file) const;
-	// Break from current script
-	static void Break();
-	// list of suspended code <time, code>
-	struct SuspendCodeStruct final
+	// decoded triggers and gui callbacks, key is raw code
+	std::unordered_map<const unsigned char*, Program> _code_programs;
+	// decode and verify code of definition, nullptr if code is rejected
+	const Program* GetProgram(const unsigned char* code, Sint64 size, const std::string& name, const InstanceDefinition& definition);
+	// only code loaded by GetProgram can be executed
+	const Program* FindProgram(const unsigned char* code) const;
+	// decode and prepare program to execute
+	static bool h_decode_program(Program& program, const unsigned char* code, Sint64 size, const std::string& name);
+	// check program against definition variables, other definitions and functions signatures
+	bool h_verify_program(const Program& program, const InstanceDefinition& definition) const;
+	// program write only own instance and call only local functions, must be called before fuse
+	bool h_is_local_program(const Program& program) const;
+	// AScript.lib used by editor must declare the same functions in the same order as registry
+	static bool h_check_art_lib();
+	// create superinstructions in verified program, return count of fused instructions
+	static int h_fuse_program(Program& program);
+	// literal names of assets and objects passed to built-ins are replaced by id, return count of resolved calls
+	// program must be verified and assets loaded
+	int h_resolve_program(Program& program) const;
+	// script stopped by code_wait, slots are reused so suspending do not allocate
+	struct SuspendedFrame final
 	{
-		double Time;
-		Inspector CodeData;
-		Instance* Sender;
-		AStack<bool> IfTestState;
-		SuspendCodeStruct()
-		{
-			Time = 0.0;
-			CodeData = Inspector();
-			Sender = nullptr;
-			IfTestState = AStack<bool>();
-		}
-		SuspendCodeStruct(const double time, const Inspector* code_data, Instance* sender,
-			const AStack<bool>& if_test_state){
-			Time = time;
-			CodeData = Inspector(*code_data); // copy
-			Sender = sender;
-			IfTestState = AStack<bool>(if_test_state); // copy
-			CodeExecutor::_have_suspended_code = true;
-		}
-		~SuspendCodeStruct()
-		{
-			CodeExecutor::_have_suspended_code = CodeExecutor::_suspended_code.empty();
-		}
+		ProgramFrame CodeData;
+		Instance* Sender = nullptr;
+		// if test results, top of stack is lowest bit
+		Uint64 IfTestState = 0;
+		int IfTestCount = 0;
+		// changed when slot is freed, timer with other generation is cancelled
+		Uint32 Generation = 0;
+		// list of frames of the same sender, Next is also used for free list
+		int Next = -1;
+		int Prev = -1;
+	};
+	// min-heap entry, equal wake time keep order of adding
+	struct SuspendedTimer final
+	{
+		double WakeTime;
+		Uint64 Sequence;
+		int Slot;
+		Uint32 Generation;
 	};
-	static std::vector<SuspendCodeStruct> _suspended_code;
-	static bool _have_suspended_code;
+	static bool h_suspended_timer_later(const SuspendedTimer& a, const SuspendedTimer& b);
+	static void h_suspended_frame_free(int slot);
+	// sender counter must be already increased, time is in milliseconds from now
+	static void h_suspended_frame_add(Instance* sender, const ProgramFrame& code, Uint64 if_test_state, int if_test_count, double time);
+	static std::vector<SuspendedFrame> _suspended_frames;
+	static int _suspended_frames_free;
+	static std::vector<SuspendedTimer> _suspended_timers;
+	static Uint64 _suspended_sequence;
+	// milliseconds of game time since scene start, timers wake at absolute time
+	static double _suspended_clock;
+	// code_wait can be called from any context
+	static SDL_SpinLock _suspended_code_lock;
 public:
 	static void SuspendedCodeStop();
-	static void SuspendedCodeAdd(double time, Instance* sender);
+	// if test results of context are moved to suspended frame
+	static void SuspendedCodeAdd(ExecutionContext* context, double time, Instance* sender);
 	static void SuspendedCodeExecute();
 	static void SuspendedCodeDeleteInstance(const Instance* sender);
 
 private:
-	Inspector* _current_inspector = nullptr;
+	ExecutionContext _main_context;
 
-	void	h_execute_script(Inspector*, Instance*);
-	void	h_execute_function(Inspector* , Instance*);
-	void	h_get_value(Inspector*, Instance*);
-	int		h_if_test(Inspector* code, Instance* instance);
-	// stack of if test result, 
-	AStack<bool> _if_test_result;
-	void	h_get_local_value(Inspector* code, Instance* instance);
-	bool	h_compare(int type, int operation);
+	void	h_execute_script(ExecutionContext* context, ProgramFrame*, Instance*);
+	// instruction handlers, return false if script must stop
+#define X(name) static bool op_##name(CodeExecutor* executor, ExecutionContext* context, ProgramFrame* code, Instance* instance, const Instruction& instruction);
+	ART_CODE_OPCODES(X)
+#undef X
+	static const Program::OpHandler OpHandlers[static_cast<int>(Instruction::Opcode::INVALID)];
+	void	h_execute_function(ExecutionContext* context, const ProgramFrame* code, int function_index, Instance*);
+	static void h_get_local_value(ExecutionContext* context, ArtCode::variable_type type, int index, Instance* instance);
+	static bool h_compare(ExecutionContext* context, int type, int operation);
+	// create instance now, it is added to scene when context commands are applied
+	static Instance* h_spawn_instance(ExecutionContext* context, const std::string& name, float x, float y);
+	// the same as by name, id is index of instance definition
+	static Instance* h_spawn_instance(ExecutionContext* context, int id, float x, float y);
+	// instance variables keep handles, stale handle give nullptr
+	static Instance* h_instance(InstanceHandle handle);
+	static InstanceHandle h_handle(const Instance* instance);
 	
-	static void h_operation_global(Instance* instance, const int operation, ArtCode::variable_type type, const int index);
+	static void h_operation_global(ExecutionContext* context, Instance* instance, const int operation, ArtCode::variable_type type, const int index);
+	// same as h_operation_global, but value is other variable of the same type
+	static void h_operation_local(Instance* instance, int operation, ArtCode::variable_type type, int index, int source);
 	static int h_operation_int(int _operator, int val1, int val2);
 	static float h_operation_float(int _operator, float val1, float val2);
 	static bool h_operation_bool(int _operator, bool val1, bool val2);
@@ -210,7 +292,7 @@ private:
 public:
 	int DebugGetIfTestResultStackSize() const
 	{
-		return _if_test_result.Size();
+		return _main_context.IfTestResult.Size();
 	}
 	void DebugSetInstanceToTrack(Instance* instance);
 	std::string DebugGetTrackInfo();
@@ -219,7 +301,7 @@ private:
 	Instance* _debug_tracked_instance = nullptr;
 #endif
 private:
-#define Script(x) static void x(Instance*)
+#define Script(x) static void x(ExecutionContext*, Instance*)
 //#AUTO_GENERATOR_START
 	Script(new_point);
 	Script(new_direction);
@@ -348,6 +430,33 @@ private:
 	Script(string_join);
 	Script(string_replace);
 	Script(convert_int_to_bool);
+	Script(list_size);
+	Script(list_clear);
+	Script(list_sort);
+	Script(list_push_int);
+	Script(list_pop_int);
+	Script(list_get_int);
+	Script(list_set_int);
+	Script(list_find_int);
+	Script(list_push_float);
+	Script(list_pop_float);
+	Script(list_get_float);
+	Script(list_set_float);
+	Script(list_find_float);
+	Script(list_push_point);
+	Script(list_pop_point);
+	Script(list_get_point);
+	Script(list_set_point);
+	Script(list_find_point);
+	Script(list_push_string);
+	Script(list_pop_string);
+	Script(list_get_string);
+	Script(list_set_string);
+	Script(list_find_string);
+	Script(instance_spawn_id);
+	Script(instance_spawn_on_point_id);
+	Script(instance_create_id);
+	Script(instance_create_point_id);
 #undef Script
 };
 //end of file
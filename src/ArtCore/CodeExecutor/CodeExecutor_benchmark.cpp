@@ -0,0 +1,144 @@
+#include "CodeExecutor.h"
+
+#include "ArtCore/Functions/Convert.h"
+#include "ArtCore/Gui/Console.h"
+
+namespace
+{
+	// write ArtCode same way as ACompiler do
+	struct ArtCodeWriter
+	{
+		std::vector<unsigned char> Data;
+
+		void Command(ArtCode::Command command)
+		{
+			Data.push_back(static_cast<unsigned char>(command));
+		}
+		void Bit(const int value)
+		{
+			Data.push_back(static_cast<unsigned char>(value));
+		}
+		void Variable(const ArtCode::variable_type type, const int index)
+		{
+			Command(ArtCode::Command::LOCAL_VARIABLE);
+			Bit(type);
+			Bit(index);
+		}
+		void Value(const ArtCode::variable_type type, const std::string& value)
+		{
+			Command(ArtCode::Command::VALUE);
+			Bit(type);
+			for (const char c : value) Data.push_back(static_cast<unsigned char>(c));
+			Data.push_back('\1');
+		}
+		void Set(const int operation, const ArtCode::variable_type type, const int index)
+		{
+			Command(ArtCode::Command::SET);
+			Bit(operation);
+			Bit(type);
+			Bit(index);
+		}
+		// reserve 2 bytes of skip, return position of last one
+		size_t Skip()
+		{
+			Data.push_back(0);
+			Data.push_back(0);
+			return Data.size() - 1;
+		}
+		// skip to next written command
+		void PatchSkip(const size_t position)
+		{
+			Convert::Uint32To2ByteChar(static_cast<unsigned int>(Data.size() - position - 1), &Data[position - 1]);
+		}
+	};
+}
+
+void CodeExecutor::Benchmark(const int iterations)
+{
+	if (iterations <= 0) return;
+	// reference script, same as typical step event:
+	// set counter += 1
+	// set speed += 0.5
+	// if counter >= 0
+	//     set value := math_max(speed, 1.0)
+	int math_max_index = -1;
+	for (size_t i = 0; i < FunctionsList.size(); i++) {
+		if (FunctionsList[i] == &CodeExecutor::math_max) {
+			math_max_index = static_cast<int>(i);
+			break;
+		}
+	}
+
+	ArtCodeWriter writer;
+	writer.Set(0, ArtCode::variable_type::INT, 0);
+	writer.Value(ArtCode::variable_type::INT, "1");
+	writer.Set(0, ArtCode::variable_type::FLOAT, 0);
+	writer.Value(ArtCode::variable_type::FLOAT, "0.5");
+
+	writer.Command(ArtCode::Command::IF_TEST);
+	writer.Variable(ArtCode::variable_type::INT, 0);
+	writer.Command(ArtCode::Command::OPERATOR);
+	writer.Bit(4);
+	writer.Value(ArtCode::variable_type::INT, "0");
+	writer.Command(ArtCode::Command::IF_BODY);
+	writer.Bit(ArtCode::variable_type::INT);
+	const size_t if_skip = writer.Skip();
+
+	writer.Set(4, ArtCode::variable_type::FLOAT, 1);
+	if (math_max_index != -1) {
+		writer.Command(ArtCode::Command::FUNCTION);
+		writer.Bit(math_max_index);
+		writer.Bit(2);
+		writer.Variable(ArtCode::variable_type::FLOAT, 0);
+		writer.Value(ArtCode::variable_type::FLOAT, "1.0");
+	}
+	else {
+		writer.Variable(ArtCode::variable_type::FLOAT, 0);
+	}
+	writer.PatchSkip(if_skip);
+	writer.Command(ArtCode::Command::END);
+
+	Program program;
+	if (!h_decode_program(program, writer.Data.data(), static_cast<Sint64>(writer.Data.size()), "benchmark")) {
+		Console::WriteLine("Benchmark: can not decode reference script");
+		return;
+	}
+	// count instructions before fuse, so results can be compared
+	const int program_size = program.GetSize();
+	h_fuse_program(program);
+
+	Instance instance(-1);
+	instance.Variables.Add(ArtCode::INT);
+	instance.Variables.Add(ArtCode::FLOAT);
+	instance.Variables.Add(ArtCode::FLOAT);
+
+	// own context, state of scripts running now is not touched
+	ExecutionContext context;
+	// measure plain interpreter, program is deleted so it can not stay in reports
+	const bool profiler_enabled = ScriptProfiler::Enabled;
+	const bool counter_enabled = OpcodeCounter::Enabled;
+	ScriptProfiler::Enabled = false;
+	OpcodeCounter::Enabled = false;
+	const Uint64 start = SDL_GetPerformanceCounter();
+	for (int i = 0; i < iterations; i++) {
+		context.IfTestResult.Erase();
+		ProgramFrame code(&program);
+		h_execute_script(&context, &code, &instance);
+	}
+	const Uint64 end = SDL_GetPerformanceCounter();
+	ScriptProfiler::Enabled = profiler_enabled;
+	OpcodeCounter::Enabled = counter_enabled;
+
+	// condition is always true, every instruction is executed
+	const double seconds = static_cast<double>(end - start) / static_cast<double>(SDL_GetPerformanceFrequency());
+	const double instructions = static_cast<double>(program_size) * static_cast<double>(iterations);
+#if ART_CODE_THREADED_DISPATCH
+	const std::string dispatch = "threaded";
+#else
+	const std::string dispatch = "switch";
+#endif
+	Console::WriteLine("Benchmark [" + dispatch + "]: " + std::to_string(iterations) + " runs, " +
+		std::to_string(program_size) + " instructions each (" + std::to_string(program.Fused) + " fused), " +
+		std::to_string(seconds * 1000.0) + " ms, " +
+		std::to_string(static_cast<Uint64>(seconds > 0.0 ? instructions / seconds : 0.0)) + " instructions/s");
+}
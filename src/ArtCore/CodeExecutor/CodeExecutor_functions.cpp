@@ -13,23 +13,28 @@
 #include "ArtCore/Scene/Scene.h"
 #include "ArtCore/_Debug/Debug.h"
 
-#define StackIn_b CodeExecutor::GlobalStack_bool.Get()
-#define StackIn_p CodeExecutor::GlobalStack_point.Get()
-#define StackIn_c CodeExecutor::GlobalStack_color.Get()
-#define StackIn_r CodeExecutor::GlobalStack_rect.Get()
-#define StackIn_f CodeExecutor::GlobalStack_float.Get()
-#define StackIn_i CodeExecutor::GlobalStack_int.Get()
-#define StackIn_s CodeExecutor::GlobalStack_string.Get()
-#define StackIn_ins CodeExecutor::GlobalStack_instance.Get()
-
-#define StackOut_b(X) CodeExecutor::GlobalStack_bool.Add(X)
-#define StackOut_p(X) CodeExecutor::GlobalStack_point.Add(X)
-#define StackOut_c(X) CodeExecutor::GlobalStack_color.Add(X)
-#define StackOut_r(X) CodeExecutor::GlobalStack_rect.Add(X)
-#define StackOut_f(X) CodeExecutor::GlobalStack_float.Add(X)
-#define StackOut_i(X) CodeExecutor::GlobalStack_int.Add(X)
-#define StackOut_ins(X) CodeExecutor::GlobalStack_instance.Add(X)
-#define StackOut_s(X) CodeExecutor::GlobalStack_string.Add(X)
+// every function get context of script that call it, stack is never shared between threads
+#define StackIn_b context->Stack.PopBool()
+#define StackIn_p context->Stack.PopPoint()
+#define StackIn_c context->Stack.PopColor()
+#define StackIn_r context->Stack.PopRect()
+#define StackIn_f context->Stack.PopFloat()
+#define StackIn_i context->Stack.PopInt()
+// string is valid until next StackOut_s, copy it
+#define StackIn_s context->Stack.PopString()
+#define StackIn_ins context->Stack.PopInstance()
+#define StackIn_l context->Stack.PopList()
+
+#define StackOut_b(X) context->Stack.PushBool(X)
+#define StackOut_p(X) context->Stack.PushPoint(X)
+#define StackOut_c(X) context->Stack.PushColor(X)
+#define StackOut_r(X) context->Stack.PushRect(X)
+#define StackOut_f(X) context->Stack.PushFloat(X)
+#define StackOut_i(X) context->Stack.PushInt(X)
+#define StackOut_ins(X) context->Stack.PushInstance(X)
+#define StackOut_s(X) context->Stack.PushString(X)
+// StringId keep its id on stack, compare with string literal is integer test
+#define StackOut_sid(X) context->Stack.PushString((X).Str(), (X).GetId())
 
 
 
@@ -37,23 +42,28 @@
 // down from this line code is read by small program that generate ArtLib from comments of functions.
 // syntax is:
 // returnValue functionName(args);main text with <arguments> to replace as links;And another helper text
+// line //#PURE or //#LOCAL before comment set scope of function (see CodeExecutor::FunctionScope), without it function is global
+// after change run generate_artlib.py, it write AScript.lib and CodeExecutor_functions_map.cpp
 //#AUTO_GENERATOR_START
 
+//#PURE
 //point new_point(float x, float y);Make point (<float>, <float>).;New point from value or other.
-void CodeExecutor::new_point(Instance*) {
+void CodeExecutor::new_point(ExecutionContext* context, Instance*) {
 	const float p2 = StackIn_f;
 	const float p1 = StackIn_f;
 	StackOut_p(SDL_FPoint({ p1, p2 }));
 }
 
+//#PURE
 //float new_direction(point from, point to);Make direction from <point> to <point>.;Value are from 0 to 359.
-void CodeExecutor::new_direction(Instance*) {
+void CodeExecutor::new_direction(ExecutionContext* context, Instance*) {
 	//redirect
-	direction_between_point(nullptr);
+	direction_between_point(context, nullptr);
 }
 
+//#PURE
 //Rectangle new_rectangle(int x1, int y1, int x2, int y2);Make Rectangle from <int>, <int> to <int>, <int>.;This is const Rectangle, not width and height.
-void CodeExecutor::new_rectangle(Instance*) {
+void CodeExecutor::new_rectangle(ExecutionContext* context, Instance*) {
 	const int y2 = StackIn_i;
 	const int x2 = StackIn_i;
 	const int y1 = StackIn_i;
@@ -62,8 +72,9 @@ void CodeExecutor::new_rectangle(Instance*) {
 	StackOut_r(output);
 }
 
+//#PURE
 //Rectangle new_rectangle_f(float x1, float y1, float x2, float y2);Make Rectangle from <float>, <float> to <float>, <float>.;This is const Rectangle, not width and height.
-void CodeExecutor::new_rectangle_f(Instance*) {
+void CodeExecutor::new_rectangle_f(ExecutionContext* context, Instance*) {
 	const float y2 = StackIn_f;
 	const float x2 = StackIn_f;
 	const float y1 = StackIn_f;
@@ -73,7 +84,7 @@ void CodeExecutor::new_rectangle_f(Instance*) {
 }
 
 //sprite get_sprite(string name);Get asset handle by name <string>;Expensive function, try to not call it every frame. Call it to function and store.
-void CodeExecutor::get_sprite(Instance*) {
+void CodeExecutor::get_sprite(ExecutionContext* context, Instance*) {
 	const std::string name = StackIn_s;
 	const int sprite = Core::GetAssetManager()->GetSpriteId(name);
 	if (sprite == -1) {
@@ -83,7 +94,7 @@ void CodeExecutor::get_sprite(Instance*) {
 }
 
 //texture get_texture(string name);Get asset handle by name <string>;Expensive function, try to not call it every frame. Call it to function and store.
-void CodeExecutor::get_texture(Instance*) {
+void CodeExecutor::get_texture(ExecutionContext* context, Instance*) {
 	const std::string name = StackIn_s;
 	const int texture = Core::GetAssetManager()->GetTextureId(name);
 	if (texture == -1) {
@@ -93,7 +104,7 @@ void CodeExecutor::get_texture(Instance*) {
 }
 
 //music get_music(string name);Get asset handle by name <string>;Expensive function, try to not call it every frame. Call it to function and store.
-void CodeExecutor::get_music(Instance*) {
+void CodeExecutor::get_music(ExecutionContext* context, Instance*) {
 	const std::string name = StackIn_s;
 	const int texture = Core::GetAssetManager()->GetMusicId(name);
 	if (texture == -1) {
@@ -103,7 +114,7 @@ void CodeExecutor::get_music(Instance*) {
 }
 
 //sound get_sound(string name);Get asset handle by name <string>;Expensive function, try to not call it every frame. Call it to function and store.
-void CodeExecutor::get_sound(Instance*) {
+void CodeExecutor::get_sound(ExecutionContext* context, Instance*) {
 	const std::string name = StackIn_s;
 	const int texture = Core::GetAssetManager()->GetSoundId(name);
 	if (texture == -1) {
@@ -113,7 +124,7 @@ void CodeExecutor::get_sound(Instance*) {
 }
 
 //font get_font(string name);Get asset handle by name <string>;Expensive function, try to not call it every frame. Call it to function and store.
-void CodeExecutor::get_font(Instance*) {
+void CodeExecutor::get_font(ExecutionContext* context, Instance*) {
 	const std::string name = StackIn_s;
 	const int font = Core::GetAssetManager()->GetFontId(name);
 	if (font == -1) {
@@ -122,74 +133,84 @@ void CodeExecutor::get_font(Instance*) {
 	StackOut_i(font);
 }
 
+//#LOCAL
 //int sprite_get_width(sprite spr);Get width of <sprite>;Get int value.
-void CodeExecutor::sprite_get_width(Instance*) {
+void CodeExecutor::sprite_get_width(ExecutionContext* context, Instance*) {
 	const int id = StackIn_i;
 	const Sprite* sprite = Core::GetAssetManager()->GetSprite(id);
 	if (sprite == nullptr) StackOut_i(0);
 	else StackOut_i(sprite->GetWidth());
 }
 
+//#LOCAL
 //int sprite_get_height(sprite spr);Get height of <sprite>;Get int value.
-void CodeExecutor::sprite_get_height(Instance*) {
+void CodeExecutor::sprite_get_height(ExecutionContext* context, Instance*) {
 	const int id = StackIn_i;
 	const Sprite* sprite = Core::GetAssetManager()->GetSprite(id);
 	if (sprite == nullptr) StackOut_i(0);
 	else StackOut_i(sprite->GetHeight());
 }
 
+//#LOCAL
 //int sprite_get_frames(sprite spr);Get _frames number of <sprite>;Get int value.
-void CodeExecutor::sprite_get_frames(Instance*) {
+void CodeExecutor::sprite_get_frames(ExecutionContext* context, Instance*) {
 	const int id = StackIn_i;
 	const Sprite* sprite = Core::GetAssetManager()->GetSprite(id);
 	if (sprite == nullptr) StackOut_i(0);
 	else StackOut_i(sprite->GetMaxFrame());
 }
 
+//#LOCAL
 //null sprite_set_animation_speed(float speed);Set animation value <float> _frames per second;Every sprite can have own animation speed
-void CodeExecutor::sprite_set_animation_speed(Instance* sender) {
+void CodeExecutor::sprite_set_animation_speed(ExecutionContext* context, Instance* sender) {
 	sender->SpriteAnimationSpeed = StackIn_f;
 }
 
+//#LOCAL
 //null sprite_set_animation_loop(bool loop);Set animation loop value <bool>;Every animation end generate event ON_ANIMATION_END
-void CodeExecutor::sprite_set_animation_loop(Instance* sender) {
+void CodeExecutor::sprite_set_animation_loop(ExecutionContext* context, Instance* sender) {
 	sender->SpriteAnimationLoop = StackIn_b;
 }
 
+//#LOCAL
 //null move_to_point(point p, float speed);Move current instance to <point> with <speed> px per second.;Call it every frame.
-void CodeExecutor::move_to_point(Instance* sender) {
+void CodeExecutor::move_to_point(ExecutionContext* context, Instance* sender) {
 	const float speed = StackIn_f;
 	const SDL_FPoint dest = StackIn_p;
-	const float direction = std::atan2f(dest.y - sender->PosY, dest.x - sender->PosX);
-	sender->PosX += std::cosf(direction) * speed * static_cast<float>(Core::DeltaTime);
-	sender->PosY += std::sinf(direction) * speed * static_cast<float>(Core::DeltaTime);
+	const float direction = std::atan2f(dest.y - sender->PosY(), dest.x - sender->PosX());
+	sender->PosX() += std::cosf(direction) * speed * static_cast<float>(Core::DeltaTime);
+	sender->PosY() += std::sinf(direction) * speed * static_cast<float>(Core::DeltaTime);
 }
 
+//#LOCAL
 //null move_instant(point p);Move instantly to target <point>;This changes x and y. Not cheking for collision;
-void CodeExecutor::move_instant(Instance* sender) {
+void CodeExecutor::move_instant(ExecutionContext* context, Instance* sender) {
 	const SDL_FPoint dest = StackIn_p;
-	sender->PosX = dest.x;
-	sender->PosY = dest.y;
+	sender->PosX() = dest.x;
+	sender->PosY() = dest.y;
 }
 
+//#LOCAL
 //null move_to_direction(float direction, float speed);Move instance toward direction of <float> (0-359) with <float> speed px per seccond;If direction is not in range its clipped to 360.
-void CodeExecutor::move_to_direction(Instance* sender) {
+void CodeExecutor::move_to_direction(ExecutionContext* context, Instance* sender) {
 	const float speed = StackIn_f;
 	const float direction = StackIn_f;
-	sender->PosX += std::cosf(direction) * speed * static_cast<float>(Core::DeltaTime);
-	sender->PosY += std::sinf(direction) * speed * static_cast<float>(Core::DeltaTime);
+	sender->PosX() += std::cosf(direction) * speed * static_cast<float>(Core::DeltaTime);
+	sender->PosY() += std::sinf(direction) * speed * static_cast<float>(Core::DeltaTime);
 }
 
+//#LOCAL
 //float distance_to_point(point p);Give distance to <point>;Measure from current instance to target point.
-void CodeExecutor::distance_to_point(Instance* sender) {
+void CodeExecutor::distance_to_point(ExecutionContext* context, Instance* sender) {
 	SDL_FPoint dest = StackIn_p;
-	SDL_FPoint src = { sender->PosX, sender->PosY };
+	SDL_FPoint src = { sender->PosX(), sender->PosY() };
 	const float distance = Func::Distance(src, dest);
 	StackOut_f(distance);
 }
 
+//#PURE
 //float distance_between_point(point p1, point p2);Give distance from <point> to <point>;Measure distance.
-void CodeExecutor::distance_between_point(Instance*) {
+void CodeExecutor::distance_between_point(ExecutionContext* context, Instance*) {
 	SDL_FPoint dest = StackIn_p;
 	SDL_FPoint src = StackIn_p;
 	const float distance = Func::Distance(src, dest);
@@ -197,34 +218,37 @@ void CodeExecutor::distance_between_point(Instance*) {
 }
 
 //float distance_to_instance(instance i);Give distance to <instance> instance;Measure from current instance to target point. If target not exists return 0
-void CodeExecutor::distance_to_instance(Instance* sender) {
+void CodeExecutor::distance_to_instance(ExecutionContext* context, Instance* sender) {
 	const Instance* target = StackIn_ins;
 	if (target == nullptr) {
 		StackOut_f(0.0f);
 	}
 	else {
-		StackOut_f(Func::Distance(sender->PosX, sender->PosY, target->PosX, target->PosY));
+		StackOut_f(Func::Distance(sender->PosX(), sender->PosY(), target->PosX(), target->PosY()));
 	}
 }
 
+//#LOCAL
 //null move_forward(float speed);Move current instance forward with <speed> px per second.;Call it every frame. Function give build-in direction variable.
-void CodeExecutor::move_forward(Instance* sender) {
+void CodeExecutor::move_forward(ExecutionContext* context, Instance* sender) {
 	const float speed = StackIn_f;
-	sender->PosX += std::cosf(sender->Direction) * speed * static_cast<float>(Core::DeltaTime);
-	sender->PosY += std::sinf(sender->Direction) * speed * static_cast<float>(Core::DeltaTime);
+	sender->PosX() += std::cosf(sender->Direction()) * speed * static_cast<float>(Core::DeltaTime);
+	sender->PosY() += std::sinf(sender->Direction()) * speed * static_cast<float>(Core::DeltaTime);
 }
 
+//#LOCAL
 //float direction_to_point(point p);Give direction to <point> in degree (-180 : 180);Measure from current instance to target point.
-void CodeExecutor::direction_to_point(Instance* instance) {
+void CodeExecutor::direction_to_point(ExecutionContext* context, Instance* instance) {
 	const SDL_FPoint dest = StackIn_p;
-	const SDL_FPoint src = { instance->PosX , instance->PosY};
+	const SDL_FPoint src = { instance->PosX() , instance->PosY()};
 
 	const float direction = std::atan2f(dest.y - src.y, dest.x - src.x);
 	StackOut_f(Convert::RadiansToDegree(direction));
 }
 
+//#PURE
 //float direction_between_point(point p1, point p2);Give direction from <point> to <point> in degree (-180 : 180);Measure distance.
-void CodeExecutor::direction_between_point(Instance*) {
+void CodeExecutor::direction_between_point(ExecutionContext* context, Instance*) {
 	const SDL_FPoint dest = StackIn_p;
 	const SDL_FPoint src = StackIn_p;
 
@@ -232,19 +256,19 @@ void CodeExecutor::direction_between_point(Instance*) {
 	StackOut_f(Convert::RadiansToDegree(direction));
 }
 //float direction_to_instance(instance i);Give direction to <instance> in degree (-180 : 180);Measure from current instance to target point. If target not exists return own direction
-void CodeExecutor::direction_to_instance(Instance* self) {
+void CodeExecutor::direction_to_instance(ExecutionContext* context, Instance* self) {
 	const Instance* instance = StackIn_ins;
 	if(instance == nullptr)
 	{
-		StackOut_f(Convert::RadiansToDegree(self->Direction));
+		StackOut_f(Convert::RadiansToDegree(self->Direction()));
 		return;
 	}
-	const float direction = std::atan2f(self->PosY - instance->PosY, self->PosX - instance->PosX);
+	const float direction = std::atan2f(self->PosY() - instance->PosY(), self->PosX() - instance->PosX());
 	StackOut_f(Convert::RadiansToDegree(direction));
 }
 
 //null draw_sprite(sprite spr, float x, float y, float frame);Draw <sprite> on location (<float>,<float>) with target frame <frame>;Draw default sprite. To more options use draw_sprite_ex
-void CodeExecutor::draw_sprite(Instance*) {
+void CodeExecutor::draw_sprite(ExecutionContext* context, Instance*) {
 	const float frame = StackIn_f;
 	float y = StackIn_f;
 	float x = StackIn_f;
@@ -253,7 +277,7 @@ void CodeExecutor::draw_sprite(Instance*) {
 }
 
 //null draw_sprite_ex(sprite spr, float x, float y, float frame, float x_scale, float y_scale, float x_center, float y_center, float angle, float alpha);
-void CodeExecutor::draw_sprite_ex(Instance*) {
+void CodeExecutor::draw_sprite_ex(ExecutionContext* context, Instance*) {
 	const float alpha = StackIn_f;
 	const float angle = StackIn_f;
 	const float y_center = StackIn_f;
@@ -268,7 +292,7 @@ void CodeExecutor::draw_sprite_ex(Instance*) {
 }
 
 //null draw_texture(texture tex, float x, float y);Draw <texture> on (<float>,<float>).;Draw standard texture with it normal dimensions. For extended option use 'Draw texture extended';
-void CodeExecutor::draw_texture(Instance*) {
+void CodeExecutor::draw_texture(ExecutionContext* context, Instance*) {
 	float y = StackIn_f;
 	float x = StackIn_f;
 	const int textureId = StackIn_i;
@@ -276,7 +300,7 @@ void CodeExecutor::draw_texture(Instance*) {
 }
 
 //null draw_texture_ex(texture tex, float x, float y, float x_scale, float y_scale, float angle, float alpha);Draw <texture> on (<float>,<float>), with scale (<float>,<float>), angle <float> and aplha <float>;Angle range is (0 - 359) alpha (0.0f - 1.0f).
-void CodeExecutor::draw_texture_ex(Instance*) {
+void CodeExecutor::draw_texture_ex(ExecutionContext* context, Instance*) {
 	const float alpha = StackIn_f;
 	const float angle = StackIn_f;
 	float y_scale = StackIn_f;
@@ -288,13 +312,13 @@ void CodeExecutor::draw_texture_ex(Instance*) {
 }
 
 //null draw_sprite_self();Draw self sprite on self coords with sprite scale and angle;Use build-in variables;
-void CodeExecutor::draw_sprite_self(Instance* instance) {
+void CodeExecutor::draw_sprite_self(ExecutionContext* context, Instance* instance) {
 	if (instance->SelfSprite == nullptr) return;
 	instance->DrawSelf();
 }
 
 //null draw_shape_rectangle(float x1, float y2, float x2, float y2, color color);Draw frame of Rectangle from (<float>,<float>) to (<float>,<float>) with color <color>.;Draw Rectangle on final coords;
-void CodeExecutor::draw_shape_rectangle(Instance*) {
+void CodeExecutor::draw_shape_rectangle(ExecutionContext* context, Instance*) {
 	const SDL_Color color = StackIn_c;
 	const float y2 = StackIn_f;
 	const float x2 = StackIn_f;
@@ -304,14 +328,14 @@ void CodeExecutor::draw_shape_rectangle(Instance*) {
 }
 
 //null draw_shape_rectangle_r(Rectangle rect, color color);Draw frame of <Rectangle> with color <color>.;Draw Rectangle;
-void CodeExecutor::draw_shape_rectangle_r(Instance*) {
-	Rect rect = StackIn_r;
+void CodeExecutor::draw_shape_rectangle_r(ExecutionContext* context, Instance*) {
 	const SDL_Color color = StackIn_c;
+	Rect rect = StackIn_r;
 	Render::DrawRect(rect.ToGPU_Rect(), color);
 }
 
 //null draw_shape_rectangle_filled(float x1, float y2, float x2, float y2, color color);Draw filled of Rectangle from (<float>,<float>) to (<float>,<float>) with color <color>.;Draw Rectangle on final coords;
-void CodeExecutor::draw_shape_rectangle_filled(Instance*) {
+void CodeExecutor::draw_shape_rectangle_filled(ExecutionContext* context, Instance*) {
 	const SDL_Color color = StackIn_c;
 	const float y2 = StackIn_f;
 	const float x2 = StackIn_f;
@@ -321,14 +345,14 @@ void CodeExecutor::draw_shape_rectangle_filled(Instance*) {
 }
 
 //null draw_shape_rectangle_filled_r(Rectangle rect, color color);Draw filled <Rectangle> with color <color>.;Draw Rectangle;
-void CodeExecutor::draw_shape_rectangle_filled_r(Instance*) {
-	Rect rect = StackIn_r;
+void CodeExecutor::draw_shape_rectangle_filled_r(ExecutionContext* context, Instance*) {
 	const SDL_Color color = StackIn_c;
+	Rect rect = StackIn_r;
 	Render::DrawRectFilled(rect.ToGPU_Rect(), color);
 }
 
 //null draw_shape_circle(float x, float y, float radius, color color);Draw Circle in point (<float>,<float>) with radius <float> and color <color>;
-void CodeExecutor::draw_shape_circle(Instance*) {
+void CodeExecutor::draw_shape_circle(ExecutionContext* context, Instance*) {
 	const SDL_Color color = StackIn_c;
 	const float radius = StackIn_f;
 	float y = StackIn_f;
@@ -337,7 +361,7 @@ void CodeExecutor::draw_shape_circle(Instance*) {
 }
 
 //null draw_shape_circle_p(point p, float radius, color color);Draw Circle in point <point> with radius <float> and color <color>;
-void CodeExecutor::draw_shape_circle_p(Instance*) {
+void CodeExecutor::draw_shape_circle_p(ExecutionContext* context, Instance*) {
 	const SDL_Color color = StackIn_c;
 	const float radius = StackIn_f;
 	const SDL_FPoint p = StackIn_p;
@@ -345,7 +369,7 @@ void CodeExecutor::draw_shape_circle_p(Instance*) {
 }
 
 //null draw_shape_circle_filled(float x, float y, float radius, color color);Draw filled Circle in point (<float>,<float>) with radius <float> and color <color>;
-void CodeExecutor::draw_shape_circle_filled(Instance*) {
+void CodeExecutor::draw_shape_circle_filled(ExecutionContext* context, Instance*) {
 	const SDL_Color color = StackIn_c;
 	const float radius = StackIn_f;
 	float y = StackIn_f;
@@ -354,47 +378,53 @@ void CodeExecutor::draw_shape_circle_filled(Instance*) {
 }
 
 //null draw_shape_circle_filled_p(point p, float radius, color color);Draw filled Circle in point <point> with radius <float> and color <color>;
-void CodeExecutor::draw_shape_circle_filled_p(Instance*) {
+void CodeExecutor::draw_shape_circle_filled_p(ExecutionContext* context, Instance*) {
 	const SDL_Color color = StackIn_c;
 	const float radius = StackIn_f;
 	const SDL_FPoint p = StackIn_p;
 	Render::DrawCircleFilled(p, radius, color);
 }
 
+//#PURE
 //int math_min_i(int a, int b);Get minimum value from <int> or <int>;
-void CodeExecutor::math_min_i(Instance*) {
+void CodeExecutor::math_min_i(ExecutionContext* context, Instance*) {
 	const int b = StackIn_i;
 	const int a = StackIn_i;
 	StackOut_i(std::max(a, b));
 }
 
+//#PURE
 //int math_max_i(int a, int b);Get maximum value from <int> or <int>;
-void CodeExecutor::math_max_i(Instance*) {
+void CodeExecutor::math_max_i(ExecutionContext* context, Instance*) {
 	const int b = StackIn_i;
 	const int a = StackIn_i;
 	StackOut_i(std::max(a, b));
 }
 
+//#PURE
 //float math_min(float a, float b);Get minimum value from <float> or <float>;
-void CodeExecutor::math_min(Instance*) {
+void CodeExecutor::math_min(ExecutionContext* context, Instance*) {
 	const float b = StackIn_f;
 	const float a = StackIn_f;
 	StackOut_f(std::min(a, b));
 }
 
+//#PURE
 //float math_max(float a, float b);Get maximum value from <float> or <float>;
-void CodeExecutor::math_max(Instance*) {
+void CodeExecutor::math_max(ExecutionContext* context, Instance*) {
 	const float b = StackIn_f;
 	const float a = StackIn_f;
 	StackOut_f( std::max(a, b) );
 }
 
+//#LOCAL
 //point global_get_mouse();Get point of current mouse postion;If map is bigger than screen this give map coords not screen;
-void CodeExecutor::global_get_mouse(Instance*) {
+void CodeExecutor::global_get_mouse(ExecutionContext* context, Instance*) {
 	StackOut_p(Core::Mouse.XYf);
 }
+//#LOCAL
 //null set_self_sprite(sprite spr); Set self sprite to <sprite> with default scale, angle, speed, loop; You can mod sprite via set_sprite_ etc.;
-void CodeExecutor::set_self_sprite(Instance* instance) {
+void CodeExecutor::set_self_sprite(ExecutionContext* context, Instance* instance) {
 	const int spriteId = StackIn_i;
 	if (spriteId != -1) {
 		Sprite* sprite = Core::GetAssetManager()->GetSprite(spriteId);
@@ -414,7 +444,7 @@ void CodeExecutor::set_self_sprite(Instance* instance) {
 				//null set_body_type(string type, int value);Set body type for instance, of <string> and optional <int> value; type is enum: None,Sprite,Rect,Circle
 				StackOut_s("Sprite");
 				StackOut_f(instance->SelfSprite->GetMaskValue());
-				set_body_type(instance);
+				set_body_type(context, instance);
 			}
 			return;
 		}
@@ -430,34 +460,37 @@ void CodeExecutor::set_self_sprite(Instance* instance) {
 	instance->SpriteAnimationLoop = false;
 }
 
+//#LOCAL
 //float get_pos_x(); Get x coords of instance;
-void CodeExecutor::get_pos_x(Instance* instance) {
-	StackOut_f(instance->PosX);
+void CodeExecutor::get_pos_x(ExecutionContext* context, Instance* instance) {
+	StackOut_f(instance->PosX());
 }
 
+//#LOCAL
 //float get_pos_y(); Get y coords of instance;
-void CodeExecutor::get_pos_y(Instance* instance) {
-	StackOut_f(instance->PosY);
+void CodeExecutor::get_pos_y(ExecutionContext* context, Instance* instance) {
+	StackOut_f(instance->PosY());
 }
 
 //null sound_play(sound asset);Play <asset> sound global;For position call sound_play_at(sound asset)
-void CodeExecutor::sound_play(Instance*) {
+void CodeExecutor::sound_play(ExecutionContext* context, Instance*) {
 	const int SoundId = StackIn_i;
 	Mix_Chunk* sound = Core::GetAssetManager()->GetSound(SoundId);
 	if (sound == nullptr) return;
-	Mix_PlayChannel(-1, sound, 0);
+	context->Commands.PlaySound(sound);
 }
 
 //null music_play(music asset);Play <asset> music.;There is only one music at once;
-void CodeExecutor::music_play(Instance*) {
+void CodeExecutor::music_play(ExecutionContext* context, Instance*) {
 	const int SoundId = StackIn_i;
 	Mix_Music* music = Core::GetAssetManager()->GetMusic(SoundId);
 	if (music == nullptr) return;
-	Mix_PlayMusic(music, 0);
+	context->Commands.PlayMusic(music);
 }
 
+//#LOCAL
 //null sprite_next_frame(); Set SelfSprite next frame; If sprite loop is enable, frame = 0 if frame > frame_max;
-void CodeExecutor::sprite_next_frame(Instance* sender) {
+void CodeExecutor::sprite_next_frame(ExecutionContext* context, Instance* sender) {
 	if (sender->SelfSprite == nullptr) return;
 	if ( static_cast<int>(++sender->SpriteAnimationFrame) >= sender->SelfSprite->GetMaxFrame()) {
 		if (sender->SpriteAnimationLoop) {
@@ -469,8 +502,9 @@ void CodeExecutor::sprite_next_frame(Instance* sender) {
 	}
 }
 
+//#LOCAL
 //null sprite_prev_frame(); Set SelfSprite previous frame; If sprite loop is enable, frame = frame_max if frame < frame_max 0;
-void CodeExecutor::sprite_prev_frame(Instance* sender) {
+void CodeExecutor::sprite_prev_frame(ExecutionContext* context, Instance* sender) {
 	if (sender->SelfSprite == nullptr) return;
 	if ( static_cast<int>(--sender->SpriteAnimationFrame) < 0) {
 		if (sender->SpriteAnimationLoop) {
@@ -482,19 +516,22 @@ void CodeExecutor::sprite_prev_frame(Instance* sender) {
 	}
 }
 
+//#LOCAL
 //null sprite_set_frame(int frame); Set SelfSprite frame no <int>.; If frame is not exists nothing happen;
-void CodeExecutor::sprite_set_frame(Instance* sender) {
+void CodeExecutor::sprite_set_frame(ExecutionContext* context, Instance* sender) {
 	const int frame = StackIn_i;
 	if (frame < 0 || frame >= sender->SelfSprite->GetMaxFrame()) return;
 	sender->SpriteAnimationFrame = static_cast<float>(frame);
 }
 
+//#LOCAL
 //null code_do_nothing();Do nothing, empty action;Use when there is no else in if
-void CodeExecutor::code_do_nothing(Instance*) {
+void CodeExecutor::code_do_nothing(ExecutionContext* context, Instance*) {
 	return;
 }
+//#LOCAL
 //null set_body_type(string type, float value);Set body type for instance, of <string> and optional <float> value; type is enum: None,Sprite,Rect,Circle
-void CodeExecutor::set_body_type(Instance* sender) {
+void CodeExecutor::set_body_type(ExecutionContext* context, Instance* sender) {
 	const float value = StackIn_f;
 	const std::string type = StackIn_s;
 	if (Instance::BodyType::Body_fromString(type) == Instance::BodyType::BodyInvalid) return;
@@ -536,174 +573,183 @@ void CodeExecutor::set_body_type(Instance* sender) {
 }
 
 //null instance_set_tag(string tag);Set tag for current instance <string>.
-void CodeExecutor::instance_set_tag(Instance* sender) {
-	const std::string tag = StackIn_s;
-	sender->Tag = tag;
+void CodeExecutor::instance_set_tag(ExecutionContext* context, Instance* sender) {
+	Core::GetCurrentScene()->SetInstanceTag(sender, StringId(StackIn_s));
 }
 
 //instance collision_get_collider();Return reference to instance with this object is collide;Other colliders must be solid too to collide;
-void CodeExecutor::collision_get_collider(Instance*) {
+void CodeExecutor::collision_get_collider(ExecutionContext* context, Instance*) {
 	StackOut_ins( Core::GetCurrentScene()->CurrentCollisionInstance );
 }
 //string collision_get_collider_tag();Get tag of instance that is coliding with this object;Other colliders must be solid too to collide;
-void CodeExecutor::collision_get_collider_tag(Instance*) {
+void CodeExecutor::collision_get_collider_tag(ExecutionContext* context, Instance*) {
 	if (Core::GetCurrentScene()->CurrentCollisionInstance != nullptr)
-		StackOut_s(Core::GetCurrentScene()->CurrentCollisionInstance->Tag);
+		StackOut_sid(Core::GetCurrentScene()->CurrentCollisionInstance->Tag);
 	else
 		StackOut_s("nul");
 }
 //string collision_get_collider_name();Get name of instance that is coliding with this object;Other colliders must be solid too to collide;
-void CodeExecutor::collision_get_collider_name(Instance*) {
+void CodeExecutor::collision_get_collider_name(ExecutionContext* context, Instance*) {
 	if (Core::GetCurrentScene()->CurrentCollisionInstance != nullptr)
-		StackOut_s(Core::GetCurrentScene()->CurrentCollisionInstance->Name);
+		StackOut_sid(Core::GetCurrentScene()->CurrentCollisionInstance->Name);
 	else
 		StackOut_s("nul");
 }
 //int collision_get_collider_id();Get id of instance that is coliding with this object;Other colliders must be solid too to collide;
-void CodeExecutor::collision_get_collider_id(Instance*) {
+void CodeExecutor::collision_get_collider_id(ExecutionContext* context, Instance*) {
 	if (Core::GetCurrentScene()->CurrentCollisionInstance != nullptr)
 		StackOut_i(static_cast<int>(Core::GetCurrentScene()->CurrentCollisionInstanceId));
 	else
 		StackOut_i(-1);
 }
 //int get_random(int max);Get random value [0,<int>).;0 is include max is exclude;
-void CodeExecutor::get_random(Instance*) {
+void CodeExecutor::get_random(ExecutionContext* context, Instance*) {
 	const int max = StackIn_i;
 	StackOut_i(rand() % max);
 }
 //int get_random_range(int min, int max);Get random value [<int>,<int>).;0 is include max is exclude;
-void CodeExecutor::get_random_range(Instance*) {
+void CodeExecutor::get_random_range(ExecutionContext* context, Instance*) {
 	const int max = StackIn_i;
 	const int min = StackIn_i;
 	StackOut_i(min + (std::rand() % (max - min + 1)));
 }
 //null scene_change_transmission(string scene, string transmission);[NOT_IMPLEMENTED_YET];0;
-void CodeExecutor::scene_change_transmission(Instance*) {
+void CodeExecutor::scene_change_transmission(ExecutionContext* context, Instance*) {
 	std::string transmission = StackIn_s;
 	std::string scene = StackIn_s;
 }
 //null scene_change(string scene);Change scene to <scene>;This is quick change, for transmission use scene_change_transmission[NOT_IMPLEMENTED_YET];
-void CodeExecutor::scene_change(Instance*) {
-	Core::GetInstance()->ChangeScene(StackIn_s);
+void CodeExecutor::scene_change(ExecutionContext* context, Instance*) {
+	const std::string scene = StackIn_s;
+	context->Commands.ChangeScene(scene);
 }
 //float get_direction_of(instance target);Return direction of <instance> instance in degree (-180 : 180);Use with collision_get_collider, if target not exists return own direction
-void CodeExecutor::get_direction_of(Instance* sender) {
+void CodeExecutor::get_direction_of(ExecutionContext* context, Instance* sender) {
 	const Instance* target = StackIn_ins;
 	if (target == nullptr) {
-		StackOut_f(Convert::RadiansToDegree(sender->Direction));
+		StackOut_f(Convert::RadiansToDegree(sender->Direction()));
 	}
 	else {
-		StackOut_f(Convert::RadiansToDegree(target->Direction));
+		StackOut_f(Convert::RadiansToDegree(target->Direction()));
 	}
 }
 //instance instance_spawn(string name, float x, float y);Spawn object <string> at (<float>,<float>) and return reference to it;Ypu can use reference to pass arguments;
-void CodeExecutor::instance_spawn(Instance*) {
+void CodeExecutor::instance_spawn(ExecutionContext* context, Instance*) {
 	const float y = StackIn_f;
 	const float x = StackIn_f;
 	const std::string obj_name = StackIn_s;
-	Instance* ref = Core::GetCurrentScene()->CreateInstance(obj_name, x, y);
-	StackOut_ins(ref);
+	StackOut_ins(h_spawn_instance(context, obj_name, x, y));
 }
 //instance instance_spawn_on_point(string name, point xy);Spawn object <string> at (<point>) and return reference to it;Ypu can use reference to pass arguments;
-void CodeExecutor::instance_spawn_on_point(Instance*) {
+void CodeExecutor::instance_spawn_on_point(ExecutionContext* context, Instance*) {
 	const SDL_FPoint xy = StackIn_p;
 	const std::string obj_name = StackIn_s;
-	Instance* ref = Core::GetCurrentScene()->CreateInstance(obj_name, xy.x, xy.y);
-	StackOut_ins(ref);
+	StackOut_ins(h_spawn_instance(context, obj_name, xy.x, xy.y));
 }
 //null instance_create(string name, float x, float y);Spawn object <string> at (<float>,<float>) in current scene;This not return reference;
-void CodeExecutor::instance_create(Instance*) {
+void CodeExecutor::instance_create(ExecutionContext* context, Instance*) {
 	const float y = StackIn_f;
 	const float x = StackIn_f;
 	const std::string obj_name = StackIn_s;
-	Core::GetCurrentScene()->CreateInstance(obj_name, x, y);
+	h_spawn_instance(context, obj_name, x, y);
 }
 //null set_direction_for_target(instance target, float direction);Set <instance> direction to <float> value in degree (-180 : 180);You can get reference from id of instance
-void CodeExecutor::set_direction_for_target(Instance*) {
+void CodeExecutor::set_direction_for_target(ExecutionContext* context, Instance*) {
 	const float direction = StackIn_f;
 	Instance* instance = StackIn_ins;
 	if (instance != nullptr) {
-		instance->Direction = Convert::DegreeToRadians(direction);
+		instance->Direction() = Convert::DegreeToRadians(direction);
 	}
 }
+//#LOCAL
 //null set_direction(float direction);Set current direction to <float> in degree (-180 : 180);
-void CodeExecutor::set_direction(Instance* sender) {
+void CodeExecutor::set_direction(ExecutionContext* context, Instance* sender) {
 	const float direction = StackIn_f;
-	sender->Direction = Convert::DegreeToRadians(direction);
+	sender->Direction() = Convert::DegreeToRadians(direction);
 }
 
+//#PURE
 //float convert_int_to_float(int value);Convert <int> to float type;
-void CodeExecutor::convert_int_to_float(Instance* sender) {
+void CodeExecutor::convert_int_to_float(ExecutionContext* context, Instance* sender) {
 	StackOut_f((float)StackIn_i);
 }
 
+//#PURE
 //int convert_float_to_int(float value);Convert <float> to int type;
-void CodeExecutor::convert_float_to_int(Instance* sender) {
+void CodeExecutor::convert_float_to_int(ExecutionContext* context, Instance* sender) {
 	StackOut_i((int) SDL_roundf(StackIn_f));
 }
 //null instance_delete_self();Delete self;
-void CodeExecutor::instance_delete_self(Instance* sender) {
-	sender->Delete();
+void CodeExecutor::instance_delete_self(ExecutionContext* context, Instance* sender) {
+	context->Commands.DeleteInstance(sender);
 }
+//#LOCAL
 //float get_direction();Get current direction;
-void CodeExecutor::get_direction(Instance* sender) {
-	StackOut_f(sender->Direction);
+void CodeExecutor::get_direction(ExecutionContext* context, Instance* sender) {
+	StackOut_f(sender->Direction());
 }
+//#PURE
 //float math_add(float a, float b);Get sum of <float> + <float>;
-void CodeExecutor::math_add(Instance* sender) {
+void CodeExecutor::math_add(ExecutionContext* context, Instance* sender) {
 	const float b = StackIn_f;
 	const float a = StackIn_f;
 	StackOut_f(a + b);
 }
+//#PURE
 //float math_sub(float a, float b);Get sub of <float> - <float>;
-void CodeExecutor::math_sub(Instance* sender) {
+void CodeExecutor::math_sub(ExecutionContext* context, Instance* sender) {
 	const float b = StackIn_f;
 	const float a = StackIn_f;
 	StackOut_f(a - b);
 }
+//#PURE
 //float math_mul(float a, float b);Get mul of <float> * <float>;
-void CodeExecutor::math_mul(Instance* sender) {
+void CodeExecutor::math_mul(ExecutionContext* context, Instance* sender) {
 	const float b = StackIn_f;
 	const float a = StackIn_f;
 	StackOut_f(a * b);
 }
+//#PURE
 //float math_div(float a, float b);Get div of <float> / <float>;
-void CodeExecutor::math_div(Instance* sender) {
+void CodeExecutor::math_div(ExecutionContext* context, Instance* sender) {
 	const float b = StackIn_f;
 	const float a = StackIn_f;
 	StackOut_f(a / b);
 }
+//#PURE
 //float get_point_x(point point);Get x of <point> point;
-void CodeExecutor::get_point_x(Instance* sender) {
+void CodeExecutor::get_point_x(ExecutionContext* context, Instance* sender) {
 	StackOut_f(StackIn_p.x);
 }
+//#PURE
 //float get_point_y(point point);Get y of <point> point;
-void CodeExecutor::get_point_y(Instance* sender) {
+void CodeExecutor::get_point_y(ExecutionContext* context, Instance* sender) {
 	StackOut_f(StackIn_p.y);
 }
 //null collision_push_other(bool myself);Push other instance in other direction, if <bool> then push this instance too;Like opposite magnets;
-void CodeExecutor::collision_push_other(Instance* self) {
+void CodeExecutor::collision_push_other(ExecutionContext* context, Instance* self) {
 	const bool myself = StackIn_b;
 
 	Instance* other = Core::GetCurrentScene()->CurrentCollisionInstance;
 	if (other == nullptr) return;
 
-	const float direction = std::atan2f(other->PosY - self->PosY, other->PosX - self->PosX);
+	const float direction = std::atan2f(other->PosY() - self->PosY(), other->PosX() - self->PosX());
 	float move;
 	if (myself) {
-		other->PosX += std::cosf(direction) * 16.f * static_cast<float>(Core::DeltaTime);
-		other->PosY += std::sinf(direction) * 16.f * static_cast<float>(Core::DeltaTime);
+		other->PosX() += std::cosf(direction) * 16.f * static_cast<float>(Core::DeltaTime);
+		other->PosY() += std::sinf(direction) * 16.f * static_cast<float>(Core::DeltaTime);
 		move = 16.f;
 	}
 	else {
 		move = 32.f;
 	}
-	other->PosX += std::cosf(direction - 180.f) * move * static_cast<float>(Core::DeltaTime);
-	other->PosY += std::sinf(direction - 180.f) * move * static_cast<float>(Core::DeltaTime);
+	other->PosX() += std::cosf(direction - 180.f) * move * static_cast<float>(Core::DeltaTime);
+	other->PosY() += std::sinf(direction - 180.f) * move * static_cast<float>(Core::DeltaTime);
 
 }
+//#LOCAL
 //bool mouse_is_pressed(int button);Return state of button <int>;Left button is 1, right is 3
-void CodeExecutor::mouse_is_pressed(Instance* sender) {
+void CodeExecutor::mouse_is_pressed(ExecutionContext* context, Instance* sender) {
 	const int button = StackIn_i;
 	if (button == 1) {
 		StackOut_b(Core::Mouse.LeftPressed);
@@ -716,16 +762,18 @@ void CodeExecutor::mouse_is_pressed(Instance* sender) {
 	// else
 	StackOut_b(false);
 }
+//#LOCAL
 //float get_delta_time();Return delta time of frame.;Every build-in action of moving or collision uses delta time, do not use twice!
-void CodeExecutor::get_delta_time(Instance* sender) {
+void CodeExecutor::get_delta_time(ExecutionContext* context, Instance* sender) {
 	StackOut_f( static_cast<float>(Core::DeltaTime) );
 }
+//#LOCAL
 //null code_break(); Break from current function; Everything will be lost...
-void CodeExecutor::code_break(Instance*) {
-	CodeExecutor::Break();
+void CodeExecutor::code_break(ExecutionContext* context, Instance*) {
+	context->Break();
 }
 //null draw_text(font font, int x, int y, string text, color color);Use <font> and draw <string> on screen on (<int>,<int>) with <color> color;If font is null, default font is used;
-void CodeExecutor::draw_text(Instance*) {
+void CodeExecutor::draw_text(ExecutionContext* context, Instance*) {
 	const SDL_Color color = StackIn_c;
 	const std::string text = StackIn_s;
 	float y = static_cast<float>(StackIn_i);
@@ -739,16 +787,19 @@ void CodeExecutor::draw_text(Instance*) {
 	Render::DrawText(text, font, { x,y }, color);
 
 }
+//#PURE
 //string convert_int_to_string(int input);Convert <int> to string;
-void CodeExecutor::convert_int_to_string(Instance*) {
+void CodeExecutor::convert_int_to_string(ExecutionContext* context, Instance*) {
 	StackOut_s(std::to_string(StackIn_i));
 }
-//string convert_float_to_string(int input);Convert <int> to string;
-void CodeExecutor::convert_float_to_string(Instance*) {
+//#PURE
+//string convert_float_to_string(float input);Convert <float> to string;
+void CodeExecutor::convert_float_to_string(ExecutionContext* context, Instance*) {
 	StackOut_s(std::to_string(StackIn_f));
 }
+//#LOCAL
 //null sprite_set_scale(point scale);Set scale for self sprite <point>;Scale is from point (width, height)
-void CodeExecutor::sprite_set_scale(Instance* sender) {
+void CodeExecutor::sprite_set_scale(ExecutionContext* context, Instance* sender) {
 	const SDL_FPoint scale = StackIn_p;
 	if (sender->SelfSprite != nullptr) {
 		sender->SpriteScaleX = scale.x;
@@ -756,7 +807,7 @@ void CodeExecutor::sprite_set_scale(Instance* sender) {
 	}
 }
 //null draw_text_in_frame(font font, string text, float x, float y, color text_color, color frame_color, color background_color);Using <font> draw <text> in frame at (<float>,<float>) with <color>. Frame color is <color> and background <color>;
-void CodeExecutor::draw_text_in_frame(Instance*)
+void CodeExecutor::draw_text_in_frame(ExecutionContext* context, Instance*)
 {
 	const SDL_Color background_color = StackIn_c;
 	const SDL_Color frame_color = StackIn_c;
@@ -774,147 +825,143 @@ void CodeExecutor::draw_text_in_frame(Instance*)
 	Render::DrawTextAlign(text, font, { x,y }, text_color, FC_ALIGN_CENTER);
 }
 //null gui_change_visibility(string guiTag, bool visible);Change visibility variable for <string> to <bool>;Give path to element panel1/button1 by tags. Root is in default first tag do not include it
-void CodeExecutor::gui_change_visibility(Instance*)
+void CodeExecutor::gui_change_visibility(ExecutionContext* context, Instance*)
 {
 	const bool visible = StackIn_b;
 	const std::string guiTag = StackIn_s;
 
-	Gui::GuiElementTemplate* element = Core::GetCurrentScene()->GuiSystem.Element(guiTag);
-	if (element == nullptr) return;
-	element->SetVisible(visible);
+	context->Commands.GuiVisibility(guiTag, visible);
 }
 //null gui_change_enabled(string guiTag, bool enable);Change enabled variable for <string> to <bool>;Give path to element panel1/button1 by tags. Root is in default first tag do not include it
-void CodeExecutor::gui_change_enabled(Instance*)
+void CodeExecutor::gui_change_enabled(ExecutionContext* context, Instance*)
 {
 	const bool enable = StackIn_b;
 	const std::string guiTag = StackIn_s;
 
-	Gui::GuiElementTemplate* element = Core::GetCurrentScene()->GuiSystem.Element(guiTag);
-	if (element == nullptr) return;
-	element->SetEnabled(enable);
+	context->Commands.GuiEnabled(guiTag, enable);
 }
 //null code_execute_trigger(string trigger);Execute trigger <string> on current scene;Create this triggers in scene editor.
-void CodeExecutor::code_execute_trigger(Instance*)
+void CodeExecutor::code_execute_trigger(ExecutionContext* context, Instance*)
 {
 	const std::string trigger = StackIn_s;
-	Core::Executor()->ExecuteCode(
+	Core::Executor()->ExecuteCode(context,
 		Core::GetCurrentScene()->GetVariableHolder(),
 		Core::GetCurrentScene()->GetTriggerData(trigger));
 
 }
 //null code_wait(int milliseconds);Suspend this trigger for <int> milliseconds.;This suspend future execution of this trigger until time have pass.
-void CodeExecutor::code_wait(Instance* sender)
+void CodeExecutor::code_wait(ExecutionContext* context, Instance* sender)
 {
 	const int milliseconds = StackIn_i;
-	CodeExecutor::SuspendedCodeAdd((double)milliseconds, sender);
-	Break();
+	CodeExecutor::SuspendedCodeAdd(context, (double)milliseconds, sender);
+	context->Break();
 }
 //null game_exit();Exit the game;
-void CodeExecutor::game_exit(Instance*)
+void CodeExecutor::game_exit(ExecutionContext* context, Instance*)
 {
 	Core::Exit();
 }
 //point get_instance_position(instance instance);Get position of <instance>;
-void CodeExecutor::get_instance_position(Instance*)
+void CodeExecutor::get_instance_position(ExecutionContext* context, Instance*)
 {
 	const Instance* instance = StackIn_ins;
 	if (instance == nullptr)
 	{
-		Break();
+		context->Break();
 		return;
 	}
-	const SDL_FPoint new_point = { instance->PosX, instance->PosY };
+	const SDL_FPoint new_point = { instance->PosX(), instance->PosY() };
 	StackOut_p(new_point);
 }
 //float get_instance_position_x(instance instance);Get position X of <instance>;
-void CodeExecutor::get_instance_position_x(Instance*)
+void CodeExecutor::get_instance_position_x(ExecutionContext* context, Instance*)
 {
 	const Instance* instance = StackIn_ins;
 	if (instance == nullptr)
 	{
-		Break();
+		context->Break();
 		return;
 	}
-	StackOut_f(instance->PosX);
+	StackOut_f(instance->PosX());
 }
 //float get_instance_position_y(instance instance);Get position Y of <instance>;
-void CodeExecutor::get_instance_position_y(Instance*)
+void CodeExecutor::get_instance_position_y(ExecutionContext* context, Instance*)
 {
 	const Instance* instance = StackIn_ins;
 	if (instance == nullptr)
 	{
-		Break();
+		context->Break();
 		return;
 	}
-	StackOut_f(instance->PosY);
+	StackOut_f(instance->PosY());
 }
 
 //null instance_create_point(string name, point xy);Spawn object <string> at (<point>) in current scene;This not return reference;
-void CodeExecutor::instance_create_point(Instance*) {
+void CodeExecutor::instance_create_point(ExecutionContext* context, Instance*) {
 	const SDL_FPoint xy = StackIn_p;
 	const std::string obj_name = StackIn_s;
-	Core::GetCurrentScene()->CreateInstance(obj_name, xy.x, xy.y);
+	h_spawn_instance(context, obj_name, xy.x, xy.y);
 }
 
 //null instance_delete_other(instance instance);Delete <instance>;
-void CodeExecutor::instance_delete_other(Instance*) {
+void CodeExecutor::instance_delete_other(ExecutionContext* context, Instance*) {
 	Instance* instance = StackIn_ins;
 	if (instance == nullptr)
 	{
-		Break();
+		context->Break();
 		return;
 	}
-	instance->Delete();
+	context->Commands.DeleteInstance(instance);
 }
 
 //instance instance_find_by_tag(string tag);Find instance by tag: <string>;All tags must be unique, else returned instance is first found;
-void CodeExecutor::instance_find_by_tag(Instance*) {
+void CodeExecutor::instance_find_by_tag(ExecutionContext* context, Instance*) {
 	const std::string tag = StackIn_s;
 	Instance* instance = Core::GetCurrentScene()->GetInstanceByTag(tag);
 	StackOut_ins(instance);
 }
 
 //bool instance_exists(instance instance);Get current status of <instance>
-void CodeExecutor::instance_exists(Instance*) {
+void CodeExecutor::instance_exists(ExecutionContext* context, Instance*) {
 	const Instance* instance = StackIn_ins;
 	if(instance != nullptr)
 	{
-		StackOut_b(instance->Alive);
+		StackOut_b(instance->Alive());
 	}else
 	{
 		StackOut_b(false);
 	}
 }
 //bool instance_alive(instance instance);Get current status of <instance>
-void CodeExecutor::instance_alive(Instance*) {
+void CodeExecutor::instance_alive(ExecutionContext* context, Instance*) {
 	const Instance* instance = StackIn_ins;
 	if(instance == nullptr)
 	{
 		StackOut_b(false);
 	}else
 	{
-		StackOut_b(instance->Alive);
+		StackOut_b(instance->Alive());
 	}
 }
 
 //int scene_get_width();Get scene width;
-void CodeExecutor::scene_get_width(Instance*) {
+void CodeExecutor::scene_get_width(ExecutionContext* context, Instance*) {
 	StackOut_i(Core::GetCurrentScene()->GetWidth());
 }
 //int scene_get_height();Get scene height;
-void CodeExecutor::scene_get_height(Instance*) {
+void CodeExecutor::scene_get_height(ExecutionContext* context, Instance*) {
 	StackOut_i(Core::GetCurrentScene()->GetHeight());
 }
 
 //null collision_bounce();Change direction of this object, bounce of other.;This trigger works only in OnCollision event!
-void CodeExecutor::collision_bounce(Instance* sender) {
+void CodeExecutor::collision_bounce(ExecutionContext* context, Instance* sender) {
 	Instance* target = Core::GetCurrentScene()->CurrentCollisionInstance;
 	// all error checks is in Physics
 	Physics::BounceInstance(sender, target);
 }
 
 //int gui_get_slider_value(string gui_tag);Get exact value from slider with <string> tag;Tag must be unique. Values are between min and max and rounded to step
-void CodeExecutor::gui_get_slider_value(Instance*) {
+void CodeExecutor::gui_get_slider_value(ExecutionContext* context, Instance*) {
 	const std::string gui_tag = StackIn_s;
 	try {
 		const GuiElement::Slider* element = dynamic_cast<GuiElement::Slider*>(Core::GetCurrentScene()->GuiSystem.GetElementById(gui_tag));
@@ -922,7 +969,7 @@ void CodeExecutor::gui_get_slider_value(Instance*) {
 		{
 			// error
 			ASSERT(true, "element not found id='" + gui_tag + "'");
-			Break();
+			context->Break();
 			return;
 		}
 		StackOut_i(element->GetValue());
@@ -934,7 +981,7 @@ void CodeExecutor::gui_get_slider_value(Instance*) {
 }
 
 //bool gui_get_check_box_value(string gui_tag);Get checked value from check box with <string> tag;Tag must be unique. Values are true or false
-void CodeExecutor::gui_get_check_box_value(Instance*) {
+void CodeExecutor::gui_get_check_box_value(ExecutionContext* context, Instance*) {
 	const std::string gui_tag = StackIn_s;
 	try {
 		const GuiElement::CheckButton* element = dynamic_cast<GuiElement::CheckButton*>(Core::GetCurrentScene()->GuiSystem.GetElementById(gui_tag));
@@ -942,7 +989,7 @@ void CodeExecutor::gui_get_check_box_value(Instance*) {
 		{
 			// error
 			ASSERT(true, "element not found id='" + gui_tag + "'");
-			Break();
+			context->Break();
 			return;
 		}
 		StackOut_b(element->Checked());
@@ -955,7 +1002,7 @@ void CodeExecutor::gui_get_check_box_value(Instance*) {
 }
 
 //int gui_get_drop_down_selected_index(string gui_tag);Get selected index of drop down gui element with tag <string>;Index is 0-based
-void CodeExecutor::gui_get_drop_down_selected_index(Instance*) {
+void CodeExecutor::gui_get_drop_down_selected_index(ExecutionContext* context, Instance*) {
 	const std::string gui_tag = StackIn_s;
 	try {
 		const GuiElement::DropDownList* element = dynamic_cast<GuiElement::DropDownList*>(Core::GetCurrentScene()->GuiSystem.GetElementById(gui_tag));
@@ -963,7 +1010,7 @@ void CodeExecutor::gui_get_drop_down_selected_index(Instance*) {
 		{
 			// error
 			ASSERT(true, "element not found id='" + gui_tag + "'");
-			Break();
+			context->Break();
 			return;
 		}
 		StackOut_i(element->GetSelectedIndex());
@@ -976,7 +1023,7 @@ void CodeExecutor::gui_get_drop_down_selected_index(Instance*) {
 }
 
 //int gui_get_drop_down_selected_value(string gui_tag);Get selected value of drop down gui element with tag <string>;Value may be empty if nothing is selected
-void CodeExecutor::gui_get_drop_down_selected_value(Instance*) {
+void CodeExecutor::gui_get_drop_down_selected_value(ExecutionContext* context, Instance*) {
 	const std::string gui_tag = StackIn_s;
 	try {
 		const GuiElement::DropDownList* element = dynamic_cast<GuiElement::DropDownList*>(Core::GetCurrentScene()->GuiSystem.GetElementById(gui_tag));
@@ -984,7 +1031,7 @@ void CodeExecutor::gui_get_drop_down_selected_value(Instance*) {
 		{
 			// error
 			ASSERT(true, "element not found id='" + gui_tag + "'");
-			Break();
+			context->Break();
 			return;
 		}
 		StackOut_s(element->GetSelectedValue());
@@ -997,7 +1044,7 @@ void CodeExecutor::gui_get_drop_down_selected_value(Instance*) {
 }
 
 //null gui_set_slider_value( int value, string gui_tag);Set exact value <int> for slider with <string> tag;Tag must be unique. Values are between min and max and rounded to step
-void CodeExecutor::gui_set_slider_value(Instance*) {
+void CodeExecutor::gui_set_slider_value(ExecutionContext* context, Instance*) {
 	const std::string gui_tag = StackIn_s;
 	const int value = StackIn_i;
 	try {
@@ -1006,7 +1053,7 @@ void CodeExecutor::gui_set_slider_value(Instance*) {
 		{
 			// error
 			ASSERT(true, "element not found id='" + gui_tag + "'");
-			Break();
+			context->Break();
 			return;
 		}
 		element->SetValue(value);
@@ -1019,7 +1066,7 @@ void CodeExecutor::gui_set_slider_value(Instance*) {
 }
 
 //null gui_set_slider_value_min( int value, string gui_tag);Set minimum value <int> for slider with <string> tag;Tag must be unique. Values are between min and max and rounded to step
-void CodeExecutor::gui_set_slider_value_min(Instance*) {
+void CodeExecutor::gui_set_slider_value_min(ExecutionContext* context, Instance*) {
 	const std::string gui_tag = StackIn_s;
 	const int value = StackIn_i;
 	try {
@@ -1028,7 +1075,7 @@ void CodeExecutor::gui_set_slider_value_min(Instance*) {
 		{
 			// error
 			ASSERT(true, "element not found id='" + gui_tag + "'");
-			Break();
+			context->Break();
 			return;
 		}
 		element->SetValueMin(value);
@@ -1041,7 +1088,7 @@ void CodeExecutor::gui_set_slider_value_min(Instance*) {
 }
 
 //null gui_set_slider_value_max( int value, string gui_tag);Set maximum value <int> for slider with <string> tag;Tag must be unique. Values are between min and max and rounded to step
-void CodeExecutor::gui_set_slider_value_max(Instance*) {
+void CodeExecutor::gui_set_slider_value_max(ExecutionContext* context, Instance*) {
 	const std::string gui_tag = StackIn_s;
 	const int value = StackIn_i;
 	try {
@@ -1050,7 +1097,7 @@ void CodeExecutor::gui_set_slider_value_max(Instance*) {
 		{
 			// error
 			ASSERT(true, "element not found id='" + gui_tag + "'");
-			Break();
+			context->Break();
 			return;
 		}
 		element->SetValueMax(value);
@@ -1063,7 +1110,7 @@ void CodeExecutor::gui_set_slider_value_max(Instance*) {
 }
 
 //null gui_set_slider_value_step( int value, string gui_tag);Set step value <int> for slider with <string> tag;Tag must be unique. Values are between min and max and rounded to step
-void CodeExecutor::gui_set_slider_value_step(Instance*) {
+void CodeExecutor::gui_set_slider_value_step(ExecutionContext* context, Instance*) {
 	const std::string gui_tag = StackIn_s;
 	const int value = StackIn_i;
 	try {
@@ -1072,7 +1119,7 @@ void CodeExecutor::gui_set_slider_value_step(Instance*) {
 		{
 			// error
 			ASSERT(true, "element not found id='" + gui_tag + "'");
-			Break();
+			context->Break();
 			return;
 		}
 		element->SetValueStep(value);
@@ -1085,7 +1132,7 @@ void CodeExecutor::gui_set_slider_value_step(Instance*) {
 }
 
 //null gui_set_check_box_value(bool value, string gui_tag);Set checked property of <bool> for check box with <string> tag;Tag must be unique. Values are true or false
-void CodeExecutor::gui_set_check_box_value(Instance*) {
+void CodeExecutor::gui_set_check_box_value(ExecutionContext* context, Instance*) {
 	const std::string gui_tag = StackIn_s;
 	const bool value = StackIn_b;
 	try {
@@ -1094,7 +1141,7 @@ void CodeExecutor::gui_set_check_box_value(Instance*) {
 		{
 			// error
 			ASSERT(true, "element not found id='" + gui_tag + "'");
-			Break();
+			context->Break();
 			return;
 		}
 		element->SetState(value);
@@ -1107,7 +1154,7 @@ void CodeExecutor::gui_set_check_box_value(Instance*) {
 }
 
 //null gui_set_drop_down_selected_index(int index, string gui_tag);Set selected index <int> for drop down list with tag <string>;Selected index is checked if can be selected
-void CodeExecutor::gui_set_drop_down_selected_index(Instance*) {
+void CodeExecutor::gui_set_drop_down_selected_index(ExecutionContext* context, Instance*) {
 	const std::string gui_tag = StackIn_s;
 	const int value = StackIn_i;
 	try {
@@ -1116,7 +1163,7 @@ void CodeExecutor::gui_set_drop_down_selected_index(Instance*) {
 		{
 			// error
 			ASSERT(true, "element not found id='" + gui_tag + "'");
-			Break();
+			context->Break();
 			return;
 		}
 		element->SetSelectedIndex(value);
@@ -1129,14 +1176,14 @@ void CodeExecutor::gui_set_drop_down_selected_index(Instance*) {
 }
 
 //null system_set_video_mode(bool full_screen);Set full screen to <bool>;
-void CodeExecutor::system_set_video_mode(Instance*) {
+void CodeExecutor::system_set_video_mode(ExecutionContext* context, Instance*) {
 	const bool mode = StackIn_b;
 	Core::Graphic.SetFullScreen(mode);
 	Core::Graphic.Apply();
 }
 
 //null system_set_video_resolution(int width, int height);Set window resolution to <int> x <int>;
-void CodeExecutor::system_set_video_resolution(Instance*) {
+void CodeExecutor::system_set_video_resolution(ExecutionContext* context, Instance*) {
 	const int height = StackIn_i;
 	const int width = StackIn_i;
 	if (width == 0 || height == 0)
@@ -1149,7 +1196,7 @@ void CodeExecutor::system_set_video_resolution(Instance*) {
 }
 
 //null system_set_video_resolution_from_string(string value);Set window resolution from <string> text;Text must be 0000x0000 (width x height)
-void CodeExecutor::system_set_video_resolution_from_string(Instance*) {
+void CodeExecutor::system_set_video_resolution_from_string(ExecutionContext* context, Instance*) {
 	const std::string video_resolution = StackIn_s;
 	const Func::str_vec video_resolution_s = Func::Split(video_resolution, 'x');
 	if(video_resolution_s.size() != 2)
@@ -1169,7 +1216,7 @@ void CodeExecutor::system_set_video_resolution_from_string(Instance*) {
 }
 
 //null system_set_video_bloom_factor(int mode);Set mode for bloom post process to <int>;0-off, 1-low, 2-medium, 3-high;
-void CodeExecutor::system_set_video_bloom_factor(Instance*) {
+void CodeExecutor::system_set_video_bloom_factor(ExecutionContext* context, Instance*) {
 	switch(std::clamp(StackIn_i, 0, 3))
 	{
 	case 0:
@@ -1192,57 +1239,60 @@ void CodeExecutor::system_set_video_bloom_factor(Instance*) {
 }
 
 //null system_set_audio_master(bool mode);Set audio mode for master to <bool>; True means sounds can be played, have higher priority than other audio modes
-void CodeExecutor::system_set_audio_master(Instance*) {
+void CodeExecutor::system_set_audio_master(ExecutionContext* context, Instance*) {
 	Core::Audio.SetMaster(StackIn_b);
 }
 
 //null system_set_audio_music(bool mode);Set audio mode for music to <bool>; True means sounds can be played
-void CodeExecutor::system_set_audio_music(Instance*) {
+void CodeExecutor::system_set_audio_music(ExecutionContext* context, Instance*) {
 	Core::Audio.SetMusic(StackIn_b);
 }
 
 //null system_set_audio_sound(bool mode);Set audio mode for sound to <bool>; True means sounds can be played
-void CodeExecutor::system_set_audio_sound(Instance*) {
+void CodeExecutor::system_set_audio_sound(ExecutionContext* context, Instance*) {
 	Core::Audio.SetSound(StackIn_b);
 }
 
 //null system_set_audio_music_level(int level);Set audio level to <int> percent;Level can be from 0 to 100;
-void CodeExecutor::system_set_audio_music_level(Instance*) {
+void CodeExecutor::system_set_audio_music_level(ExecutionContext* context, Instance*) {
 	Core::Audio.SetSoundLevel(StackIn_i);
 }
 
 //null system_set_audio_sound_level(int level);Set audio level to <int> percent;Level can be from 0 to 100;
-void CodeExecutor::system_set_audio_sound_level(Instance*) {
+void CodeExecutor::system_set_audio_sound_level(ExecutionContext* context, Instance*) {
 	Core::Audio.SetMusicLevel(StackIn_i);
 }
 
 //int system_settings_data_get_int(string setting);Get value of settings data name <string>;On error return -1
-void CodeExecutor::system_settings_data_get_int(Instance*) {
+void CodeExecutor::system_settings_data_get_int(ExecutionContext* context, Instance*) {
 	const std::string setting = StackIn_s;
 	StackOut_i(Core::SD_GetInt(setting, -1));
 }
 
 //string system_settings_data_get_string(string setting);Get value of settings data name <string>;On error return empty string ""
-void CodeExecutor::system_settings_data_get_string(Instance*) {
+void CodeExecutor::system_settings_data_get_string(ExecutionContext* context, Instance*) {
 	const std::string setting = StackIn_s;
 	StackOut_s(Core::SD_GetString(setting, ""));
 }
 
+//#PURE
 //int string_get_length(string text);Get length of target <string> text;
-void CodeExecutor::string_get_length(Instance*) {
+void CodeExecutor::string_get_length(ExecutionContext* context, Instance*) {
 	const std::string string = StackIn_s;
 	StackOut_i(static_cast<int>(string.length()));
 }
 
+//#PURE
 //string string_join(string str1, string str2);Create new string from <string> and <string>;
-void CodeExecutor::string_join(Instance*) {
+void CodeExecutor::string_join(ExecutionContext* context, Instance*) {
 	const std::string string2 = StackIn_s;
 	const std::string string1 = StackIn_s;
 	StackOut_s(string1 + string2);
 }
 
+//#PURE
 //string string_replace(string target, string search, string replace);Target text: <string>.\nSearch <string> and replace with <string>;
-void CodeExecutor::string_replace(Instance*) {
+void CodeExecutor::string_replace(ExecutionContext* context, Instance*) {
 	
 	const std::string replace = StackIn_s;
 	const std::string search = StackIn_s;
@@ -1251,7 +1301,217 @@ void CodeExecutor::string_replace(Instance*) {
 	StackOut_s(target);
 }
 
+//#PURE
 //bool convert_int_to_bool(int input);Convert <int> to bool. Only 1 is true, rest is false;
-void CodeExecutor::convert_int_to_bool(Instance*) {
+void CodeExecutor::convert_int_to_bool(ExecutionContext* context, Instance*) {
 	StackOut_b(StackIn_i == 1);
+}
+
+//#LOCAL
+//int list_size(list l);Get count of values in <list>;
+void CodeExecutor::list_size(ExecutionContext* context, Instance*) {
+	const ArtList* list = StackIn_l;
+	StackOut_i(list == nullptr ? 0 : list->Size());
+}
+
+//#LOCAL
+//null list_clear(list l);Remove all values from <list>. After clear list can hold values of any type;
+void CodeExecutor::list_clear(ExecutionContext* context, Instance*) {
+	if (ArtList* list = StackIn_l; list != nullptr) list->Clear();
+}
+
+//#LOCAL
+//null list_sort(list l);Sort values of <list> ascending. Points are sorted by x and then by y;
+void CodeExecutor::list_sort(ExecutionContext* context, Instance*) {
+	if (ArtList* list = StackIn_l; list != nullptr) list->Sort();
+}
+
+//#LOCAL
+//null list_push_int(list l, int value);Add <int> at end of <list>;Nothing is added if list have values of other type
+void CodeExecutor::list_push_int(ExecutionContext* context, Instance*) {
+	const int value = StackIn_i;
+	if (ArtList* list = StackIn_l; list != nullptr) list->Push(value);
+}
+
+//#LOCAL
+//int list_pop_int(list l);Remove last value of <list> and return it;On error return 0
+void CodeExecutor::list_pop_int(ExecutionContext* context, Instance*) {
+	int value = 0;
+	if (ArtList* list = StackIn_l; list != nullptr) list->Pop(&value);
+	StackOut_i(value);
+}
+
+//#LOCAL
+//int list_get_int(list l, int index);Get value of <list> at <int> index;On error return 0
+void CodeExecutor::list_get_int(ExecutionContext* context, Instance*) {
+	const int index = StackIn_i;
+	int value = 0;
+	if (const ArtList* list = StackIn_l; list != nullptr) list->Get(index, &value);
+	StackOut_i(value);
+}
+
+//#LOCAL
+//null list_set_int(list l, int index, int value);Set value of <list> at <int> index to <int>;Nothing is changed if index is out of list
+void CodeExecutor::list_set_int(ExecutionContext* context, Instance*) {
+	const int value = StackIn_i;
+	const int index = StackIn_i;
+	if (ArtList* list = StackIn_l; list != nullptr) list->Set(index, value);
+}
+
+//#LOCAL
+//int list_find_int(list l, int value);Get index of first <int> in <list>;If not found return -1
+void CodeExecutor::list_find_int(ExecutionContext* context, Instance*) {
+	const int value = StackIn_i;
+	const ArtList* list = StackIn_l;
+	StackOut_i(list == nullptr ? -1 : list->Find(value));
+}
+
+//#LOCAL
+//null list_push_float(list l, float value);Add <float> at end of <list>;Nothing is added if list have values of other type
+void CodeExecutor::list_push_float(ExecutionContext* context, Instance*) {
+	const float value = StackIn_f;
+	if (ArtList* list = StackIn_l; list != nullptr) list->Push(value);
+}
+
+//#LOCAL
+//float list_pop_float(list l);Remove last value of <list> and return it;On error return 0.0
+void CodeExecutor::list_pop_float(ExecutionContext* context, Instance*) {
+	float value = 0.0f;
+	if (ArtList* list = StackIn_l; list != nullptr) list->Pop(&value);
+	StackOut_f(value);
+}
+
+//#LOCAL
+//float list_get_float(list l, int index);Get value of <list> at <int> index;On error return 0.0
+void CodeExecutor::list_get_float(ExecutionContext* context, Instance*) {
+	const int index = StackIn_i;
+	float value = 0.0f;
+	if (const ArtList* list = StackIn_l; list != nullptr) list->Get(index, &value);
+	StackOut_f(value);
+}
+
+//#LOCAL
+//null list_set_float(list l, int index, float value);Set value of <list> at <int> index to <float>;Nothing is changed if index is out of list
+void CodeExecutor::list_set_float(ExecutionContext* context, Instance*) {
+	const float value = StackIn_f;
+	const int index = StackIn_i;
+	if (ArtList* list = StackIn_l; list != nullptr) list->Set(index, value);
+}
+
+//#LOCAL
+//int list_find_float(list l, float value);Get index of first <float> in <list>;If not found return -1
+void CodeExecutor::list_find_float(ExecutionContext* context, Instance*) {
+	const float value = StackIn_f;
+	const ArtList* list = StackIn_l;
+	StackOut_i(list == nullptr ? -1 : list->Find(value));
+}
+
+//#LOCAL
+//null list_push_point(list l, point value);Add <point> at end of <list>;Nothing is added if list have values of other type
+void CodeExecutor::list_push_point(ExecutionContext* context, Instance*) {
+	const SDL_FPoint value = StackIn_p;
+	if (ArtList* list = StackIn_l; list != nullptr) list->Push(value);
+}
+
+//#LOCAL
+//point list_pop_point(list l);Remove last value of <list> and return it;On error return <0, 0>
+void CodeExecutor::list_pop_point(ExecutionContext* context, Instance*) {
+	SDL_FPoint value = SDL_FPoint{ 0.0f, 0.0f };
+	if (ArtList* list = StackIn_l; list != nullptr) list->Pop(&value);
+	StackOut_p(value);
+}
+
+//#LOCAL
+//point list_get_point(list l, int index);Get value of <list> at <int> index;On error return <0, 0>
+void CodeExecutor::list_get_point(ExecutionContext* context, Instance*) {
+	const int index = StackIn_i;
+	SDL_FPoint value = SDL_FPoint{ 0.0f, 0.0f };
+	if (const ArtList* list = StackIn_l; list != nullptr) list->Get(index, &value);
+	StackOut_p(value);
+}
+
+//#LOCAL
+//null list_set_point(list l, int index, point value);Set value of <list> at <int> index to <point>;Nothing is changed if index is out of list
+void CodeExecutor::list_set_point(ExecutionContext* context, Instance*) {
+	const SDL_FPoint value = StackIn_p;
+	const int index = StackIn_i;
+	if (ArtList* list = StackIn_l; list != nullptr) list->Set(index, value);
+}
+
+//#LOCAL
+//int list_find_point(list l, point value);Get index of first <point> in <list>;If not found return -1
+void CodeExecutor::list_find_point(ExecutionContext* context, Instance*) {
+	const SDL_FPoint value = StackIn_p;
+	const ArtList* list = StackIn_l;
+	StackOut_i(list == nullptr ? -1 : list->Find(value));
+}
+
+//#LOCAL
+//null list_push_string(list l, string value);Add <string> at end of <list>;Nothing is added if list have values of other type
+void CodeExecutor::list_push_string(ExecutionContext* context, Instance*) {
+	const std::string value = StackIn_s;
+	if (ArtList* list = StackIn_l; list != nullptr) list->Push(value);
+}
+
+//#LOCAL
+//string list_pop_string(list l);Remove last value of <list> and return it;On error return empty string ""
+void CodeExecutor::list_pop_string(ExecutionContext* context, Instance*) {
+	std::string value = std::string();
+	if (ArtList* list = StackIn_l; list != nullptr) list->Pop(&value);
+	StackOut_s(value);
+}
+
+//#LOCAL
+//string list_get_string(list l, int index);Get value of <list> at <int> index;On error return empty string ""
+void CodeExecutor::list_get_string(ExecutionContext* context, Instance*) {
+	const int index = StackIn_i;
+	std::string value = std::string();
+	if (const ArtList* list = StackIn_l; list != nullptr) list->Get(index, &value);
+	StackOut_s(value);
+}
+
+//#LOCAL
+//null list_set_string(list l, int index, string value);Set value of <list> at <int> index to <string>;Nothing is changed if index is out of list
+void CodeExecutor::list_set_string(ExecutionContext* context, Instance*) {
+	const std::string value = StackIn_s;
+	const int index = StackIn_i;
+	if (ArtList* list = StackIn_l; list != nullptr) list->Set(index, value);
+}
+
+//#LOCAL
+//int list_find_string(list l, string value);Get index of first <string> in <list>;If not found return -1
+void CodeExecutor::list_find_string(ExecutionContext* context, Instance*) {
+	const std::string value = StackIn_s;
+	const ArtList* list = StackIn_l;
+	StackOut_i(list == nullptr ? -1 : list->Find(value));
+}
+
+//instance instance_spawn_id(object obj, float x, float y);Spawn <object> at (<float>,<float>) and return reference to it;Literal name in instance_spawn is replaced by this function on load
+void CodeExecutor::instance_spawn_id(ExecutionContext* context, Instance*) {
+	const float y = StackIn_f;
+	const float x = StackIn_f;
+	const int obj = StackIn_i;
+	StackOut_ins(h_spawn_instance(context, obj, x, y));
+}
+
+//instance instance_spawn_on_point_id(object obj, point xy);Spawn <object> at (<point>) and return reference to it;Literal name in instance_spawn_on_point is replaced by this function on load
+void CodeExecutor::instance_spawn_on_point_id(ExecutionContext* context, Instance*) {
+	const SDL_FPoint xy = StackIn_p;
+	const int obj = StackIn_i;
+	StackOut_ins(h_spawn_instance(context, obj, xy.x, xy.y));
+}
+
+//null instance_create_id(object obj, float x, float y);Spawn <object> at (<float>,<float>) in current scene;Literal name in instance_create is replaced by this function on load
+void CodeExecutor::instance_create_id(ExecutionContext* context, Instance*) {
+	const float y = StackIn_f;
+	const float x = StackIn_f;
+	const int obj = StackIn_i;
+	h_spawn_instance(context, obj, x, y);
+}
+
+//null instance_create_point_id(object obj, point xy);Spawn <object> at (<point>) in current scene;Literal name in instance_create_point is replaced by this function on load
+void CodeExecutor::instance_create_point_id(ExecutionContext* context, Instance*) {
+	const SDL_FPoint xy = StackIn_p;
+	const int obj = StackIn_i;
+	h_spawn_instance(context, obj, xy.x, xy.y);
 }
\ No newline at end of file
@@ -1,135 +1,171 @@
 #include "CodeExecutor.h"
-//this file is auto generated from ArtLibGenerator
-//do not edit anything bellow
+//this file is generated by generate_artlib.py from comments in CodeExecutor_functions.cpp
+//do not edit anything bellow, change comments and run generator again
+#define T ArtCode::variable_type
+constexpr CodeExecutor::BuiltinFunction CodeExecutor::Builtins[] = {
+	{ "new_point", &CodeExecutor::new_point, T::POINT, { T::FLOAT, T::FLOAT }, 2, FunctionScope::PURE },
+	{ "new_direction", &CodeExecutor::new_direction, T::FLOAT, { T::POINT, T::POINT }, 2, FunctionScope::PURE },
+	{ "new_rectangle", &CodeExecutor::new_rectangle, T::RECT, { T::INT, T::INT, T::INT, T::INT }, 4, FunctionScope::PURE },
+	{ "new_rectangle_f", &CodeExecutor::new_rectangle_f, T::RECT, { T::FLOAT, T::FLOAT, T::FLOAT, T::FLOAT }, 4, FunctionScope::PURE },
+	{ "get_sprite", &CodeExecutor::get_sprite, T::SPRITE, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "get_texture", &CodeExecutor::get_texture, T::TEXTURE, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "get_music", &CodeExecutor::get_music, T::MUSIC, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "get_sound", &CodeExecutor::get_sound, T::SOUND, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "get_font", &CodeExecutor::get_font, T::FONT, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "sprite_get_width", &CodeExecutor::sprite_get_width, T::INT, { T::SPRITE }, 1, FunctionScope::LOCAL },
+	{ "sprite_get_height", &CodeExecutor::sprite_get_height, T::INT, { T::SPRITE }, 1, FunctionScope::LOCAL },
+	{ "sprite_get_frames", &CodeExecutor::sprite_get_frames, T::INT, { T::SPRITE }, 1, FunctionScope::LOCAL },
+	{ "sprite_set_animation_speed", &CodeExecutor::sprite_set_animation_speed, T::NUL, { T::FLOAT }, 1, FunctionScope::LOCAL },
+	{ "sprite_set_animation_loop", &CodeExecutor::sprite_set_animation_loop, T::NUL, { T::BOOL }, 1, FunctionScope::LOCAL },
+	{ "move_to_point", &CodeExecutor::move_to_point, T::NUL, { T::POINT, T::FLOAT }, 2, FunctionScope::LOCAL },
+	{ "move_instant", &CodeExecutor::move_instant, T::NUL, { T::POINT }, 1, FunctionScope::LOCAL },
+	{ "move_to_direction", &CodeExecutor::move_to_direction, T::NUL, { T::FLOAT, T::FLOAT }, 2, FunctionScope::LOCAL },
+	{ "distance_to_point", &CodeExecutor::distance_to_point, T::FLOAT, { T::POINT }, 1, FunctionScope::LOCAL },
+	{ "distance_between_point", &CodeExecutor::distance_between_point, T::FLOAT, { T::POINT, T::POINT }, 2, FunctionScope::PURE },
+	{ "distance_to_instance", &CodeExecutor::distance_to_instance, T::FLOAT, { T::INSTANCE }, 1, FunctionScope::GLOBAL },
+	{ "move_forward", &CodeExecutor::move_forward, T::NUL, { T::FLOAT }, 1, FunctionScope::LOCAL },
+	{ "direction_to_point", &CodeExecutor::direction_to_point, T::FLOAT, { T::POINT }, 1, FunctionScope::LOCAL },
+	{ "direction_between_point", &CodeExecutor::direction_between_point, T::FLOAT, { T::POINT, T::POINT }, 2, FunctionScope::PURE },
+	{ "direction_to_instance", &CodeExecutor::direction_to_instance, T::FLOAT, { T::INSTANCE }, 1, FunctionScope::GLOBAL },
+	{ "draw_sprite", &CodeExecutor::draw_sprite, T::NUL, { T::SPRITE, T::FLOAT, T::FLOAT, T::FLOAT }, 4, FunctionScope::GLOBAL },
+	{ "draw_sprite_ex", &CodeExecutor::draw_sprite_ex, T::NUL, { T::SPRITE, T::FLOAT, T::FLOAT, T::FLOAT, T::FLOAT, T::FLOAT, T::FLOAT, T::FLOAT, T::FLOAT, T::FLOAT }, 10, FunctionScope::GLOBAL },
+	{ "draw_texture", &CodeExecutor::draw_texture, T::NUL, { T::TEXTURE, T::FLOAT, T::FLOAT }, 3, FunctionScope::GLOBAL },
+	{ "draw_texture_ex", &CodeExecutor::draw_texture_ex, T::NUL, { T::TEXTURE, T::FLOAT, T::FLOAT, T::FLOAT, T::FLOAT, T::FLOAT, T::FLOAT }, 7, FunctionScope::GLOBAL },
+	{ "draw_sprite_self", &CodeExecutor::draw_sprite_self, T::NUL, {}, 0, FunctionScope::GLOBAL },
+	{ "draw_shape_rectangle", &CodeExecutor::draw_shape_rectangle, T::NUL, { T::FLOAT, T::FLOAT, T::FLOAT, T::FLOAT, T::COLOR }, 5, FunctionScope::GLOBAL },
+	{ "draw_shape_rectangle_r", &CodeExecutor::draw_shape_rectangle_r, T::NUL, { T::RECT, T::COLOR }, 2, FunctionScope::GLOBAL },
+	{ "draw_shape_rectangle_filled", &CodeExecutor::draw_shape_rectangle_filled, T::NUL, { T::FLOAT, T::FLOAT, T::FLOAT, T::FLOAT, T::COLOR }, 5, FunctionScope::GLOBAL },
+	{ "draw_shape_rectangle_filled_r", &CodeExecutor::draw_shape_rectangle_filled_r, T::NUL, { T::RECT, T::COLOR }, 2, FunctionScope::GLOBAL },
+	{ "draw_shape_circle", &CodeExecutor::draw_shape_circle, T::NUL, { T::FLOAT, T::FLOAT, T::FLOAT, T::COLOR }, 4, FunctionScope::GLOBAL },
+	{ "draw_shape_circle_p", &CodeExecutor::draw_shape_circle_p, T::NUL, { T::POINT, T::FLOAT, T::COLOR }, 3, FunctionScope::GLOBAL },
+	{ "draw_shape_circle_filled", &CodeExecutor::draw_shape_circle_filled, T::NUL, { T::FLOAT, T::FLOAT, T::FLOAT, T::COLOR }, 4, FunctionScope::GLOBAL },
+	{ "draw_shape_circle_filled_p", &CodeExecutor::draw_shape_circle_filled_p, T::NUL, { T::POINT, T::FLOAT, T::COLOR }, 3, FunctionScope::GLOBAL },
+	{ "math_min_i", &CodeExecutor::math_min_i, T::INT, { T::INT, T::INT }, 2, FunctionScope::PURE },
+	{ "math_max_i", &CodeExecutor::math_max_i, T::INT, { T::INT, T::INT }, 2, FunctionScope::PURE },
+	{ "math_min", &CodeExecutor::math_min, T::FLOAT, { T::FLOAT, T::FLOAT }, 2, FunctionScope::PURE },
+	{ "math_max", &CodeExecutor::math_max, T::FLOAT, { T::FLOAT, T::FLOAT }, 2, FunctionScope::PURE },
+	{ "global_get_mouse", &CodeExecutor::global_get_mouse, T::POINT, {}, 0, FunctionScope::LOCAL },
+	{ "set_self_sprite", &CodeExecutor::set_self_sprite, T::NUL, { T::SPRITE }, 1, FunctionScope::LOCAL },
+	{ "get_pos_x", &CodeExecutor::get_pos_x, T::FLOAT, {}, 0, FunctionScope::LOCAL },
+	{ "get_pos_y", &CodeExecutor::get_pos_y, T::FLOAT, {}, 0, FunctionScope::LOCAL },
+	{ "sound_play", &CodeExecutor::sound_play, T::NUL, { T::SOUND }, 1, FunctionScope::GLOBAL },
+	{ "music_play", &CodeExecutor::music_play, T::NUL, { T::MUSIC }, 1, FunctionScope::GLOBAL },
+	{ "sprite_next_frame", &CodeExecutor::sprite_next_frame, T::NUL, {}, 0, FunctionScope::LOCAL },
+	{ "sprite_prev_frame", &CodeExecutor::sprite_prev_frame, T::NUL, {}, 0, FunctionScope::LOCAL },
+	{ "sprite_set_frame", &CodeExecutor::sprite_set_frame, T::NUL, { T::INT }, 1, FunctionScope::LOCAL },
+	{ "code_do_nothing", &CodeExecutor::code_do_nothing, T::NUL, {}, 0, FunctionScope::LOCAL },
+	{ "set_body_type", &CodeExecutor::set_body_type, T::NUL, { T::STRING, T::FLOAT }, 2, FunctionScope::LOCAL },
+	{ "instance_set_tag", &CodeExecutor::instance_set_tag, T::NUL, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "collision_get_collider", &CodeExecutor::collision_get_collider, T::INSTANCE, {}, 0, FunctionScope::GLOBAL },
+	{ "collision_get_collider_tag", &CodeExecutor::collision_get_collider_tag, T::STRING, {}, 0, FunctionScope::GLOBAL },
+	{ "collision_get_collider_name", &CodeExecutor::collision_get_collider_name, T::STRING, {}, 0, FunctionScope::GLOBAL },
+	{ "collision_get_collider_id", &CodeExecutor::collision_get_collider_id, T::INT, {}, 0, FunctionScope::GLOBAL },
+	{ "get_random", &CodeExecutor::get_random, T::INT, { T::INT }, 1, FunctionScope::GLOBAL },
+	{ "get_random_range", &CodeExecutor::get_random_range, T::INT, { T::INT, T::INT }, 2, FunctionScope::GLOBAL },
+	{ "scene_change_transmission", &CodeExecutor::scene_change_transmission, T::NUL, { T::STRING, T::STRING }, 2, FunctionScope::GLOBAL },
+	{ "scene_change", &CodeExecutor::scene_change, T::NUL, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "get_direction_of", &CodeExecutor::get_direction_of, T::FLOAT, { T::INSTANCE }, 1, FunctionScope::GLOBAL },
+	{ "instance_spawn", &CodeExecutor::instance_spawn, T::INSTANCE, { T::STRING, T::FLOAT, T::FLOAT }, 3, FunctionScope::GLOBAL },
+	{ "instance_spawn_on_point", &CodeExecutor::instance_spawn_on_point, T::INSTANCE, { T::STRING, T::POINT }, 2, FunctionScope::GLOBAL },
+	{ "instance_create", &CodeExecutor::instance_create, T::NUL, { T::STRING, T::FLOAT, T::FLOAT }, 3, FunctionScope::GLOBAL },
+	{ "set_direction_for_target", &CodeExecutor::set_direction_for_target, T::NUL, { T::INSTANCE, T::FLOAT }, 2, FunctionScope::GLOBAL },
+	{ "set_direction", &CodeExecutor::set_direction, T::NUL, { T::FLOAT }, 1, FunctionScope::LOCAL },
+	{ "convert_int_to_float", &CodeExecutor::convert_int_to_float, T::FLOAT, { T::INT }, 1, FunctionScope::PURE },
+	{ "convert_float_to_int", &CodeExecutor::convert_float_to_int, T::INT, { T::FLOAT }, 1, FunctionScope::PURE },
+	{ "instance_delete_self", &CodeExecutor::instance_delete_self, T::NUL, {}, 0, FunctionScope::GLOBAL },
+	{ "get_direction", &CodeExecutor::get_direction, T::FLOAT, {}, 0, FunctionScope::LOCAL },
+	{ "math_add", &CodeExecutor::math_add, T::FLOAT, { T::FLOAT, T::FLOAT }, 2, FunctionScope::PURE },
+	{ "math_sub", &CodeExecutor::math_sub, T::FLOAT, { T::FLOAT, T::FLOAT }, 2, FunctionScope::PURE },
+	{ "math_mul", &CodeExecutor::math_mul, T::FLOAT, { T::FLOAT, T::FLOAT }, 2, FunctionScope::PURE },
+	{ "math_div", &CodeExecutor::math_div, T::FLOAT, { T::FLOAT, T::FLOAT }, 2, FunctionScope::PURE },
+	{ "get_point_x", &CodeExecutor::get_point_x, T::FLOAT, { T::POINT }, 1, FunctionScope::PURE },
+	{ "get_point_y", &CodeExecutor::get_point_y, T::FLOAT, { T::POINT }, 1, FunctionScope::PURE },
+	{ "collision_push_other", &CodeExecutor::collision_push_other, T::NUL, { T::BOOL }, 1, FunctionScope::GLOBAL },
+	{ "mouse_is_pressed", &CodeExecutor::mouse_is_pressed, T::BOOL, { T::INT }, 1, FunctionScope::LOCAL },
+	{ "get_delta_time", &CodeExecutor::get_delta_time, T::FLOAT, {}, 0, FunctionScope::LOCAL },
+	{ "code_break", &CodeExecutor::code_break, T::NUL, {}, 0, FunctionScope::LOCAL },
+	{ "draw_text", &CodeExecutor::draw_text, T::NUL, { T::FONT, T::INT, T::INT, T::STRING, T::COLOR }, 5, FunctionScope::GLOBAL },
+	{ "convert_int_to_string", &CodeExecutor::convert_int_to_string, T::STRING, { T::INT }, 1, FunctionScope::PURE },
+	{ "convert_float_to_string", &CodeExecutor::convert_float_to_string, T::STRING, { T::FLOAT }, 1, FunctionScope::PURE },
+	{ "sprite_set_scale", &CodeExecutor::sprite_set_scale, T::NUL, { T::POINT }, 1, FunctionScope::LOCAL },
+	{ "draw_text_in_frame", &CodeExecutor::draw_text_in_frame, T::NUL, { T::FONT, T::STRING, T::FLOAT, T::FLOAT, T::COLOR, T::COLOR, T::COLOR }, 7, FunctionScope::GLOBAL },
+	{ "gui_change_visibility", &CodeExecutor::gui_change_visibility, T::NUL, { T::STRING, T::BOOL }, 2, FunctionScope::GLOBAL },
+	{ "gui_change_enabled", &CodeExecutor::gui_change_enabled, T::NUL, { T::STRING, T::BOOL }, 2, FunctionScope::GLOBAL },
+	{ "code_execute_trigger", &CodeExecutor::code_execute_trigger, T::NUL, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "code_wait", &CodeExecutor::code_wait, T::NUL, { T::INT }, 1, FunctionScope::GLOBAL },
+	{ "game_exit", &CodeExecutor::game_exit, T::NUL, {}, 0, FunctionScope::GLOBAL },
+	{ "get_instance_position", &CodeExecutor::get_instance_position, T::POINT, { T::INSTANCE }, 1, FunctionScope::GLOBAL },
+	{ "get_instance_position_x", &CodeExecutor::get_instance_position_x, T::FLOAT, { T::INSTANCE }, 1, FunctionScope::GLOBAL },
+	{ "get_instance_position_y", &CodeExecutor::get_instance_position_y, T::FLOAT, { T::INSTANCE }, 1, FunctionScope::GLOBAL },
+	{ "instance_create_point", &CodeExecutor::instance_create_point, T::NUL, { T::STRING, T::POINT }, 2, FunctionScope::GLOBAL },
+	{ "instance_delete_other", &CodeExecutor::instance_delete_other, T::NUL, { T::INSTANCE }, 1, FunctionScope::GLOBAL },
+	{ "instance_find_by_tag", &CodeExecutor::instance_find_by_tag, T::INSTANCE, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "instance_exists", &CodeExecutor::instance_exists, T::BOOL, { T::INSTANCE }, 1, FunctionScope::GLOBAL },
+	{ "instance_alive", &CodeExecutor::instance_alive, T::BOOL, { T::INSTANCE }, 1, FunctionScope::GLOBAL },
+	{ "scene_get_width", &CodeExecutor::scene_get_width, T::INT, {}, 0, FunctionScope::GLOBAL },
+	{ "scene_get_height", &CodeExecutor::scene_get_height, T::INT, {}, 0, FunctionScope::GLOBAL },
+	{ "collision_bounce", &CodeExecutor::collision_bounce, T::NUL, {}, 0, FunctionScope::GLOBAL },
+	{ "gui_get_slider_value", &CodeExecutor::gui_get_slider_value, T::INT, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "gui_get_check_box_value", &CodeExecutor::gui_get_check_box_value, T::BOOL, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "gui_get_drop_down_selected_index", &CodeExecutor::gui_get_drop_down_selected_index, T::INT, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "gui_get_drop_down_selected_value", &CodeExecutor::gui_get_drop_down_selected_value, T::INT, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "gui_set_slider_value", &CodeExecutor::gui_set_slider_value, T::NUL, { T::INT, T::STRING }, 2, FunctionScope::GLOBAL },
+	{ "gui_set_slider_value_min", &CodeExecutor::gui_set_slider_value_min, T::NUL, { T::INT, T::STRING }, 2, FunctionScope::GLOBAL },
+	{ "gui_set_slider_value_max", &CodeExecutor::gui_set_slider_value_max, T::NUL, { T::INT, T::STRING }, 2, FunctionScope::GLOBAL },
+	{ "gui_set_slider_value_step", &CodeExecutor::gui_set_slider_value_step, T::NUL, { T::INT, T::STRING }, 2, FunctionScope::GLOBAL },
+	{ "gui_set_check_box_value", &CodeExecutor::gui_set_check_box_value, T::NUL, { T::BOOL, T::STRING }, 2, FunctionScope::GLOBAL },
+	{ "gui_set_drop_down_selected_index", &CodeExecutor::gui_set_drop_down_selected_index, T::NUL, { T::INT, T::STRING }, 2, FunctionScope::GLOBAL },
+	{ "system_set_video_mode", &CodeExecutor::system_set_video_mode, T::NUL, { T::BOOL }, 1, FunctionScope::GLOBAL },
+	{ "system_set_video_resolution", &CodeExecutor::system_set_video_resolution, T::NUL, { T::INT, T::INT }, 2, FunctionScope::GLOBAL },
+	{ "system_set_video_resolution_from_string", &CodeExecutor::system_set_video_resolution_from_string, T::NUL, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "system_set_video_bloom_factor", &CodeExecutor::system_set_video_bloom_factor, T::NUL, { T::INT }, 1, FunctionScope::GLOBAL },
+	{ "system_set_audio_master", &CodeExecutor::system_set_audio_master, T::NUL, { T::BOOL }, 1, FunctionScope::GLOBAL },
+	{ "system_set_audio_music", &CodeExecutor::system_set_audio_music, T::NUL, { T::BOOL }, 1, FunctionScope::GLOBAL },
+	{ "system_set_audio_sound", &CodeExecutor::system_set_audio_sound, T::NUL, { T::BOOL }, 1, FunctionScope::GLOBAL },
+	{ "system_set_audio_music_level", &CodeExecutor::system_set_audio_music_level, T::NUL, { T::INT }, 1, FunctionScope::GLOBAL },
+	{ "system_set_audio_sound_level", &CodeExecutor::system_set_audio_sound_level, T::NUL, { T::INT }, 1, FunctionScope::GLOBAL },
+	{ "system_settings_data_get_int", &CodeExecutor::system_settings_data_get_int, T::INT, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "system_settings_data_get_string", &CodeExecutor::system_settings_data_get_string, T::STRING, { T::STRING }, 1, FunctionScope::GLOBAL },
+	{ "string_get_length", &CodeExecutor::string_get_length, T::INT, { T::STRING }, 1, FunctionScope::PURE },
+	{ "string_join", &CodeExecutor::string_join, T::STRING, { T::STRING, T::STRING }, 2, FunctionScope::PURE },
+	{ "string_replace", &CodeExecutor::string_replace, T::STRING, { T::STRING, T::STRING, T::STRING }, 3, FunctionScope::PURE },
+	{ "convert_int_to_bool", &CodeExecutor::convert_int_to_bool, T::BOOL, { T::INT }, 1, FunctionScope::PURE },
+	{ "list_size", &CodeExecutor::list_size, T::INT, { T::LIST }, 1, FunctionScope::LOCAL },
+	{ "list_clear", &CodeExecutor::list_clear, T::NUL, { T::LIST }, 1, FunctionScope::LOCAL },
+	{ "list_sort", &CodeExecutor::list_sort, T::NUL, { T::LIST }, 1, FunctionScope::LOCAL },
+	{ "list_push_int", &CodeExecutor::list_push_int, T::NUL, { T::LIST, T::INT }, 2, FunctionScope::LOCAL },
+	{ "list_pop_int", &CodeExecutor::list_pop_int, T::INT, { T::LIST }, 1, FunctionScope::LOCAL },
+	{ "list_get_int", &CodeExecutor::list_get_int, T::INT, { T::LIST, T::INT }, 2, FunctionScope::LOCAL },
+	{ "list_set_int", &CodeExecutor::list_set_int, T::NUL, { T::LIST, T::INT, T::INT }, 3, FunctionScope::LOCAL },
+	{ "list_find_int", &CodeExecutor::list_find_int, T::INT, { T::LIST, T::INT }, 2, FunctionScope::LOCAL },
+	{ "list_push_float", &CodeExecutor::list_push_float, T::NUL, { T::LIST, T::FLOAT }, 2, FunctionScope::LOCAL },
+	{ "list_pop_float", &CodeExecutor::list_pop_float, T::FLOAT, { T::LIST }, 1, FunctionScope::LOCAL },
+	{ "list_get_float", &CodeExecutor::list_get_float, T::FLOAT, { T::LIST, T::INT }, 2, FunctionScope::LOCAL },
+	{ "list_set_float", &CodeExecutor::list_set_float, T::NUL, { T::LIST, T::INT, T::FLOAT }, 3, FunctionScope::LOCAL },
+	{ "list_find_float", &CodeExecutor::list_find_float, T::INT, { T::LIST, T::FLOAT }, 2, FunctionScope::LOCAL },
+	{ "list_push_point", &CodeExecutor::list_push_point, T::NUL, { T::LIST, T::POINT }, 2, FunctionScope::LOCAL },
+	{ "list_pop_point", &CodeExecutor::list_pop_point, T::POINT, { T::LIST }, 1, FunctionScope::LOCAL },
+	{ "list_get_point", &CodeExecutor::list_get_point, T::POINT, { T::LIST, T::INT }, 2, FunctionScope::LOCAL },
+	{ "list_set_point", &CodeExecutor::list_set_point, T::NUL, { T::LIST, T::INT, T::POINT }, 3, FunctionScope::LOCAL },
+	{ "list_find_point", &CodeExecutor::list_find_point, T::INT, { T::LIST, T::POINT }, 2, FunctionScope::LOCAL },
+	{ "list_push_string", &CodeExecutor::list_push_string, T::NUL, { T::LIST, T::STRING }, 2, FunctionScope::LOCAL },
+	{ "list_pop_string", &CodeExecutor::list_pop_string, T::STRING, { T::LIST }, 1, FunctionScope::LOCAL },
+	{ "list_get_string", &CodeExecutor::list_get_string, T::STRING, { T::LIST, T::INT }, 2, FunctionScope::LOCAL },
+	{ "list_set_string", &CodeExecutor::list_set_string, T::NUL, { T::LIST, T::INT, T::STRING }, 3, FunctionScope::LOCAL },
+	{ "list_find_string", &CodeExecutor::list_find_string, T::INT, { T::LIST, T::STRING }, 2, FunctionScope::LOCAL },
+	{ "instance_spawn_id", &CodeExecutor::instance_spawn_id, T::INSTANCE, { T::OBJECT, T::FLOAT, T::FLOAT }, 3, FunctionScope::GLOBAL },
+	{ "instance_spawn_on_point_id", &CodeExecutor::instance_spawn_on_point_id, T::INSTANCE, { T::OBJECT, T::POINT }, 2, FunctionScope::GLOBAL },
+	{ "instance_create_id", &CodeExecutor::instance_create_id, T::NUL, { T::OBJECT, T::FLOAT, T::FLOAT }, 3, FunctionScope::GLOBAL },
+	{ "instance_create_point_id", &CodeExecutor::instance_create_point_id, T::NUL, { T::OBJECT, T::POINT }, 2, FunctionScope::GLOBAL },
+};
+#undef T
+constexpr size_t CodeExecutor::BuiltinsCount = std::size(CodeExecutor::Builtins);
+
 void CodeExecutor::MapFunctions()
 {
 	FunctionsMap.clear();
-	FunctionsMap["new_point"] = &CodeExecutor::new_point;
-	FunctionsMap["new_direction"] = &CodeExecutor::new_direction;
-	FunctionsMap["new_rectangle"] = &CodeExecutor::new_rectangle;
-	FunctionsMap["new_rectangle_f"] = &CodeExecutor::new_rectangle_f;
-	FunctionsMap["get_sprite"] = &CodeExecutor::get_sprite;
-	FunctionsMap["get_texture"] = &CodeExecutor::get_texture;
-	FunctionsMap["get_music"] = &CodeExecutor::get_music;
-	FunctionsMap["get_sound"] = &CodeExecutor::get_sound;
-	FunctionsMap["get_font"] = &CodeExecutor::get_font;
-	FunctionsMap["sprite_get_width"] = &CodeExecutor::sprite_get_width;
-	FunctionsMap["sprite_get_height"] = &CodeExecutor::sprite_get_height;
-	FunctionsMap["sprite_get_frames"] = &CodeExecutor::sprite_get_frames;
-	FunctionsMap["sprite_set_animation_speed"] = &CodeExecutor::sprite_set_animation_speed;
-	FunctionsMap["sprite_set_animation_loop"] = &CodeExecutor::sprite_set_animation_loop;
-	FunctionsMap["move_to_point"] = &CodeExecutor::move_to_point;
-	FunctionsMap["move_instant"] = &CodeExecutor::move_instant;
-	FunctionsMap["move_to_direction"] = &CodeExecutor::move_to_direction;
-	FunctionsMap["distance_to_point"] = &CodeExecutor::distance_to_point;
-	FunctionsMap["distance_between_point"] = &CodeExecutor::distance_between_point;
-	FunctionsMap["distance_to_instance"] = &CodeExecutor::distance_to_instance;
-	FunctionsMap["move_forward"] = &CodeExecutor::move_forward;
-	FunctionsMap["direction_to_point"] = &CodeExecutor::direction_to_point;
-	FunctionsMap["direction_between_point"] = &CodeExecutor::direction_between_point;
-	FunctionsMap["direction_to_instance"] = &CodeExecutor::direction_to_instance;
-	FunctionsMap["draw_sprite"] = &CodeExecutor::draw_sprite;
-	FunctionsMap["draw_sprite_ex"] = &CodeExecutor::draw_sprite_ex;
-	FunctionsMap["draw_texture"] = &CodeExecutor::draw_texture;
-	FunctionsMap["draw_texture_ex"] = &CodeExecutor::draw_texture_ex;
-	FunctionsMap["draw_sprite_self"] = &CodeExecutor::draw_sprite_self;
-	FunctionsMap["draw_shape_rectangle"] = &CodeExecutor::draw_shape_rectangle;
-	FunctionsMap["draw_shape_rectangle_r"] = &CodeExecutor::draw_shape_rectangle_r;
-	FunctionsMap["draw_shape_rectangle_filled"] = &CodeExecutor::draw_shape_rectangle_filled;
-	FunctionsMap["draw_shape_rectangle_filled_r"] = &CodeExecutor::draw_shape_rectangle_filled_r;
-	FunctionsMap["draw_shape_circle"] = &CodeExecutor::draw_shape_circle;
-	FunctionsMap["draw_shape_circle_p"] = &CodeExecutor::draw_shape_circle_p;
-	FunctionsMap["draw_shape_circle_filled"] = &CodeExecutor::draw_shape_circle_filled;
-	FunctionsMap["draw_shape_circle_filled_p"] = &CodeExecutor::draw_shape_circle_filled_p;
-	FunctionsMap["math_min_i"] = &CodeExecutor::math_min_i;
-	FunctionsMap["math_max_i"] = &CodeExecutor::math_max_i;
-	FunctionsMap["math_min"] = &CodeExecutor::math_min;
-	FunctionsMap["math_max"] = &CodeExecutor::math_max;
-	FunctionsMap["global_get_mouse"] = &CodeExecutor::global_get_mouse;
-	FunctionsMap["set_self_sprite"] = &CodeExecutor::set_self_sprite;
-	FunctionsMap["get_pos_x"] = &CodeExecutor::get_pos_x;
-	FunctionsMap["get_pos_y"] = &CodeExecutor::get_pos_y;
-	FunctionsMap["sound_play"] = &CodeExecutor::sound_play;
-	FunctionsMap["music_play"] = &CodeExecutor::music_play;
-	FunctionsMap["sprite_next_frame"] = &CodeExecutor::sprite_next_frame;
-	FunctionsMap["sprite_prev_frame"] = &CodeExecutor::sprite_prev_frame;
-	FunctionsMap["sprite_set_frame"] = &CodeExecutor::sprite_set_frame;
-	FunctionsMap["code_do_nothing"] = &CodeExecutor::code_do_nothing;
-	FunctionsMap["set_body_type"] = &CodeExecutor::set_body_type;
-	FunctionsMap["instance_set_tag"] = &CodeExecutor::instance_set_tag;
-	FunctionsMap["collision_get_collider"] = &CodeExecutor::collision_get_collider;
-	FunctionsMap["collision_get_collider_tag"] = &CodeExecutor::collision_get_collider_tag;
-	FunctionsMap["collision_get_collider_name"] = &CodeExecutor::collision_get_collider_name;
-	FunctionsMap["collision_get_collider_id"] = &CodeExecutor::collision_get_collider_id;
-	FunctionsMap["get_random"] = &CodeExecutor::get_random;
-	FunctionsMap["get_random_range"] = &CodeExecutor::get_random_range;
-	FunctionsMap["scene_change_transmission"] = &CodeExecutor::scene_change_transmission;
-	FunctionsMap["scene_change"] = &CodeExecutor::scene_change;
-	FunctionsMap["get_direction_of"] = &CodeExecutor::get_direction_of;
-	FunctionsMap["instance_spawn"] = &CodeExecutor::instance_spawn;
-	FunctionsMap["instance_spawn_on_point"] = &CodeExecutor::instance_spawn_on_point;
-	FunctionsMap["instance_create"] = &CodeExecutor::instance_create;
-	FunctionsMap["set_direction_for_target"] = &CodeExecutor::set_direction_for_target;
-	FunctionsMap["set_direction"] = &CodeExecutor::set_direction;
-	FunctionsMap["convert_int_to_float"] = &CodeExecutor::convert_int_to_float;
-	FunctionsMap["convert_float_to_int"] = &CodeExecutor::convert_float_to_int;
-	FunctionsMap["instance_delete_self"] = &CodeExecutor::instance_delete_self;
-	FunctionsMap["get_direction"] = &CodeExecutor::get_direction;
-	FunctionsMap["math_add"] = &CodeExecutor::math_add;
-	FunctionsMap["math_sub"] = &CodeExecutor::math_sub;
-	FunctionsMap["math_mul"] = &CodeExecutor::math_mul;
-	FunctionsMap["math_div"] = &CodeExecutor::math_div;
-	FunctionsMap["get_point_x"] = &CodeExecutor::get_point_x;
-	FunctionsMap["get_point_y"] = &CodeExecutor::get_point_y;
-	FunctionsMap["collision_push_other"] = &CodeExecutor::collision_push_other;
-	FunctionsMap["mouse_is_pressed"] = &CodeExecutor::mouse_is_pressed;
-	FunctionsMap["get_delta_time"] = &CodeExecutor::get_delta_time;
-	FunctionsMap["code_break"] = &CodeExecutor::code_break;
-	FunctionsMap["draw_text"] = &CodeExecutor::draw_text;
-	FunctionsMap["convert_int_to_string"] = &CodeExecutor::convert_int_to_string;
-	FunctionsMap["convert_float_to_string"] = &CodeExecutor::convert_float_to_string;
-	FunctionsMap["sprite_set_scale"] = &CodeExecutor::sprite_set_scale;
-	FunctionsMap["draw_text_in_frame"] = &CodeExecutor::draw_text_in_frame;
-	FunctionsMap["gui_change_visibility"] = &CodeExecutor::gui_change_visibility;
-	FunctionsMap["gui_change_enabled"] = &CodeExecutor::gui_change_enabled;
-	FunctionsMap["code_execute_trigger"] = &CodeExecutor::code_execute_trigger;
-	FunctionsMap["code_wait"] = &CodeExecutor::code_wait;
-	FunctionsMap["game_exit"] = &CodeExecutor::game_exit;
-	FunctionsMap["get_instance_position"] = &CodeExecutor::get_instance_position;
-	FunctionsMap["get_instance_position_x"] = &CodeExecutor::get_instance_position_x;
-	FunctionsMap["get_instance_position_y"] = &CodeExecutor::get_instance_position_y;
-	FunctionsMap["instance_create_point"] = &CodeExecutor::instance_create_point;
-	FunctionsMap["instance_delete_other"] = &CodeExecutor::instance_delete_other;
-	FunctionsMap["instance_find_by_tag"] = &CodeExecutor::instance_find_by_tag;
-	FunctionsMap["instance_exists"] = &CodeExecutor::instance_exists;
-	FunctionsMap["instance_alive"] = &CodeExecutor::instance_alive;
-	FunctionsMap["scene_get_width"] = &CodeExecutor::scene_get_width;
-	FunctionsMap["scene_get_height"] = &CodeExecutor::scene_get_height;
-	FunctionsMap["collision_bounce"] = &CodeExecutor::collision_bounce;
-	FunctionsMap["gui_get_slider_value"] = &CodeExecutor::gui_get_slider_value;
-	FunctionsMap["gui_get_check_box_value"] = &CodeExecutor::gui_get_check_box_value;
-	FunctionsMap["gui_get_drop_down_selected_index"] = &CodeExecutor::gui_get_drop_down_selected_index;
-	FunctionsMap["gui_get_drop_down_selected_value"] = &CodeExecutor::gui_get_drop_down_selected_value;
-	FunctionsMap["gui_set_slider_value"] = &CodeExecutor::gui_set_slider_value;
-	FunctionsMap["gui_set_slider_value_min"] = &CodeExecutor::gui_set_slider_value_min;
-	FunctionsMap["gui_set_slider_value_max"] = &CodeExecutor::gui_set_slider_value_max;
-	FunctionsMap["gui_set_slider_value_step"] = &CodeExecutor::gui_set_slider_value_step;
-	FunctionsMap["gui_set_check_box_value"] = &CodeExecutor::gui_set_check_box_value;
-	FunctionsMap["gui_set_drop_down_selected_index"] = &CodeExecutor::gui_set_drop_down_selected_index;
-	FunctionsMap["system_set_video_mode"] = &CodeExecutor::system_set_video_mode;
-	FunctionsMap["system_set_video_resolution"] = &CodeExecutor::system_set_video_resolution;
-	FunctionsMap["system_set_video_resolution_from_string"] = &CodeExecutor::system_set_video_resolution_from_string;
-	FunctionsMap["system_set_video_bloom_factor"] = &CodeExecutor::system_set_video_bloom_factor;
-	FunctionsMap["system_set_audio_master"] = &CodeExecutor::system_set_audio_master;
-	FunctionsMap["system_set_audio_music"] = &CodeExecutor::system_set_audio_music;
-	FunctionsMap["system_set_audio_sound"] = &CodeExecutor::system_set_audio_sound;
-	FunctionsMap["system_set_audio_music_level"] = &CodeExecutor::system_set_audio_music_level;
-	FunctionsMap["system_set_audio_sound_level"] = &CodeExecutor::system_set_audio_sound_level;
-	FunctionsMap["system_settings_data_get_int"] = &CodeExecutor::system_settings_data_get_int;
-	FunctionsMap["system_settings_data_get_string"] = &CodeExecutor::system_settings_data_get_string;
-	FunctionsMap["string_get_length"] = &CodeExecutor::string_get_length;
-	FunctionsMap["string_join"] = &CodeExecutor::string_join;
-	FunctionsMap["string_replace"] = &CodeExecutor::string_replace;
-	FunctionsMap["convert_int_to_bool"] = &CodeExecutor::convert_int_to_bool;
+	for (const BuiltinFunction& function : Builtins) {
+		FunctionsMap[function.Name] = function.Function;
+	}
 }
 //end of file
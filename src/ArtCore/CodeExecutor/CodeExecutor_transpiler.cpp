@@ -0,0 +1,391 @@
+// ReSharper disable CppDefaultCaseNotHandledInSwitchStatement
+// ReSharper disable CppIncompleteSwitchStatement
+// ReSharper disable CppClangTidyClangDiagnosticSwitch
+#include "CodeExecutor.h"
+
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include "ArtCore/Gui/Console.h"
+
+#define OPCODE Instruction::Opcode
+
+namespace
+{
+	typedef OperandStack::SlotType SlotType;
+
+	// accessor of variable in instance variables block
+	std::string VariableAccess(const std::string& owner, const int type, const int index)
+	{
+		return owner + "->Variables.Get<ArtCode::" + ArtCode::variable_type_toString(static_cast<ArtCode::variable_type>(type)) + ">(" + std::to_string(index) + ")";
+	}
+
+	// lists are pushed by pointer, instances are resolved from handle, other values by copy
+	std::string VariableValue(const std::string& owner, const int type, const int index)
+	{
+		const std::string value = VariableAccess(owner, type, index);
+		if (type == ArtCode::variable_type::LIST) return "&" + value;
+		if (type == ArtCode::variable_type::INSTANCE) return "CodeExecutor::h_instance(" + value + ")";
+		return value;
+	}
+
+	// h_operation_* function of type
+	std::string OperationName(const int type)
+	{
+		std::string name = ArtCode::variable_type_toString(static_cast<ArtCode::variable_type>(type));
+		for (char& c : name) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+		return "CodeExecutor::h_operation_" + name;
+	}
+
+	// suffix of OperandStack Push and Pop functions
+	std::string StackName(const SlotType type)
+	{
+		switch (type) {
+		case SlotType::INT:			return "Int";
+		case SlotType::FLOAT:		return "Float";
+		case SlotType::BOOL:		return "Bool";
+		case SlotType::INSTANCE:	return "Instance";
+		case SlotType::POINT:		return "Point";
+		case SlotType::RECT:		return "Rect";
+		case SlotType::COLOR:		return "Color";
+		case SlotType::STRING:		return "String";
+		case SlotType::LIST:		return "List";
+		}
+		return "";
+	}
+
+	std::string FloatLiteral(const float value)
+	{
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "%.9g", static_cast<double>(value));
+		std::string literal(buffer);
+		if (literal.find_first_of(".e") == std::string::npos) literal += ".0";
+		return literal + "f";
+	}
+
+	std::string StringLiteral(const std::string& value)
+	{
+		std::string literal = "std::string(\"";
+		for (const char c : value) {
+			const unsigned char u = static_cast<unsigned char>(c);
+			if (c == '"' || c == '\\') {
+				literal += '\\';
+				literal += c;
+			}
+			else if (u < 0x20 || u >= 0x7F) {
+				// octal escape have always 3 digits, next char can not be taken as part of it
+				char buffer[8];
+				std::snprintf(buffer, sizeof(buffer), "\\%03o", u);
+				literal += buffer;
+			}
+			else {
+				literal += c;
+			}
+		}
+		return literal + "\")";
+	}
+
+	// valid c++ name from definition and event
+	std::string Identifier(const std::string& name)
+	{
+		std::string identifier;
+		for (const char c : name) {
+			identifier += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+		}
+		return identifier;
+	}
+
+	// write one program as body of function, values are kept as c++ expressions
+	// and pushed on operand stack only when built-in function need them
+	class ProgramWriter final
+	{
+	public:
+		ProgramWriter(const Program& program, const std::vector<std::string>& functions_names, const std::vector<CodeExecutor::FunctionSignature>& functions_signature)
+			: _program(program), _functions_names(functions_names), _functions_signature(functions_signature)
+		{
+		}
+
+		// false if program can not run without interpreter
+		bool Write()
+		{
+			std::set<int> targets;
+			for (const Instruction& instruction : _program.Code) {
+				if (instruction.Op == OPCODE::IF || instruction.Op == OPCODE::ELSE) {
+					targets.insert(instruction.Operand);
+				}
+				if (instruction.Op == OPCODE::CALL && _functions_names[instruction.Operand] == "code_wait") {
+					// suspended script is continued from instruction, only interpreter can do it
+					return false;
+				}
+			}
+
+			size_t statement = 0;
+			for (int i = 0; i < _program.GetSize(); i++) {
+				const Instruction& instruction = _program.Code[i];
+				if (targets.contains(i)) {
+					_out << "L" << i << ":;\n";
+				}
+				// value of one statement is never used by next one
+				while (statement < _program.Statements.size() && _program.Statements[statement] <= i) {
+					_stack.clear();
+					statement++;
+				}
+				if (!WriteInstruction(instruction)) return false;
+			}
+			return true;
+		}
+
+		[[nodiscard]] std::string GetBody() const { return _out.str(); }
+
+	private:
+		struct Value
+		{
+			std::string Expression;
+			SlotType Type;
+			// value is already on operand stack
+			bool OnStack;
+		};
+		const Program& _program;
+		const std::vector<std::string>& _functions_names;
+		const std::vector<CodeExecutor::FunctionSignature>& _functions_signature;
+		std::vector<Value> _stack;
+		std::ostringstream _out;
+
+		void Line(const std::string& line)
+		{
+			_out << "\t" << line << "\n";
+		}
+
+		void Push(const std::string& expression, const SlotType type)
+		{
+			_stack.push_back({ expression, type, false });
+		}
+
+		// push every waiting value, order on operand stack is the same as in interpreter
+		void Materialize()
+		{
+			for (Value& value : _stack) {
+				if (value.OnStack) continue;
+				Line("context->Stack.Push" + StackName(value.Type) + "(" + value.Expression + ");");
+				value.OnStack = true;
+			}
+		}
+
+		// expression that give value from top of stack
+		std::string Pop(const SlotType type)
+		{
+			if (_stack.empty()) {
+				// null value, interpreter pop it too
+				return "context->Stack.Pop" + StackName(type) + "()";
+			}
+			const Value value = _stack.back();
+			_stack.pop_back();
+			if (value.OnStack) {
+				return "context->Stack.Pop" + StackName(type) + "()";
+			}
+			return value.Expression;
+		}
+
+		// break script if other is not instance of definition
+		void OtherCheck(const int definition)
+		{
+			Line("{");
+			Line("Instance* other = Core::GetCurrentScene()->CurrentCollisionInstance;");
+			Line("if (other == nullptr || other->GetInstanceDefinitionId() != " + std::to_string(definition) + ") { code->Break = true; return; }");
+		}
+
+		void Assign(const std::string& target, const int operation, const int type, const std::string& value)
+		{
+			static const std::string compound[4] = { " += ", " -= ", " *= ", " /= " };
+			if (type == ArtCode::variable_type::INSTANCE) {
+				Line(target + " = CodeExecutor::h_handle(" + OperationName(type) + "(" + std::to_string(operation) + ", CodeExecutor::h_instance(" + target + "), " + value + "));");
+			}
+			else if (operation == 4) {
+				Line(target + " = " + value + ";");
+			}
+			else if (operation < 4 && (type == ArtCode::variable_type::INT || type == ArtCode::variable_type::FLOAT)) {
+				Line(target + compound[operation] + value + ";");
+			}
+			else {
+				Line(target + " = " + OperationName(type) + "(" + std::to_string(operation) + ", " + target + ", " + value + ");");
+			}
+		}
+
+		bool WriteInstruction(const Instruction& instruction)
+		{
+			switch (instruction.Op) {
+			case OPCODE::PUSH_INT:
+				Push(std::to_string(instruction.Operand), SlotType::INT);
+				break;
+			case OPCODE::PUSH_FLOAT:
+				Push(FloatLiteral(_program.LiteralFloat[instruction.Operand]), SlotType::FLOAT);
+				break;
+			case OPCODE::PUSH_BOOL:
+				Push(instruction.Operand != 0 ? "true" : "false", SlotType::BOOL);
+				break;
+			case OPCODE::PUSH_INSTANCE:
+				Push("Core::GetCurrentScene()->GetInstanceById(" + std::to_string(instruction.Operand) + ")", SlotType::INSTANCE);
+				break;
+			case OPCODE::PUSH_POINT: {
+				const SDL_FPoint& point = _program.LiteralPoint[instruction.Operand];
+				Push("SDL_FPoint{ " + FloatLiteral(point.x) + ", " + FloatLiteral(point.y) + " }", SlotType::POINT);
+			}break;
+			case OPCODE::PUSH_RECT: {
+				const Rect& rect = _program.LiteralRect[instruction.Operand];
+				Push("Rect(" + FloatLiteral(rect.X) + ", " + FloatLiteral(rect.Y) + ", " + FloatLiteral(rect.W) + ", " + FloatLiteral(rect.H) + ")", SlotType::RECT);
+			}break;
+			case OPCODE::PUSH_COLOR: {
+				const SDL_Color& color = _program.LiteralColor[instruction.Operand];
+				Push("SDL_Color{ " + std::to_string(color.r) + ", " + std::to_string(color.g) + ", " + std::to_string(color.b) + ", " + std::to_string(color.a) + " }", SlotType::COLOR);
+			}break;
+			case OPCODE::PUSH_STRING:
+				Push(StringLiteral(_program.LiteralString[instruction.Operand]), SlotType::STRING);
+				break;
+
+			case OPCODE::PUSH_LOCAL:
+				Push(VariableValue("instance", instruction.A, instruction.B), CodeExecutor::h_slot_type(instruction.A));
+				break;
+
+			case OPCODE::PUSH_OTHER: {
+				// other can change in function, read it now
+				Materialize();
+				const SlotType type = CodeExecutor::h_slot_type(instruction.B);
+				OtherCheck(instruction.A);
+				Line("context->Stack.Push" + StackName(type) + "(" + VariableValue("other", instruction.B, instruction.C) + ");");
+				Line("}");
+				_stack.push_back({ "", type, true });
+			}break;
+
+			case OPCODE::CALL: {
+				const std::string& name = _functions_names[instruction.Operand];
+				if (name.empty()) return false;
+				Materialize();
+				Line("CodeExecutor::" + name + "(context, instance);");
+				Line("if (code->Break) return;");
+				_stack.resize(_stack.size() > instruction.B ? _stack.size() - instruction.B : 0);
+				if (const ArtCode::variable_type result = _functions_signature[instruction.Operand].Return; result != ArtCode::variable_type::NUL) {
+					_stack.push_back({ "", CodeExecutor::h_slot_type(result), true });
+				}
+			}break;
+
+			case OPCODE::SET:
+				Assign(VariableAccess("instance", instruction.B, instruction.C),
+					instruction.A, instruction.B, Pop(CodeExecutor::h_slot_type(instruction.B)));
+				break;
+
+			case OPCODE::SET_OTHER: {
+				const std::string value = Pop(CodeExecutor::h_slot_type(instruction.B));
+				OtherCheck(instruction.A);
+				Assign(VariableAccess("other", instruction.B, instruction.C),
+					instruction.Operand, instruction.B, value);
+				Line("}");
+			}break;
+
+			case OPCODE::IF: {
+				static const std::string operators[8] = { " || ", " && ", " < ", " > ", " >= ", " <= ", " != ", " == " };
+				Line("{");
+				if (instruction.B == Instruction::NO_OPERATOR) {
+					Line("const bool test = " + Pop(SlotType::BOOL) + ";");
+				}
+				else {
+					// right value is on top
+					const SlotType type = CodeExecutor::h_slot_type(instruction.A);
+					Line("const auto right = " + Pop(type) + ";");
+					Line("const auto left = " + Pop(type) + ";");
+					Line("const bool test = left" + operators[instruction.B] + "right;");
+				}
+				Line("context->IfTestResult.Add(test);");
+				Line("if (!test) goto L" + std::to_string(instruction.Operand) + ";");
+				Line("}");
+			}break;
+
+			case OPCODE::ELSE:
+				Line("if (context->IfTestResult.Get()) goto L" + std::to_string(instruction.Operand) + ";");
+				break;
+
+			case OPCODE::BREAK:
+				Line("code->Break = true;");
+				Line("return;");
+				break;
+
+			case OPCODE::END:
+				Line("return;");
+				break;
+
+			default:
+				// superinstructions are not expected, program is decoded again
+				return false;
+			}
+			return true;
+		}
+	};
+}
+
+bool CodeExecutor::Transpile(const std::string& file) const
+{
+	const std::vector<std::string> functions_names = GetFunctionsNames();
+
+	std::ostringstream functions;
+	std::ostringstream registry;
+	int transpiled = 0;
+	int skipped = 0;
+	for (const InstanceDefinition& definition : _instance_definitions) {
+		for (int event = Event::EventInvalid + 1; event < Event::EventEND; event++) {
+			if (!definition.HaveEvent(static_cast<Event>(event))) continue;
+			const InstanceDefinition::EventData& event_data = definition._events[event];
+			const std::string name = definition.Name + "::" + Event_toString(static_cast<Event>(event));
+
+			// loaded program is already fused, start from bytecode
+			Program program;
+			ProgramWriter writer(program, functions_names, FunctionsSignature);
+			if (!program.Decode(event_data.data, event_data.size, name) || !writer.Write()) {
+				Console::WriteLine("Transpile: '" + name + "' stay interpreted");
+				skipped++;
+				continue;
+			}
+
+			const std::string function = "f" + std::to_string(transpiled) + "_" + Identifier(definition.Name) + "_" + Identifier(Event_toString(static_cast<Event>(event)));
+			functions << "\t// " << name << "\n";
+			functions << "\tstatic void " << function << "(CodeExecutor*, ExecutionContext* context, ProgramFrame* code, Instance* instance)\n\t{\n";
+			std::istringstream body(writer.GetBody());
+			for (std::string line; std::getline(body, line);) {
+				functions << "\t" << line << "\n";
+			}
+			functions << "\t}\n\n";
+
+			char hash[24];
+			std::snprintf(hash, sizeof(hash), "0x%016llxull", static_cast<unsigned long long>(NativeRegistry::Hash(event_data.data, event_data.size)));
+			registry << "\t\t{ " << hash << ", &NativeScripts::" << function << " },\n";
+			transpiled++;
+		}
+	}
+
+	std::ofstream output(file, std::ios::out | std::ios::trunc);
+	if (!output.is_open()) {
+		Console::WriteLine("Transpile: can not open '" + file + "'");
+		return false;
+	}
+	output << "// Native scripts generated by ArtCore -transpile from object_compile.acp\n";
+	output << "// do not edit, generate again when scripts are changed\n";
+	output << "#include \"ArtCore/CodeExecutor/CodeExecutor.h\"\n";
+	output << "#include \"ArtCore/CodeExecutor/NativeScript.h\"\n";
+	output << "#include \"ArtCore/Functions/SDL_Color_extend.h\"\n";
+	output << "#include \"ArtCore/Functions/SDL_FPoint_extend.h\"\n";
+	output << "#include \"ArtCore/Scene/Scene.h\"\n";
+	output << "#include \"ArtCore/System/Core.h\"\n\n";
+	output << "class NativeScripts\n{\npublic:\n";
+	output << functions.str();
+	output << "};\n\n";
+	output << "namespace\n{\n";
+	output << "\tconst NativeRegistrar registrar({\n";
+	output << registry.str();
+	output << "\t});\n}\n";
+	output.close();
+
+	Console::WriteLine("Transpile: " + std::to_string(transpiled) + " scripts written to '" + file + "', " + std::to_string(skipped) + " stay interpreted");
+	return true;
+}
+
+#undef OPCODE
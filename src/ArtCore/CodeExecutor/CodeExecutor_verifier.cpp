@@ -0,0 +1,323 @@
+// ReSharper disable CppDefaultCaseNotHandledInSwitchStatement
+// ReSharper disable CppIncompleteSwitchStatement
+// ReSharper disable CppClangTidyClangDiagnosticSwitch
+#include "CodeExecutor.h"
+
+#include <algorithm>
+
+#include "ArtCore/Gui/Console.h"
+
+#define OPCODE Instruction::Opcode
+
+namespace
+{
+	typedef OperandStack::SlotType SlotType;
+
+	std::string SlotName(const SlotType type)
+	{
+		switch (type) {
+		case SlotType::NUL:			return "null";
+		case SlotType::INT:			return "int";
+		case SlotType::FLOAT:		return "float";
+		case SlotType::BOOL:		return "bool";
+		case SlotType::INSTANCE:	return "instance";
+		case SlotType::POINT:		return "point";
+		case SlotType::RECT:		return "rect";
+		case SlotType::COLOR:		return "color";
+		case SlotType::STRING:		return "string";
+		case SlotType::LIST:		return "list";
+		}
+		return "invalid";
+	}
+
+	// type that instance can store
+	bool IsVariableType(const int type)
+	{
+		return (type > ArtCode::variable_type::NUL && type < ArtCode::variable_type::ENUM) || type == ArtCode::variable_type::LIST;
+	}
+
+	// same pairs as CodeExecutor::h_compare, other pairs are always false
+	bool IsCompareSupported(const int type, const int operation)
+	{
+		switch (operation) {
+		case 0: //	"||",
+		case 1: //	"&&",
+			return type == ArtCode::variable_type::BOOL;
+		case 2: //	"<<",
+		case 3: //	">>",
+		case 4: //	">=",
+		case 5: //	"<=",
+			return type == ArtCode::variable_type::INT || type == ArtCode::variable_type::FLOAT || type == ArtCode::variable_type::POINT;
+		case 6: //	"!=",
+			return IsVariableType(type) && type != ArtCode::variable_type::POINT && type != ArtCode::variable_type::COLOR && type != ArtCode::variable_type::LIST;
+		case 7: //	"=="
+			return IsVariableType(type) && type != ArtCode::variable_type::POINT && type != ArtCode::variable_type::LIST;
+		}
+		return false;
+	}
+}
+
+OperandStack::SlotType CodeExecutor::h_slot_type(const int type)
+{
+	// every asset is passed as int
+	switch (type) {
+	case ArtCode::variable_type::INT:
+	case ArtCode::variable_type::OBJECT:
+	case ArtCode::variable_type::SPRITE:
+	case ArtCode::variable_type::TEXTURE:
+	case ArtCode::variable_type::SOUND:
+	case ArtCode::variable_type::MUSIC:
+	case ArtCode::variable_type::FONT:		return SlotType::INT;
+	case ArtCode::variable_type::FLOAT:		return SlotType::FLOAT;
+	case ArtCode::variable_type::BOOL:		return SlotType::BOOL;
+	case ArtCode::variable_type::INSTANCE:	return SlotType::INSTANCE;
+	case ArtCode::variable_type::POINT:		return SlotType::POINT;
+	case ArtCode::variable_type::RECT:		return SlotType::RECT;
+	case ArtCode::variable_type::COLOR:		return SlotType::COLOR;
+	case ArtCode::variable_type::STRING:	return SlotType::STRING;
+	case ArtCode::variable_type::LIST:		return SlotType::LIST;
+	}
+	return SlotType::NUL;
+}
+
+bool CodeExecutor::h_verify_program(const Program& program, const InstanceDefinition& definition) const
+{
+	bool valid = true;
+	const int size = program.GetSize();
+	if (size == 0 || program.Code.back().Op != OPCODE::END) {
+		Console::WriteLine("Verifier: '" + program.Name + "' - program must end with END");
+		return false;
+	}
+
+	// types of values pushed by current statement
+	std::vector<SlotType> stack;
+	size_t statement = 0;
+	int if_count = 0;
+	for (int i = 0; i < size; i++) {
+		const Instruction& instruction = program.Code[i];
+		const auto error = [&](const std::string& message)
+		{
+			Console::WriteLine("Verifier: '" + program.Name + "' - instruction " + std::to_string(i) + " " + Instruction::OpcodeName(instruction.Op) + ": " + message);
+			valid = false;
+		};
+		const auto pop = [&](const SlotType expected)
+		{
+			if (stack.empty()) {
+				error("expected " + SlotName(expected) + " but stack is empty");
+				return;
+			}
+			if (stack.back() != expected) {
+				error("expected " + SlotName(expected) + " but " + SlotName(stack.back()) + " is given");
+			}
+			stack.pop_back();
+		};
+		const auto literal = [&](const size_t pool_size)
+		{
+			if (instruction.Operand < 0 || static_cast<size_t>(instruction.Operand) >= pool_size) {
+				error("literal " + std::to_string(instruction.Operand) + " out of pool");
+			}
+		};
+		const auto variable = [&](const InstanceDefinition& owner, const int type, const int index)
+		{
+			if (!IsVariableType(type)) {
+				error("wrong variable type " + std::to_string(type));
+				return;
+			}
+			const size_t count = owner.VariablesNames.at(static_cast<ArtCode::variable_type>(type)).size();
+			if (static_cast<size_t>(index) >= count) {
+				error("variable " + ArtCode::variable_type_toString(static_cast<ArtCode::variable_type>(type)) + "[" + std::to_string(index) + "] not exists, '" + owner.Name + "' have " + std::to_string(count));
+			}
+		};
+		const auto other = [&](const int definition_index) -> const InstanceDefinition*
+		{
+			if (static_cast<size_t>(definition_index) >= _instance_definitions.size()) {
+				error("instance definition " + std::to_string(definition_index) + " not exists");
+				return nullptr;
+			}
+			return &_instance_definitions[definition_index];
+		};
+		const auto jump = [&]
+		{
+			if (instruction.Operand <= i || instruction.Operand >= size) {
+				error("wrong jump target " + std::to_string(instruction.Operand));
+			}
+		};
+
+		// value of one statement is never used by next one
+		while (statement < program.Statements.size() && program.Statements[statement] <= i) {
+			stack.clear();
+			statement++;
+		}
+
+		switch (instruction.Op) {
+		case OPCODE::PUSH_INT:
+			stack.push_back(SlotType::INT);
+			break;
+		case OPCODE::PUSH_FLOAT:
+			literal(program.LiteralFloat.size());
+			stack.push_back(SlotType::FLOAT);
+			break;
+		case OPCODE::PUSH_BOOL:
+			stack.push_back(SlotType::BOOL);
+			break;
+		case OPCODE::PUSH_INSTANCE:
+			stack.push_back(SlotType::INSTANCE);
+			break;
+		case OPCODE::PUSH_POINT:
+			literal(program.LiteralPoint.size());
+			stack.push_back(SlotType::POINT);
+			break;
+		case OPCODE::PUSH_RECT:
+			literal(program.LiteralRect.size());
+			stack.push_back(SlotType::RECT);
+			break;
+		case OPCODE::PUSH_COLOR:
+			literal(program.LiteralColor.size());
+			stack.push_back(SlotType::COLOR);
+			break;
+		case OPCODE::PUSH_STRING:
+			literal(program.LiteralString.size());
+			stack.push_back(SlotType::STRING);
+			break;
+
+		case OPCODE::PUSH_LOCAL:
+			variable(definition, instruction.A, instruction.B);
+			stack.push_back(h_slot_type(instruction.A));
+			break;
+
+		case OPCODE::PUSH_OTHER:
+			if (const InstanceDefinition* owner = other(instruction.A); owner != nullptr) {
+				variable(*owner, instruction.B, instruction.C);
+			}
+			stack.push_back(h_slot_type(instruction.B));
+			break;
+
+		case OPCODE::CALL: {
+			const int function_index = instruction.Operand;
+			if (function_index < 0 || static_cast<size_t>(function_index) >= FunctionsList.size() || static_cast<size_t>(function_index) >= FunctionsSignature.size()) {
+				error("function " + std::to_string(function_index) + " not exists");
+				stack.clear();
+				break;
+			}
+			if (FunctionsList[function_index] == nullptr) {
+				error("function " + std::to_string(function_index) + " is not implemented");
+			}
+			const FunctionSignature& signature = FunctionsSignature[function_index];
+			if (instruction.A != signature.Arguments.size()) {
+				error("function " + std::to_string(function_index) + " expect " + std::to_string(signature.Arguments.size()) + " arguments but " + std::to_string(instruction.A) + " is given");
+			}
+			if (instruction.B > stack.size()) {
+				error("function " + std::to_string(function_index) + " arguments are not on stack");
+				stack.clear();
+			}
+			else if (instruction.B == instruction.A && instruction.A == signature.Arguments.size()) {
+				// last argument is on top
+				for (int argument = instruction.A - 1; argument >= 0; argument--) {
+					pop(h_slot_type(signature.Arguments[argument]));
+				}
+			}
+			else {
+				// null arguments are not pushed, can not tell which one is missing
+				stack.resize(stack.size() - instruction.B);
+			}
+			if (signature.Return != ArtCode::variable_type::NUL) {
+				stack.push_back(h_slot_type(signature.Return));
+			}
+		}break;
+
+		case OPCODE::SET:
+			if (instruction.A > 4) {
+				error("unknown operator " + std::to_string(instruction.A));
+			}
+			if (instruction.B == ArtCode::variable_type::LIST) {
+				error("list can be changed only by list functions");
+			}
+			variable(definition, instruction.B, instruction.C);
+			// set to null do not push value
+			if (!stack.empty()) {
+				pop(h_slot_type(instruction.B));
+			}
+			break;
+
+		case OPCODE::SET_OTHER:
+			if (instruction.Operand < 0 || instruction.Operand > 4) {
+				error("unknown operator " + std::to_string(instruction.Operand));
+			}
+			if (instruction.B == ArtCode::variable_type::LIST) {
+				error("list can be changed only by list functions");
+			}
+			if (const InstanceDefinition* owner = other(instruction.A); owner != nullptr) {
+				variable(*owner, instruction.B, instruction.C);
+			}
+			if (!stack.empty()) {
+				pop(h_slot_type(instruction.B));
+			}
+			break;
+
+		case OPCODE::IF:
+			if (instruction.B == Instruction::NO_OPERATOR) {
+				pop(SlotType::BOOL);
+			}
+			else if (!IsCompareSupported(instruction.A, instruction.B)) {
+				error("operator " + std::to_string(instruction.B) + " can not compare " + ArtCode::variable_type_toString(static_cast<ArtCode::variable_type>(instruction.A)));
+			}
+			else {
+				pop(h_slot_type(instruction.A));
+				pop(h_slot_type(instruction.A));
+			}
+			jump();
+			if_count++;
+			break;
+
+		case OPCODE::ELSE:
+			if (if_count == 0) {
+				error("else without if");
+			}
+			jump();
+			break;
+
+		case OPCODE::BREAK:
+			// decoder put break in place of broken if test
+			error("broken if test");
+			break;
+
+		case OPCODE::END:
+			if (i != size - 1) {
+				error("end before last instruction");
+			}
+			break;
+
+		case OPCODE::SET_LOCAL:
+		case OPCODE::CALL_SET:
+		case OPCODE::IF_LOCAL:
+			error("code is already fused");
+			break;
+
+		default:
+			error("unknown opcode " + std::to_string(static_cast<int>(instruction.Op)));
+			break;
+		}
+	}
+	return valid;
+}
+
+bool CodeExecutor::h_is_local_program(const Program& program) const
+{
+	for (const Instruction& instruction : program.Code) {
+		switch (instruction.Op) {
+		case OPCODE::PUSH_INSTANCE:
+		case OPCODE::PUSH_OTHER:
+		case OPCODE::SET_OTHER:
+			// other instances can be changed by other worker
+			return false;
+		case OPCODE::CALL:
+			if (FunctionsSignature[instruction.Operand].Scope == FunctionScope::GLOBAL) {
+				return false;
+			}
+			break;
+		}
+	}
+	return true;
+}
+
+#undef OPCODE
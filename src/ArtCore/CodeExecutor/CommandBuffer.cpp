@@ -0,0 +1,132 @@
+#include "CommandBuffer.h"
+
+#include "ArtCore/Scene/Instance.h"
+#include "ArtCore/Scene/InstancePool.h"
+#include "ArtCore/Scene/Scene.h"
+#include "ArtCore/System/Core.h"
+
+CommandBuffer::~CommandBuffer()
+{
+	Discard();
+}
+
+void CommandBuffer::SpawnInstance(Instance* instance)
+{
+	_spawn.push_back(instance);
+}
+
+void CommandBuffer::DeleteInstance(const Instance* instance)
+{
+	// dead instance can be released and reused before apply
+	if (!instance->Alive()) return;
+	_delete.push_back(instance->GetHandle());
+}
+
+void CommandBuffer::PlaySound(Mix_Chunk* sound)
+{
+	_sound.push_back(sound);
+}
+
+void CommandBuffer::PlayMusic(Mix_Music* music)
+{
+	_music.push_back(music);
+}
+
+void CommandBuffer::GuiVisibility(const std::string& tag, const bool visible)
+{
+	_gui_visibility.push_back({ tag, visible });
+}
+
+void CommandBuffer::GuiEnabled(const std::string& tag, const bool enabled)
+{
+	_gui_enabled.push_back({ tag, enabled });
+}
+
+void CommandBuffer::ChangeScene(const std::string& scene)
+{
+	// only last change matters
+	_scene = scene;
+}
+
+bool CommandBuffer::IsEmpty() const
+{
+	return _spawn.empty() && _delete.empty() && _sound.empty() && _music.empty()
+		&& _gui_visibility.empty() && _gui_enabled.empty() && _scene.empty();
+}
+
+void CommandBuffer::Discard()
+{
+	Scene* scene = Core::GetCurrentScene();
+	for (Instance* instance : _spawn) {
+		// handle was given when spawned
+		if (scene != nullptr) scene->InstanceHandles.Remove(instance);
+		InstancePool::Release(instance);
+	}
+	Clear();
+}
+
+void CommandBuffer::Clear()
+{
+	// clear keep capacity, next frame do not allocate
+	_spawn.clear();
+	_delete.clear();
+	_sound.clear();
+	_music.clear();
+	_gui_visibility.clear();
+	_gui_enabled.clear();
+	_scene.clear();
+}
+
+void CommandBuffer::Apply(const std::span<CommandBuffer* const> buffers)
+{
+	bool any = false;
+	for (const CommandBuffer* buffer : buffers) {
+		any |= !buffer->IsEmpty();
+	}
+	if (!any) return;
+
+	Scene* scene = Core::GetCurrentScene();
+	// deleted instances are removed from scene in next step
+	for (const CommandBuffer* buffer : buffers) {
+		for (const InstanceHandle handle : buffer->_delete) {
+			Instance* instance = scene->InstanceHandles.Get(handle);
+			if (instance != nullptr && instance->Alive()) scene->MarkInstanceDeleted(instance);
+		}
+	}
+	for (const CommandBuffer* buffer : buffers) {
+		scene->AddNewInstances(buffer->_spawn);
+	}
+	for (const CommandBuffer* buffer : buffers) {
+		for (const GuiCommand& command : buffer->_gui_visibility) {
+			if (Gui::GuiElementTemplate* element = scene->GuiSystem.Element(command.Tag); element != nullptr) {
+				element->SetVisible(command.Value);
+			}
+		}
+		for (const GuiCommand& command : buffer->_gui_enabled) {
+			if (Gui::GuiElementTemplate* element = scene->GuiSystem.Element(command.Tag); element != nullptr) {
+				element->SetEnabled(command.Value);
+			}
+		}
+	}
+	Mix_Music* music = nullptr;
+	std::string next_scene;
+	for (const CommandBuffer* buffer : buffers) {
+		for (Mix_Chunk* sound : buffer->_sound) {
+			Mix_PlayChannel(-1, sound, 0);
+		}
+		// there is only one music at once
+		if (!buffer->_music.empty()) music = buffer->_music.back();
+		if (!buffer->_scene.empty()) next_scene = buffer->_scene;
+	}
+	if (music != nullptr) {
+		Mix_PlayMusic(music, 0);
+	}
+
+	// spawned instances are owned by scene now
+	for (CommandBuffer* buffer : buffers) {
+		buffer->Clear();
+	}
+	if (!next_scene.empty()) {
+		Core::GetInstance()->ChangeScene(next_scene);
+	}
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <span>
+#include <string>
+#include <vector>
+
+#include "SDL2/IncludeAll.h"
+#include "ArtCore/Scene/InstanceTable.h"
+
+class Instance;
+
+// Changes of world requested by scripts. Built-in functions only record them,
+// Core apply all buffers at sync points, so no script see world changed in the middle of step.
+class CommandBuffer final
+{
+public:
+	CommandBuffer() = default;
+	~CommandBuffer();
+	CommandBuffer(const CommandBuffer&) = delete;
+	CommandBuffer& operator=(const CommandBuffer&) = delete;
+	CommandBuffer(CommandBuffer&&) = default;
+	CommandBuffer& operator=(CommandBuffer&&) = default;
+
+	// instance is already created, it is only not added to scene
+	void SpawnInstance(Instance* instance);
+	// instance is kept by handle, so reused instance is not deleted
+	void DeleteInstance(const Instance* instance);
+	void PlaySound(Mix_Chunk* sound);
+	void PlayMusic(Mix_Music* music);
+	void GuiVisibility(const std::string& tag, bool visible);
+	void GuiEnabled(const std::string& tag, bool enabled);
+	void ChangeScene(const std::string& scene);
+
+	[[nodiscard]] bool IsEmpty() const;
+	// drop all commands, spawned instances are deleted
+	void Discard();
+
+	// Apply buffers kind by kind: deletes, spawns, gui, audio and scene change at end.
+	// Inside kind order is order of buffers and then order of recording.
+	static void Apply(std::span<CommandBuffer* const> buffers);
+
+private:
+	struct GuiCommand
+	{
+		std::string Tag;
+		bool Value;
+	};
+	void Clear();
+
+	std::vector<Instance*> _spawn;
+	std::vector<InstanceHandle> _delete;
+	std::vector<Mix_Chunk*> _sound;
+	std::vector<Mix_Music*> _music;
+	std::vector<GuiCommand> _gui_visibility;
+	std::vector<GuiCommand> _gui_enabled;
+	// empty if scene is not changed
+	std::string _scene;
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include "CommandBuffer.h"
+#include "OpcodeCounter.h"
+#include "ScriptProfiler.h"
+#include "OperandStack.h"
+#include "Program.h"
+#include "Stack.h"
+
+// State of running scripts. Executor keep only data that do not change after load,
+// so every thread that execute scripts need own context and contexts share nothing.
+struct ExecutionContext final
+{
+	// values passed between code and functions
+	OperandStack Stack;
+	// result of every if test, else read last one
+	AStack<bool> IfTestResult;
+	// script executed now, nullptr if function is called from console
+	ProgramFrame* Frame = nullptr;
+	// world changes made by scripts, applied by Core
+	CommandBuffer Commands;
+	// filled only when ScriptProfiler::Enabled
+	ScriptProfiler Profile;
+	// filled only when OpcodeCounter::Enabled
+	OpcodeCounter Counter;
+
+	// Break from current script
+	void Break() const
+	{
+		if (Frame != nullptr) Frame->Break = true;
+	}
+
+	void Erase()
+	{
+		Stack.Erase();
+		IfTestResult.Erase();
+	}
+};
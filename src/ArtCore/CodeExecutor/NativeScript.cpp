@@ -0,0 +1,34 @@
+#include "NativeScript.h"
+
+Uint64 NativeRegistry::Hash(const unsigned char* code, const Sint64 size)
+{
+	// FNV-1a
+	Uint64 hash = 14695981039346656037ull;
+	for (Sint64 i = 0; i < size; i++) {
+		hash ^= code[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+void NativeRegistry::Register(const Uint64 hash, const NativeScript script)
+{
+	Scripts()[hash] = script;
+}
+
+NativeScript NativeRegistry::Find(const Uint64 hash)
+{
+	const auto it = Scripts().find(hash);
+	return it == Scripts().end() ? nullptr : it->second;
+}
+
+int NativeRegistry::Size()
+{
+	return static_cast<int>(Scripts().size());
+}
+
+std::unordered_map<Uint64, NativeScript>& NativeRegistry::Scripts()
+{
+	static std::unordered_map<Uint64, NativeScript> scripts;
+	return scripts;
+}
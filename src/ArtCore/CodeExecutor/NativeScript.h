@@ -0,0 +1,40 @@
+#pragma once
+#include <initializer_list>
+#include <unordered_map>
+#include <utility>
+
+#include "SDL2/IncludeAll.h"
+
+class CodeExecutor;
+class Instance;
+struct ExecutionContext;
+struct ProgramFrame;
+
+// ArtCode event transpiled to c++ by "-transpile", same behaviour as interpreted program
+typedef void (*NativeScript)(CodeExecutor* executor, ExecutionContext* context, ProgramFrame* code, Instance* instance);
+
+// Native scripts are found by hash of ArtCode they are made from,
+// if code is changed in editor hash do not match and interpreter is used.
+class NativeRegistry final
+{
+public:
+	static Uint64 Hash(const unsigned char* code, Sint64 size);
+	static void Register(Uint64 hash, NativeScript script);
+	// nullptr if code have no native version
+	static NativeScript Find(Uint64 hash);
+	static int Size();
+private:
+	// generated file register scripts before main, so map can not be static member
+	static std::unordered_map<Uint64, NativeScript>& Scripts();
+};
+
+// generated file create one to register all scripts
+struct NativeRegistrar final
+{
+	NativeRegistrar(const std::initializer_list<std::pair<Uint64, NativeScript>> scripts)
+	{
+		for (const auto& [hash, script] : scripts) {
+			NativeRegistry::Register(hash, script);
+		}
+	}
+};
@@ -0,0 +1,81 @@
+#include "OpcodeCounter.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "ExecutionContext.h"
+
+#define OPCODE Instruction::Opcode
+
+void OpcodeCounter::Reset()
+{
+	_opcodes.fill(0);
+	_positions.clear();
+	_last_program = nullptr;
+	_last_counts = nullptr;
+}
+
+std::string OpcodeCounter::Report(const std::span<ExecutionContext* const> contexts, const std::vector<std::string>& functions_names, const size_t programs)
+{
+	std::array<Uint64, static_cast<int>(OPCODE::INVALID)> opcodes{};
+	std::unordered_map<const Program*, std::vector<Uint64>> positions;
+	for (const ExecutionContext* context : contexts) {
+		const OpcodeCounter& counter = context->Counter;
+		for (size_t i = 0; i < opcodes.size(); i++) {
+			opcodes[i] += counter._opcodes[i];
+		}
+		for (const auto& [program, counts] : counter._positions) {
+			std::vector<Uint64>& target = positions[program];
+			target.resize(counts.size());
+			for (size_t i = 0; i < counts.size(); i++) {
+				target[i] += counts[i];
+			}
+		}
+	}
+
+	std::ostringstream report;
+	report.setf(std::ios::fixed);
+	report.precision(2);
+	Uint64 total = 0;
+	for (const Uint64 count : opcodes) total += count;
+	report << "executed instructions: " << total << '\n';
+	if (total == 0) return report.str();
+
+	std::vector<int> order(opcodes.size());
+	for (size_t i = 0; i < order.size(); i++) order[i] = static_cast<int>(i);
+	std::ranges::sort(order, [&](const int a, const int b) { return opcodes[a] > opcodes[b]; });
+	for (const int op : order) {
+		if (opcodes[op] == 0) break;
+		report << Instruction::OpcodeName(static_cast<OPCODE>(op)) << ": " << opcodes[op]
+			<< " (" << 100.0 * static_cast<double>(opcodes[op]) / static_cast<double>(total) << "%)\n";
+	}
+
+	// hottest programs by executed instructions
+	std::vector<std::pair<const Program*, Uint64>> hot;
+	for (const auto& [program, counts] : positions) {
+		Uint64 sum = 0;
+		for (const Uint64 count : counts) sum += count;
+		hot.emplace_back(program, sum);
+	}
+	std::ranges::sort(hot, [](const auto& a, const auto& b) { return a.second > b.second; });
+	for (size_t p = 0; p < hot.size() && p < programs; p++) {
+		const Program* program = hot[p].first;
+		const std::vector<Uint64>& counts = positions[program];
+		report << "--- " << program->Name << " (" << hot[p].second << ")\n";
+		// index is in decoded code, superinstructions replace few of them, byte is statement in ArtCode chunk
+		report << "count | index @byte: instruction\n";
+		for (int i = 0; i < program->GetSize(); i++) {
+			const Instruction& instruction = program->Code[i];
+			report << counts[i] << " | " << i << " @" << program->Offsets[i] << ": " << Instruction::OpcodeName(instruction.Op) << ' '
+				<< static_cast<int>(instruction.A) << ' ' << static_cast<int>(instruction.B) << ' ' << static_cast<int>(instruction.C) << ' ' << instruction.Operand;
+			if ((instruction.Op == OPCODE::CALL || instruction.Op == OPCODE::CALL_SET)
+				&& instruction.Operand >= 0 && static_cast<size_t>(instruction.Operand) < functions_names.size()) {
+				report << " ; " << functions_names[instruction.Operand];
+			}
+			report << '\n';
+		}
+	}
+	return report.str();
+}
+
+#undef OPCODE
@@ -0,0 +1,41 @@
+#pragma once
+#include <array>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Program.h"
+
+struct ExecutionContext;
+
+// Count of executed instructions by opcode and by position in program, switched from console.
+// Report show opcode histogram and disassembly of hottest programs with count of every instruction.
+class OpcodeCounter final
+{
+public:
+	static inline bool Enabled = false;
+
+	void Count(const Program* program, const int position)
+	{
+		if (program != _last_program) {
+			std::vector<Uint64>& counts = _positions[program];
+			counts.resize(program->GetSize());
+			_last_program = program;
+			_last_counts = counts.data();
+		}
+		_last_counts[position]++;
+		_opcodes[static_cast<int>(program->Code[position].Op)]++;
+	}
+	void Reset();
+
+	// programs must be still loaded, function names are given by index
+	static std::string Report(std::span<ExecutionContext* const> contexts, const std::vector<std::string>& functions_names, size_t programs);
+
+private:
+	std::array<Uint64, static_cast<int>(Instruction::Opcode::INVALID)> _opcodes{};
+	std::unordered_map<const Program*, std::vector<Uint64>> _positions;
+	// most of instructions are from the same program as previous one
+	const Program* _last_program = nullptr;
+	Uint64* _last_counts = nullptr;
+};
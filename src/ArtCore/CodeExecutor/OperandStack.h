@@ -0,0 +1,201 @@
+#pragma once
+#include <string>
+#include <vector>
+#ifdef tests
+#include <cassert>
+#include "../../src/SDL2/SDL2/include/SDL_rect.h"
+#include "../../src/SDL2/SDL2/include/SDL_pixels.h"
+#define OPERAND_STACK_ASSERT(condition) assert(condition)
+#else
+#include "SDL2/IncludeAll.h"
+#include "ArtCore/Structs/Rect.h"
+#define OPERAND_STACK_ASSERT(condition) SDL_assert(condition)
+#endif
+
+class Instance;
+class ArtList;
+
+// One contiguous stack for every value passed between ArtCode and functions.
+// Slots are 16 bytes, type tags are kept in separate array so Rect fit in slot.
+// Strings are kept in own pool and slot have only handle to it. Pool strings keep
+// their capacity, so push and pop do not allocate after first frames.
+// String can carry id from string interner, two strings with ids are compared by id.
+class OperandStack final
+{
+public:
+	enum class SlotType : Uint8
+	{
+		NUL,
+		INT,
+		FLOAT,
+		BOOL,
+		INSTANCE,
+		POINT,
+		RECT,
+		COLOR,
+		STRING,
+		LIST
+	};
+
+	union Slot
+	{
+		int Int;
+		float Float;
+		bool Bool;
+		Instance* Reference;
+		SDL_FPoint Point;
+		SDL_FRect Rectangle;
+		SDL_Color Color;
+		Uint32 String;
+		ArtList* List;
+	};
+	static_assert(sizeof(Slot) == 16, "Operand stack slot must have 16 bytes");
+	// string is not interned, compare by content
+	static constexpr Uint32 NO_STRING_ID = UINT32_MAX;
+
+	explicit OperandStack(const int capacity = 256, const int string_capacity = 32)
+	{
+		_slots.resize(capacity);
+		_types.resize(capacity);
+		_strings.resize(string_capacity);
+		_string_ids.resize(string_capacity);
+	}
+
+	void PushInt(const int value) { Push(SlotType::INT).Int = value; }
+	void PushFloat(const float value) { Push(SlotType::FLOAT).Float = value; }
+	void PushBool(const bool value) { Push(SlotType::BOOL).Bool = value; }
+	void PushInstance(Instance* value) { Push(SlotType::INSTANCE).Reference = value; }
+	void PushPoint(const SDL_FPoint value) { Push(SlotType::POINT).Point = value; }
+	void PushColor(const SDL_Color value) { Push(SlotType::COLOR).Color = value; }
+	// list is passed by pointer to instance variable
+	void PushList(ArtList* value) { Push(SlotType::LIST).List = value; }
+#ifndef tests
+	void PushRect(const Rect& value) { Push(SlotType::RECT).Rectangle = SDL_FRect{ value.X, value.Y, value.W, value.H }; }
+#endif
+	// id is interned id of value, equal ids must mean equal strings
+	void PushString(const std::string& value, const Uint32 id = NO_STRING_ID)
+	{
+		if (_strings_size == static_cast<int>(_strings.size())) {
+			_strings.resize(_strings.size() * 2);
+			_string_ids.resize(_strings.size());
+		}
+		// assign keep capacity of pool string
+		_strings[_strings_size] = value;
+		_string_ids[_strings_size] = id;
+		Push(SlotType::STRING).String = static_cast<Uint32>(_strings_size++);
+	}
+
+	// Get fresh value on stack, or default value if stack is empty
+	int PopInt() { return _size > 0 ? Pop(SlotType::INT).Int : 0; }
+	float PopFloat() { return _size > 0 ? Pop(SlotType::FLOAT).Float : 0.0f; }
+	bool PopBool() { return _size > 0 ? Pop(SlotType::BOOL).Bool : false; }
+	Instance* PopInstance() { return _size > 0 ? Pop(SlotType::INSTANCE).Reference : nullptr; }
+	SDL_FPoint PopPoint() { return _size > 0 ? Pop(SlotType::POINT).Point : SDL_FPoint{ 0.0f, 0.0f }; }
+	SDL_Color PopColor() { return _size > 0 ? Pop(SlotType::COLOR).Color : SDL_Color{ 0, 0, 0, 0 }; }
+	ArtList* PopList() { return _size > 0 ? Pop(SlotType::LIST).List : nullptr; }
+#ifndef tests
+	Rect PopRect()
+	{
+		if (_size == 0) return {};
+		const SDL_FRect& rect = Pop(SlotType::RECT).Rectangle;
+		return { rect.x, rect.y, rect.w, rect.h };
+	}
+#endif
+	// returned string is valid until next PushString
+	const std::string& PopString()
+	{
+		if (_size == 0 || _types[_size - 1] != SlotType::STRING) {
+			OPERAND_STACK_ASSERT(_size == 0);
+			if (_size > 0) --_size;
+			return _empty_string;
+		}
+		_strings_size = static_cast<int>(_slots[--_size].String);
+		return _strings[_strings_size];
+	}
+	// pop two strings and test if they are equal, interned strings are compared by id only
+	bool PopStringsEqual()
+	{
+		if (_size < 2 || _types[_size - 1] != SlotType::STRING || _types[_size - 2] != SlotType::STRING) {
+			return PopString() == PopString();
+		}
+		const Uint32 right = _slots[_size - 1].String;
+		const Uint32 left = _slots[_size - 2].String;
+		_size -= 2;
+		_strings_size = static_cast<int>(left);
+		if (_string_ids[left] != NO_STRING_ID && _string_ids[right] != NO_STRING_ID) {
+			return _string_ids[left] == _string_ids[right];
+		}
+		return _strings[left] == _strings[right];
+	}
+
+	// type of value on top, NUL if empty
+	[[nodiscard]] SlotType Top() const
+	{
+		return _size > 0 ? _types[_size - 1] : SlotType::NUL;
+	}
+
+	[[nodiscard]] bool IsEmpty() const
+	{
+		return _size == 0;
+	}
+
+	[[nodiscard]] int Size() const
+	{
+		return _size;
+	}
+
+	[[nodiscard]] int Capacity() const
+	{
+		return static_cast<int>(_slots.size());
+	}
+
+	void Erase()
+	{
+		_size = 0;
+		_strings_size = 0;
+	}
+
+	// size of stack and string pool, values pushed after mark are dropped by Truncate
+	struct Mark
+	{
+		int Size;
+		int StringsSize;
+	};
+	[[nodiscard]] Mark GetMark() const
+	{
+		return { _size, _strings_size };
+	}
+	// drop values left by script, like result of call that is not used
+	void Truncate(const Mark mark)
+	{
+		if (_size > mark.Size) _size = mark.Size;
+		if (_strings_size > mark.StringsSize) _strings_size = mark.StringsSize;
+	}
+
+private:
+	std::vector<Slot> _slots;
+	std::vector<SlotType> _types;
+	int _size = 0;
+	std::vector<std::string> _strings;
+	std::vector<Uint32> _string_ids;
+	int _strings_size = 0;
+	inline static const std::string _empty_string;
+
+	Slot& Push(const SlotType type)
+	{
+		if (_size == static_cast<int>(_slots.size())) {
+			// only if scripts need more than ever before
+			_slots.resize(_slots.size() * 2);
+			_types.resize(_types.size() * 2);
+		}
+		_types[_size] = type;
+		return _slots[_size++];
+	}
+
+	const Slot& Pop([[maybe_unused]] const SlotType type)
+	{
+		--_size;
+		OPERAND_STACK_ASSERT(_types[_size] == type);
+		return _slots[_size];
+	}
+};
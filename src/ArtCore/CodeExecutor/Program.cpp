@@ -0,0 +1,441 @@
+// ReSharper disable CppDefaultCaseNotHandledInSwitchStatement
+// ReSharper disable CppIncompleteSwitchStatement
+// ReSharper disable CppClangTidyClangDiagnosticSwitch
+#include "Program.h"
+
+#include <algorithm>
+#include <ranges>
+
+#include "ArtCore/Functions/Convert.h"
+#include "ArtCore/Functions/Func.h"
+#include "ArtCore/Gui/Console.h"
+
+#define COMMAND ArtCode::Command
+#define OPCODE Instruction::Opcode
+
+const char* Instruction::OpcodeName(const Opcode op)
+{
+	switch (op) {
+#define X(name) case Opcode::name: return #name;
+		ART_CODE_OPCODES(X)
+#undef X
+	case Opcode::INVALID: break;
+	}
+	return "INVALID";
+}
+
+bool Program::Decode(const unsigned char* code, const Sint64 size, const std::string& name)
+{
+	Name = name;
+	Code.clear();
+	Offsets.clear();
+	Handlers.clear();
+	LiteralFloat.clear();
+	LiteralPoint.clear();
+	LiteralRect.clear();
+	LiteralColor.clear();
+	LiteralString.clear();
+	LiteralStringId.clear();
+	Statements.clear();
+	Fused = 0;
+	_valid = true;
+	_statements.clear();
+	_jumps.clear();
+
+#ifndef _DEBUG
+	Inspector inspector(code, size);
+#else
+	Inspector inspector(code, size, name);
+#endif
+	_code = &inspector;
+
+	while (!_code->IsEnd()) {
+		// every statement can be target of jump
+		_statements.emplace_back(_code->GetPosition() + 1, GetSize());
+		switch (_code->GetNextCommand()) {
+		case COMMAND::SET: {
+			const Uint8 operation = _code->GetBit();
+			const Uint8 type = _code->GetBit();
+			const Uint8 index = _code->GetBit();
+			DecodeValue();
+			Emit(OPCODE::SET, operation, type, index);
+		}break;
+
+		case COMMAND::OTHER: {
+			const Uint8 instance_type = _code->GetBit();
+			const Uint8 type = _code->GetBit();
+			const Uint8 index = _code->GetBit();
+			const Uint8 operation = _code->GetBit();
+			DecodeValue();
+			Emit(OPCODE::SET_OTHER, instance_type, type, index, operation);
+		}break;
+
+		case COMMAND::FUNCTION:
+			DecodeFunction();
+			break;
+
+		case COMMAND::IF_TEST:
+			DecodeIfTest();
+			break;
+
+		case COMMAND::END:
+			// end of script, rest is padding
+			break;
+
+		case COMMAND::ELSE: {
+			const unsigned char skip_2_bit[2]
+			{
+				_code->GetBit(), _code->GetBit()
+			};
+			unsigned int skip;
+			Convert::TwoByteCharToUint32(skip_2_bit, &skip);
+			Emit(OPCODE::ELSE);
+			_jumps.emplace_back(GetSize() - 1, _code->GetPosition() + static_cast<Sint64>(skip) + 1);
+		}break;
+
+		default:
+			Error("unknown command " + std::to_string(_code->Current()));
+			break;
+		}
+		if (!_valid) break;
+	}
+	if (_code->GetPosition() > _code->GetLength()) {
+		Error("unexpected end of code");
+	}
+	_statements.emplace_back(_code->GetLength() + 1, GetSize());
+	Emit(OPCODE::END);
+	_code = nullptr;
+
+	// all jumps are in bytes, translate them to instructions
+	bool valid = _valid;
+	for (const auto& [instruction, position] : _jumps) {
+		const int target = ResolveJump(position);
+		if (target <= instruction) {
+			// scripts have no loops, every jump is forward
+			Console::WriteLine("Program '" + Name + "' - wrong jump target: " + std::to_string(position));
+			valid = false;
+			continue;
+		}
+		Code[instruction].Operand = target;
+	}
+	// empty statements share first instruction with next one
+	for (const int instruction : _statements | std::views::values) {
+		if (Statements.empty() || Statements.back() != instruction) {
+			Statements.push_back(instruction);
+		}
+	}
+	Statements.shrink_to_fit();
+	_statements.clear();
+	_statements.shrink_to_fit();
+	_jumps.clear();
+	_jumps.shrink_to_fit();
+	Code.shrink_to_fit();
+	return valid;
+}
+
+void Program::Error(const std::string& message)
+{
+	Console::WriteLine("Program '" + Name + "' - " + message + " at byte " + std::to_string(_code->GetPosition()));
+	_valid = false;
+}
+
+void Program::Emit(const Instruction::Opcode op, const Uint8 a, const Uint8 b, const Uint8 c, const int operand)
+{
+	Code.push_back(Instruction{ op, a, b, c, operand });
+	// profiler reports can be mapped back to bytecode
+	Offsets.push_back(_statements.back().first);
+}
+
+bool Program::DecodeValue()
+{
+	switch (_code->GetNextCommand()) {
+	case COMMAND::FUNCTION:
+		DecodeFunction();
+		return true;
+	case COMMAND::LOCAL_VARIABLE: {
+		const Uint8 type = _code->GetBit();
+		const Uint8 index = _code->GetBit();
+		Emit(OPCODE::PUSH_LOCAL, type, index);
+	}return true;
+	case COMMAND::VALUE:
+		return DecodeLiteral();
+	case COMMAND::NULL_VALUE:
+		// do nothing
+		return false;
+	default:
+		Error("expected value but command " + std::to_string(_code->Current()) + " is given");
+		return false;
+	}
+}
+
+void Program::DecodeFunction()
+{
+	const Uint8 function_index = _code->GetBit();
+	const Uint8 args = _code->GetBit();
+	Uint8 pushed = 0;
+	for (int i = 0; i < args; i++) {
+		if (DecodeValue()) pushed++;
+	}
+	Emit(OPCODE::CALL, args, pushed, 0, function_index);
+}
+
+void Program::DecodeIfTest()
+{
+	bool have_operator = false;
+	Uint8 operator_index = Instruction::NO_OPERATOR;
+	while (!_code->IsEnd()) {
+		switch (_code->GetNextCommand()) {
+		case COMMAND::LOCAL_VARIABLE: {
+			const Uint8 type = _code->GetBit();
+			const Uint8 index = _code->GetBit();
+			Emit(OPCODE::PUSH_LOCAL, type, index);
+		}break;
+
+		case COMMAND::OTHER: {
+			const Uint8 instance_type = _code->GetBit();
+			const Uint8 type = _code->GetBit();
+			const Uint8 index = _code->GetBit();
+			Emit(OPCODE::PUSH_OTHER, instance_type, type, index);
+		}break;
+
+		case COMMAND::FUNCTION:
+			DecodeFunction();
+			break;
+
+		case COMMAND::VALUE:
+			// value can be only on right side of operator
+			if (!have_operator) {
+				Emit(OPCODE::BREAK);
+			}
+			DecodeLiteral();
+			break;
+
+		case COMMAND::OPERATOR: {
+			const Uint8 index = _code->GetBit();
+			if (index > 7) {
+				Emit(OPCODE::BREAK);
+			}
+			operator_index = index;
+			have_operator = true;
+		}break;
+
+		case COMMAND::IF_BODY: {
+			const Uint8 type = _code->GetBit();
+			const unsigned char skip_2_bit[2]
+			{
+				_code->GetBit(), _code->GetBit()
+			};
+			unsigned int skip;
+			Convert::TwoByteCharToUint32(skip_2_bit, &skip);
+			Emit(OPCODE::IF, type, have_operator ? operator_index : Instruction::NO_OPERATOR);
+			_jumps.emplace_back(GetSize() - 1, _code->GetPosition() + static_cast<Sint64>(skip) + 1);
+			return;
+		}
+
+		default:
+			Error("unknown command " + std::to_string(_code->Current()) + " in if test");
+			return;
+		}
+	}
+	// if without body
+	Emit(OPCODE::BREAK);
+}
+
+bool Program::DecodeLiteral()
+{
+	const int type = static_cast<int>(_code->GetBit());
+	const std::string value = _code->GetString();
+	switch (type) {
+	case ArtCode::variable_type::INT:
+	case ArtCode::variable_type::OBJECT:
+	case ArtCode::variable_type::SPRITE:
+	case ArtCode::variable_type::TEXTURE:
+	case ArtCode::variable_type::SOUND:
+	case ArtCode::variable_type::MUSIC:
+	case ArtCode::variable_type::FONT:
+		Emit(OPCODE::PUSH_INT, 0, 0, 0, Func::TryGetInt(value));
+		break;
+	case ArtCode::variable_type::FLOAT:
+		LiteralFloat.emplace_back(Func::TryGetFloat(value));
+		Emit(OPCODE::PUSH_FLOAT, 0, 0, 0, static_cast<int>(LiteralFloat.size()) - 1);
+		break;
+	case ArtCode::variable_type::BOOL:
+		Emit(OPCODE::PUSH_BOOL, 0, 0, 0, Convert::Str2Bool(value) ? 1 : 0);
+		break;
+	case ArtCode::variable_type::INSTANCE:
+		// instance id, can be resolved only in runtime
+		Emit(OPCODE::PUSH_INSTANCE, 0, 0, 0, Func::TryGetInt(value));
+		break;
+	case ArtCode::variable_type::POINT:
+		LiteralPoint.emplace_back(Convert::Str2FPoint(value));
+		Emit(OPCODE::PUSH_POINT, 0, 0, 0, static_cast<int>(LiteralPoint.size()) - 1);
+		break;
+	case ArtCode::variable_type::RECT:
+		LiteralRect.emplace_back(Convert::Str2Rect(value));
+		Emit(OPCODE::PUSH_RECT, 0, 0, 0, static_cast<int>(LiteralRect.size()) - 1);
+		break;
+	case ArtCode::variable_type::COLOR:
+		LiteralColor.emplace_back(Convert::Hex2Color(value));
+		Emit(OPCODE::PUSH_COLOR, 0, 0, 0, static_cast<int>(LiteralColor.size()) - 1);
+		break;
+	case ArtCode::variable_type::STRING:
+		LiteralString.emplace_back(value);
+		LiteralStringId.emplace_back(StringInterner::Intern(value));
+		Emit(OPCODE::PUSH_STRING, 0, 0, 0, static_cast<int>(LiteralString.size()) - 1);
+		break;
+	case ArtCode::variable_type::ENUM:
+		// editor is responsible for enum, nothing to push
+		return false;
+	default:
+		Error("unknown value type " + std::to_string(type));
+		return false;
+	}
+	return true;
+}
+
+int Program::Fuse()
+{
+	const int size = GetSize();
+	// instruction can be fused only with rest of own statement
+	std::vector<bool> statement_start(size + 1, false);
+	for (const int statement : Statements) {
+		statement_start[statement] = true;
+	}
+	const auto inside = [&](const int i, const int count)
+	{
+		if (i + count > size) return false;
+		for (int next = i + 1; next < i + count; next++) {
+			if (statement_start[next]) return false;
+		}
+		return true;
+	};
+
+	std::vector<Instruction> fused;
+	fused.reserve(Code.size());
+	std::vector<Sint64> fused_offsets;
+	fused_offsets.reserve(Offsets.size());
+	Sint64 offset = 0;
+	// old instruction index -> new one, removed instruction point to next kept
+	std::vector<int> remap(size + 1, 0);
+	int i = 0;
+	while (i < size) {
+		const Instruction& first = Code[i];
+		remap[i] = static_cast<int>(fused.size());
+		// instructions pushed in previous pass are from statement of its first instruction
+		fused_offsets.resize(fused.size(), offset);
+		offset = Offsets[i];
+
+		// set var := local
+		if (first.Op == OPCODE::PUSH_LOCAL && inside(i, 2)
+			&& Code[i + 1].Op == OPCODE::SET && Code[i + 1].B == first.A) {
+			const Instruction& set = Code[i + 1];
+			fused.push_back(Instruction{ OPCODE::SET_LOCAL, set.A, set.B, set.C, first.B });
+			remap[i + 1] = static_cast<int>(fused.size());
+			Fused += 2;
+			i += 2;
+			continue;
+		}
+
+		// set var += function()
+		if (first.Op == OPCODE::CALL && inside(i, 2) && Code[i + 1].Op == OPCODE::SET) {
+			const Instruction& set = Code[i + 1];
+			fused.push_back(Instruction{ OPCODE::CALL_SET, set.A, set.B, set.C, first.Operand });
+			remap[i + 1] = static_cast<int>(fused.size());
+			Fused += 2;
+			i += 2;
+			continue;
+		}
+
+		// if local <operator> value
+		if (first.Op == OPCODE::PUSH_LOCAL && inside(i, 3) && Code[i + 2].Op == OPCODE::IF) {
+			const Instruction& value = Code[i + 1];
+			const Instruction& test = Code[i + 2];
+			// every compare operator except || and && is valid for int and float
+			const bool int_value = first.A == ArtCode::variable_type::INT && value.Op == OPCODE::PUSH_INT;
+			const bool float_value = first.A == ArtCode::variable_type::FLOAT && value.Op == OPCODE::PUSH_FLOAT;
+			if ((int_value || float_value) && test.A == first.A && test.B >= 2 && test.B <= 7) {
+				fused.push_back(Instruction{ OPCODE::IF_LOCAL, test.B, first.A, first.B, value.Operand });
+				remap[i + 1] = static_cast<int>(fused.size());
+				// if stay as data for jump target
+				remap[i + 2] = static_cast<int>(fused.size());
+				fused.push_back(test);
+				Fused += 3;
+				i += 3;
+				continue;
+			}
+		}
+
+		fused.push_back(first);
+		i++;
+	}
+	remap[size] = static_cast<int>(fused.size());
+	fused_offsets.resize(fused.size(), offset);
+
+	if (Fused == 0) return 0;
+	for (Instruction& instruction : fused) {
+		if (instruction.Op == OPCODE::IF || instruction.Op == OPCODE::ELSE) {
+			instruction.Operand = remap[instruction.Operand];
+		}
+	}
+	for (int& statement : Statements) {
+		statement = remap[statement];
+	}
+	Code = std::move(fused);
+	Code.shrink_to_fit();
+	Offsets = std::move(fused_offsets);
+	Handlers.clear();
+	return Fused;
+}
+
+void Program::Remove(const std::vector<bool>& removed)
+{
+	const int size = GetSize();
+	std::vector<Instruction> kept;
+	kept.reserve(Code.size());
+	std::vector<Sint64> kept_offsets;
+	kept_offsets.reserve(Offsets.size());
+	std::vector<int> remap(size + 1, 0);
+	for (int i = 0; i < size; i++) {
+		remap[i] = static_cast<int>(kept.size());
+		if (!removed[i]) {
+			kept.push_back(Code[i]);
+			kept_offsets.push_back(Offsets[i]);
+		}
+	}
+	remap[size] = static_cast<int>(kept.size());
+	if (kept.size() == Code.size()) return;
+
+	for (Instruction& instruction : kept) {
+		if (instruction.Op == OPCODE::IF || instruction.Op == OPCODE::ELSE) {
+			instruction.Operand = remap[instruction.Operand];
+		}
+	}
+	for (int& statement : Statements) {
+		statement = remap[statement];
+	}
+	Code = std::move(kept);
+	Offsets = std::move(kept_offsets);
+	Handlers.clear();
+}
+
+void Program::Thread(const OpHandler* table)
+{
+	Handlers.resize(Code.size());
+	for (size_t i = 0; i < Code.size(); i++) {
+		Handlers[i] = table[static_cast<int>(Code[i].Op)];
+	}
+}
+
+int Program::ResolveJump(const Sint64 position) const
+{
+	// first statement that starts on or after position, jump past end go to END
+	const auto it = std::lower_bound(_statements.begin(), _statements.end(), position,
+		[](const std::pair<Sint64, int>& statement, const Sint64 value) { return statement.first < value; });
+	if (it == _statements.end()) {
+		return GetSize() - 1;
+	}
+	return it->second;
+}
+
+#undef OPCODE
+#undef COMMAND
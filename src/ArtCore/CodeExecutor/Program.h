@@ -0,0 +1,167 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "ArtCode.h"
+#include "Inspector.h"
+#include "ArtCore/Structs/Rect.h"
+#include "ArtCore/System/StringInterner.h"
+
+// Interpreter core, can be changed in build settings
+// 1 - direct threaded, every instruction have pointer to own handler resolved at load time
+// 0 - switch over opcode
+#ifndef ART_CODE_THREADED_DISPATCH
+#define ART_CODE_THREADED_DISPATCH 1
+#endif
+
+// Per instruction checks, every program is verified at load time so they are not needed
+// 1 - checks are compiled out, only verified programs can be executed
+// 0 - interpreter assert operands while running
+#ifndef ART_CODE_UNCHECKED
+#ifdef _DEBUG
+#define ART_CODE_UNCHECKED 0
+#else
+#define ART_CODE_UNCHECKED 1
+#endif
+#endif
+
+// every opcode, used to generate Opcode enum and executor handlers
+#define ART_CODE_OPCODES(X) \
+	/* push literal, Operand is value or index in literal pool */ \
+	X(PUSH_INT) \
+	X(PUSH_FLOAT) \
+	X(PUSH_BOOL) \
+	X(PUSH_INSTANCE) \
+	X(PUSH_POINT) \
+	X(PUSH_RECT) \
+	X(PUSH_COLOR) \
+	X(PUSH_STRING) \
+	/* A - type, B - index */ \
+	X(PUSH_LOCAL) \
+	/* A - instance definition, B - type, C - index */ \
+	X(PUSH_OTHER) \
+	/* A - arguments count, B - count of pushed arguments (null is not pushed), Operand - function index */ \
+	X(CALL) \
+	/* A - operator, B - type, C - index */ \
+	X(SET) \
+	/* A - instance definition, B - type, C - index, Operand - operator */ \
+	X(SET_OTHER) \
+	/* A - type, B - compare operator or NO_OPERATOR, Operand - jump if false */ \
+	X(IF) \
+	/* Operand - jump if last if test was true */ \
+	X(ELSE) \
+	/* stop script, used when bytecode is valid but script can not continue */ \
+	X(BREAK) \
+	X(END) \
+	/* superinstructions, created by Program::Fuse from verified code */ \
+	/* PUSH_LOCAL + SET, A - operator, B - type, C - index, Operand - source index */ \
+	X(SET_LOCAL) \
+	/* CALL + SET, A - operator, B - type, C - index, Operand - function index */ \
+	X(CALL_SET) \
+	/* PUSH_LOCAL + PUSH_INT/PUSH_FLOAT + IF, A - compare operator, B - type, C - index, */ \
+	/* Operand - int value or float literal, next instruction is IF with jump target */ \
+	X(IF_LOCAL)
+
+class CodeExecutor;
+class Instance;
+struct ExecutionContext;
+struct ProgramFrame;
+
+// ArtCode bytecode decoded once at load time. Every instruction have the same width,
+// operands are already resolved to numbers and literals are parsed to typed pool
+// so executor do not touch any string while script is running.
+struct Instruction final
+{
+	enum class Opcode : Uint8
+	{
+#define X(name) name,
+		ART_CODE_OPCODES(X)
+#undef X
+
+		// last enum to literate in loops
+		INVALID
+	};
+	static constexpr Uint8 NO_OPERATOR = 0xFF;
+	static const char* OpcodeName(Opcode op);
+
+	Opcode Op;
+	Uint8 A;
+	Uint8 B;
+	Uint8 C;
+	int Operand;
+};
+static_assert(sizeof(Instruction) == 8, "Instruction must be fixed width");
+
+class Program final
+{
+public:
+	// return false if script must stop
+	typedef bool (*OpHandler)(CodeExecutor*, ExecutionContext*, ProgramFrame*, Instance*, const Instruction&);
+
+	Program() = default;
+	// decode ArtCode chunk, return false if bytecode is broken
+	bool Decode(const unsigned char* code, Sint64 size, const std::string& name);
+
+	[[nodiscard]] const Instruction* GetCode() const { return Code.data(); }
+	[[nodiscard]] int GetSize() const { return static_cast<int>(Code.size()); }
+	// replace common sequences with superinstructions, return count of fused instructions
+	// code must be verified, fused code can not be verified again
+	int Fuse();
+	// remove marked instructions, jumps and statements move to next kept instruction
+	void Remove(const std::vector<bool>& removed);
+	// resolve handler of every instruction, table is indexed by Opcode
+	void Thread(const OpHandler* table);
+	[[nodiscard]] const OpHandler* GetHandlers() const { return Handlers.data(); }
+
+	std::string Name;
+	std::vector<Instruction> Code;
+	// byte position in ArtCode chunk of statement of every instruction, superinstruction have position of first fused one
+	std::vector<Sint64> Offsets;
+	std::vector<OpHandler> Handlers;
+	// first instruction of every statement, every jump target is one of them
+	std::vector<int> Statements;
+	// count of instructions replaced by superinstructions
+	int Fused = 0;
+
+	// typed literal pool
+	std::vector<float> LiteralFloat;
+	std::vector<SDL_FPoint> LiteralPoint;
+	std::vector<Rect> LiteralRect;
+	std::vector<SDL_Color> LiteralColor;
+	std::vector<std::string> LiteralString;
+	// interned id of every string literal, compare with other interned string is one integer test
+	std::vector<StringInterner::Id> LiteralStringId;
+private:
+	Inspector* _code = nullptr;
+	bool _valid = true;
+	// byte position of every statement -> first instruction of this statement
+	std::vector<std::pair<Sint64, int>> _statements;
+	// instruction index -> target byte position, resolved after decode
+	std::vector<std::pair<int, Sint64>> _jumps;
+
+	// print error with byte position of code, program will be rejected
+	void Error(const std::string& message);
+	void Emit(Instruction::Opcode op, Uint8 a = 0, Uint8 b = 0, Uint8 c = 0, int operand = 0);
+	// return false if value is null, null is not pushed on stack
+	bool DecodeValue();
+	void DecodeFunction();
+	void DecodeIfTest();
+	// return false if nothing is pushed
+	bool DecodeLiteral();
+	int ResolveJump(Sint64 position) const;
+};
+
+// position of executed program, can be copied to suspend and continue script later
+struct ProgramFrame final
+{
+	const Program* Code = nullptr;
+	int Position = 0;
+	// break flag
+	bool Break = false;
+
+	ProgramFrame() = default;
+	explicit ProgramFrame(const Program* code)
+	{
+		Code = code;
+	}
+};
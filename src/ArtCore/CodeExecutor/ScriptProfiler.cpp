@@ -0,0 +1,146 @@
+#include "ScriptProfiler.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+#include "ExecutionContext.h"
+#include "Program.h"
+#include "ArtCore/Gui/Console.h"
+
+void ScriptProfiler::BeginScript(const Program* program)
+{
+	auto [it, added] = _scripts.try_emplace(program, static_cast<int>(_scripts_entries.size()));
+	if (added) {
+		_scripts_names.push_back(program->Name);
+		_scripts_entries.emplace_back();
+	}
+	Begin(it->second, false);
+}
+
+void ScriptProfiler::BeginFunction(const int function_index)
+{
+	if (static_cast<size_t>(function_index) >= _functions_entries.size()) {
+		_functions_entries.resize(function_index + 1);
+	}
+	Begin(function_index, true);
+}
+
+void ScriptProfiler::Begin(const int id, const bool function)
+{
+	_open.push_back({ id, function, SDL_GetPerformanceCounter(), 0, _instructions, 0 });
+}
+
+void ScriptProfiler::End()
+{
+	// profiler can be enabled while script is running
+	if (_open.empty()) return;
+	const Uint64 now = SDL_GetPerformanceCounter();
+	const Open open = _open.back();
+	_open.pop_back();
+
+	const Uint64 time = now - open.Start;
+	const Uint64 instructions = _instructions - open.Instructions;
+	Entry& entry = open.Function ? _functions_entries[open.Id] : _scripts_entries[open.Id];
+	entry.Calls++;
+	entry.Inclusive += time;
+	entry.Exclusive += time - open.ChildTime;
+	entry.Instructions += instructions - open.ChildInstructions;
+	if (!_open.empty()) {
+		_open.back().ChildTime += time;
+		_open.back().ChildInstructions += instructions;
+	}
+	if (_trace.size() < MAX_TRACE_EVENTS) {
+		_trace.push_back({ open.Id, open.Function, open.Start, time });
+	}
+}
+
+void ScriptProfiler::Reset()
+{
+	_open.clear();
+	_scripts.clear();
+	_scripts_names.clear();
+	_scripts_entries.clear();
+	_functions_entries.clear();
+	_trace.clear();
+	_instructions = 0;
+}
+
+std::string ScriptProfiler::Report(const std::span<ExecutionContext* const> contexts, const std::vector<std::string>& functions_names, const size_t lines)
+{
+	// merge by name, the same program have other index in every context
+	std::map<std::string, Entry> merged;
+	const auto add = [&](const std::string& name, const Entry& entry)
+	{
+		if (entry.Calls == 0) return;
+		Entry& target = merged[name];
+		target.Calls += entry.Calls;
+		target.Inclusive += entry.Inclusive;
+		target.Exclusive += entry.Exclusive;
+		target.Instructions += entry.Instructions;
+	};
+	for (const ExecutionContext* context : contexts) {
+		const ScriptProfiler& profiler = context->Profile;
+		for (size_t i = 0; i < profiler._scripts_entries.size(); i++) {
+			add(profiler._scripts_names[i], profiler._scripts_entries[i]);
+		}
+		for (size_t i = 0; i < profiler._functions_entries.size(); i++) {
+			add("fn " + (i < functions_names.size() ? functions_names[i] : std::to_string(i)), profiler._functions_entries[i]);
+		}
+	}
+	std::vector<std::pair<std::string, Entry>> sorted(merged.begin(), merged.end());
+	std::ranges::sort(sorted, [](const auto& a, const auto& b) { return a.second.Exclusive > b.second.Exclusive; });
+
+	const double ms = 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	std::ostringstream report;
+	report.setf(std::ios::fixed);
+	report.precision(3);
+	report << "exclusive ms | inclusive ms | calls | instructions | name\n";
+	for (size_t i = 0; i < sorted.size() && i < lines; i++) {
+		const Entry& entry = sorted[i].second;
+		report << static_cast<double>(entry.Exclusive) * ms << " | " << static_cast<double>(entry.Inclusive) * ms << " | "
+			<< entry.Calls << " | " << entry.Instructions << " | " << sorted[i].first << '\n';
+	}
+	return report.str();
+}
+
+bool ScriptProfiler::WriteTrace(const std::string& file, const std::span<ExecutionContext* const> contexts, const std::vector<std::string>& functions_names)
+{
+	SDL_RWops* output = SDL_RWFromFile(file.c_str(), "w");
+	if (output == nullptr) {
+		Console::WriteLine("ScriptProfiler: " + std::string(SDL_GetError()));
+		return false;
+	}
+	// trace event time is in microseconds
+	const double us = 1000000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	Uint64 origin = UINT64_MAX;
+	for (const ExecutionContext* context : contexts) {
+		for (const TraceEvent& event : context->Profile._trace) {
+			origin = std::min(origin, event.Start);
+		}
+	}
+
+	std::ostringstream json;
+	json.setf(std::ios::fixed);
+	json.precision(3);
+	json << "{\"traceEvents\":[";
+	bool first = true;
+	for (size_t tid = 0; tid < contexts.size(); tid++) {
+		const ScriptProfiler& profiler = contexts[tid]->Profile;
+		for (const TraceEvent& event : profiler._trace) {
+			const std::string& name = event.Function
+				? (static_cast<size_t>(event.Id) < functions_names.size() ? functions_names[event.Id] : std::to_string(event.Id))
+				: profiler._scripts_names[event.Id];
+			json << (first ? "" : ",") << "\n{\"name\":\"" << name << "\",\"cat\":\"" << (event.Function ? "function" : "script")
+				<< "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid
+				<< ",\"ts\":" << static_cast<double>(event.Start - origin) * us
+				<< ",\"dur\":" << static_cast<double>(event.Duration) * us << '}';
+			first = false;
+		}
+	}
+	json << "\n]}\n";
+	const std::string text = json.str();
+	SDL_RWwrite(output, text.c_str(), sizeof(char), text.length());
+	SDL_RWclose(output);
+	return true;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SDL2/IncludeAll.h"
+
+class Program;
+struct ExecutionContext;
+
+// Time of scripts and built-in functions, switched from console.
+// Every execution context record own data, report and trace merge all of them.
+// When profiler is disabled executor only test Enabled flag.
+class ScriptProfiler final
+{
+public:
+	static inline bool Enabled = false;
+
+	struct Entry
+	{
+		Uint64 Calls = 0;
+		// performance counter ticks
+		Uint64 Inclusive = 0;
+		Uint64 Exclusive = 0;
+		// interpreted instructions, native scripts do not count them
+		Uint64 Instructions = 0;
+	};
+
+	void BeginScript(const Program* program);
+	void BeginFunction(int function_index);
+	void End();
+	void CountInstruction() { _instructions++; }
+	void Reset();
+
+	// text table sorted by exclusive time, function names are given by index
+	static std::string Report(std::span<ExecutionContext* const> contexts, const std::vector<std::string>& functions_names, size_t lines);
+	// chrome trace event json (chrome://tracing), every context is one thread
+	static bool WriteTrace(const std::string& file, std::span<ExecutionContext* const> contexts, const std::vector<std::string>& functions_names);
+
+private:
+	struct Open
+	{
+		// index in _scripts_entries or function index
+		int Id;
+		bool Function;
+		Uint64 Start;
+		Uint64 ChildTime;
+		Uint64 Instructions;
+		Uint64 ChildInstructions;
+	};
+	struct TraceEvent
+	{
+		int Id;
+		bool Function;
+		Uint64 Start;
+		Uint64 Duration;
+	};
+	void Begin(int id, bool function);
+
+	std::vector<Open> _open;
+	// program can be deleted before report, so name is copied
+	std::unordered_map<const Program*, int> _scripts;
+	std::vector<std::string> _scripts_names;
+	std::vector<Entry> _scripts_entries;
+	std::vector<Entry> _functions_entries;
+	std::vector<TraceEvent> _trace;
+	Uint64 _instructions = 0;
+	static constexpr size_t MAX_TRACE_EVENTS = 1 << 20;
+};
@@ -5,7 +5,9 @@
 #include "ArtCore/Functions/Func.h"
 #include "ArtCore/Graphic/ColorDefinitions.h"
 #include "ArtCore/System/Core.h"
+#include "ArtCore/Scene/InstancePool.h"
 #include "ArtCore/Scene/Scene.h"
+#include "ArtCore/Scene/SceneSnapshot.h"
 #include <ArtCore/predefined_headers/consola.h>
 
 #include "ArtCore/main.h"
@@ -73,6 +75,7 @@ void Console::Execute(const std::string& command)
 	if (arg.empty()) return;
 	if(Core::Executor()->FunctionsMap.contains(arg[0]))
 	{
+		ExecutionContext* context = Core::Executor()->GetMainContext();
 		if(arg.size() > 1)
 		{
 			for (int i = 1; i < arg.size(); i++) {
@@ -80,35 +83,35 @@ void Console::Execute(const std::string& command)
 				if(argument.size() != 2)
 				{
 					WriteLine("Error: argument must be in TYPE|value style");
-					CodeExecutor::EraseGlobalStack();
+					context->Stack.Erase();
 					return;
 				}
 				switch (ArtCode::variable_type type = ArtCode::variable_type_fromString(argument[0])) {
-					case ArtCode::variable_type::INT:		CodeExecutor::GlobalStack_int.Add(Func::TryGetInt(argument[1])); break;
-					case ArtCode::variable_type::FLOAT: CodeExecutor::GlobalStack_float.Add(Func::TryGetFloat(argument[1])); break;
-					case ArtCode::variable_type::BOOL: CodeExecutor::GlobalStack_bool.Add( Convert::Str2Bool(argument[1])); break;
-					//case ArtCode::variable_type::INSTANCE: CodeExecutor::GlobalStack_instance.Add(); break;
-					//case ArtCode::variable_type::OBJECT:		CodeExecutor::GlobalStack_int.Add(Func::TryGetInt(argument[1])); break;
-					//case ArtCode::variable_type::SPRITE:		CodeExecutor::GlobalStack_int.Add(Func::TryGetInt(argument[1])); break;
-					//case ArtCode::variable_type::TEXTURE:	CodeExecutor::GlobalStack_int.Add(Func::TryGetInt(argument[1])); break;
-					//case ArtCode::variable_type::SOUND:		CodeExecutor::GlobalStack_int.Add(Func::TryGetInt(argument[1])); break;
-					//case ArtCode::variable_type::MUSIC:		CodeExecutor::GlobalStack_int.Add(Func::TryGetInt(argument[1])); break;
-					//case ArtCode::variable_type::FONT:		CodeExecutor::GlobalStack_int.Add(Func::TryGetInt(argument[1])); break;
-					case ArtCode::variable_type::POINT: CodeExecutor::GlobalStack_point.Add(Convert::Str2FPoint(argument[1])); break;
-					case ArtCode::variable_type::RECT: CodeExecutor::GlobalStack_rect.Add(Convert::Str2Rect(argument[1])); break;
-					case ArtCode::variable_type::COLOR: CodeExecutor::GlobalStack_color.Add(Convert::Hex2Color(argument[1])); break;
-					case ArtCode::variable_type::STRING: CodeExecutor::GlobalStack_string.Add(argument[1]); break;
+					case ArtCode::variable_type::INT:		context->Stack.PushInt(Func::TryGetInt(argument[1])); break;
+					case ArtCode::variable_type::FLOAT: context->Stack.PushFloat(Func::TryGetFloat(argument[1])); break;
+					case ArtCode::variable_type::BOOL: context->Stack.PushBool( Convert::Str2Bool(argument[1])); break;
+					//case ArtCode::variable_type::INSTANCE: context->Stack.PushInstance(); break;
+					//case ArtCode::variable_type::OBJECT:		context->Stack.PushInt(Func::TryGetInt(argument[1])); break;
+					//case ArtCode::variable_type::SPRITE:		context->Stack.PushInt(Func::TryGetInt(argument[1])); break;
+					//case ArtCode::variable_type::TEXTURE:	context->Stack.PushInt(Func::TryGetInt(argument[1])); break;
+					//case ArtCode::variable_type::SOUND:		context->Stack.PushInt(Func::TryGetInt(argument[1])); break;
+					//case ArtCode::variable_type::MUSIC:		context->Stack.PushInt(Func::TryGetInt(argument[1])); break;
+					//case ArtCode::variable_type::FONT:		context->Stack.PushInt(Func::TryGetInt(argument[1])); break;
+					case ArtCode::variable_type::POINT: context->Stack.PushPoint(Convert::Str2FPoint(argument[1])); break;
+					case ArtCode::variable_type::RECT: context->Stack.PushRect(Convert::Str2Rect(argument[1])); break;
+					case ArtCode::variable_type::COLOR: context->Stack.PushColor(Convert::Hex2Color(argument[1])); break;
+					case ArtCode::variable_type::STRING: context->Stack.PushString(argument[1]); break;
 				default:
 					{
 					WriteLine("Error: argument "+ arg[i]+" is invalid");
-					CodeExecutor::EraseGlobalStack();
+					context->Stack.Erase();
 					return;
 					}
 					}
 			}
 		}
-		Core::Executor()->FunctionsMap[arg[0]](nullptr);
-		CodeExecutor::EraseGlobalStack();
+		Core::Executor()->FunctionsMap[arg[0]](context, nullptr);
+		context->Stack.Erase();
 		WriteLine("Execute: " + command);
 	}else
 	{
@@ -118,6 +121,116 @@ void Console::Execute(const std::string& command)
 			Core::Exit();
 			return;
 		}
+		if(arg[0] == "step_budget")
+		{
+			if (arg.size() == 2) {
+				Core::SetStepBudget(Func::TryGetFloat(arg[1]));
+			}
+			WriteLine("step budget: " + std::to_string(Core::GetStepBudget()) + " ms, low priority steps delayed in last frame: " + std::to_string(Core::GetStepDelayedCount()));
+			return;
+		}
+		if(arg[0] == "profiler")
+		{
+			const std::string option = arg.size() >= 2 ? arg[1] : "";
+			if (option == "on" || option == "off") {
+				ScriptProfiler::Enabled = option == "on";
+				WriteLine("profiler: " + option);
+			}
+			else if (option == "reset") {
+				for (ExecutionContext* context : Core::GetExecutionContexts()) {
+					context->Profile.Reset();
+				}
+				WriteLine("profiler: reset");
+			}
+			else if (option == "report") {
+				const std::string report = ScriptProfiler::Report(Core::GetExecutionContexts(), Core::Executor()->GetFunctionsNames(), arg.size() == 3 ? Func::TryGetInt(arg[2]) : 20);
+				for (const std::string& line : Func::Split(report, '\n')) {
+					WriteLine(line);
+				}
+			}
+			else if (option == "trace" && arg.size() == 3) {
+				if (ScriptProfiler::WriteTrace(arg[2], Core::GetExecutionContexts(), Core::Executor()->GetFunctionsNames())) {
+					WriteLine("profiler: trace saved to " + arg[2]);
+				}
+			}
+			else {
+				WriteLine("Error: profiler on|off|reset|report [lines]|trace file");
+			}
+			return;
+		}
+		if(arg[0] == "opcodes")
+		{
+			const std::string option = arg.size() >= 2 ? arg[1] : "";
+			if (option == "on" || option == "off") {
+				OpcodeCounter::Enabled = option == "on";
+				WriteLine("opcodes: " + option);
+			}
+			else if (option == "reset") {
+				for (ExecutionContext* context : Core::GetExecutionContexts()) {
+					context->Counter.Reset();
+				}
+				WriteLine("opcodes: reset");
+			}
+			else if (option == "report") {
+				const std::string report = OpcodeCounter::Report(Core::GetExecutionContexts(), Core::Executor()->GetFunctionsNames(), arg.size() == 3 ? Func::TryGetInt(arg[2]) : 3);
+				for (const std::string& line : Func::Split(report, '\n')) {
+					WriteLine(line);
+				}
+			}
+			else {
+				WriteLine("Error: opcodes on|off|reset|report [programs]");
+			}
+			return;
+		}
+		if(arg[0] == "pool")
+		{
+			if (arg.size() == 2 && arg[1] == "trim") {
+				InstancePool::Trim();
+				WriteLine("pool: free instances deleted");
+			}
+			for (int definition = 0; definition < InstancePool::GetDefinitionsCount(); definition++) {
+				const InstancePool::Stats stats = InstancePool::GetStats(definition);
+				if (stats.HighWater == 0) continue;
+				WriteLine(Core::Executor()->GetInstanceDefinitionName(definition) + " live: " + std::to_string(stats.Live) + " free: " + std::to_string(stats.Free) + " high water: " + std::to_string(stats.HighWater));
+			}
+			const InstancePool::Stats total = InstancePool::GetStats();
+			WriteLine("pool total live: " + std::to_string(total.Live) + " free: " + std::to_string(total.Free) + " high water: " + std::to_string(total.HighWater));
+			return;
+		}
+		if(arg[0] == "snapshot")
+		{
+			// without file snapshot is kept in memory until next save
+			static std::vector<Uint8> memory_snapshot;
+			if (arg.size() < 2 || arg.size() > 3 || (arg[1] != "save" && arg[1] != "load")) {
+				WriteLine("Error: snapshot save|load [file]");
+				return;
+			}
+			const Uint64 start = SDL_GetPerformanceCounter();
+			bool result;
+			if (arg[1] == "save") {
+				result = arg.size() == 3 ? SceneSnapshot::SaveFile(arg[2]) : SceneSnapshot::Save(memory_snapshot);
+			}
+			else if (arg.size() == 3) {
+				result = SceneSnapshot::RestoreFile(arg[2]);
+			}
+			else if (memory_snapshot.empty()) {
+				WriteLine("snapshot: nothing saved");
+				return;
+			}
+			else {
+				result = SceneSnapshot::Restore(memory_snapshot);
+			}
+			if (result) {
+				const double time = static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+				WriteLine("snapshot " + arg[1] + ": " + std::to_string(time) + "ms" + (arg.size() == 3 ? "" : ", " + std::to_string(memory_snapshot.size()) + " bytes"));
+			}
+			return;
+		}
+		if(arg[0] == "benchmark")
+		{
+			Core::Executor()->Benchmark(arg.size() == 2 ? Func::TryGetInt(arg[1]) : 100000);
+			return;
+		}
 #ifdef _DEBUG
 		if(arg[0] == "spy")
 		{
@@ -1,7 +1,10 @@
 // ReSharper disable CppClangTidyClangDiagnosticSwitchEnum
 #include "Physics.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 #include "ArtCore/Functions/Func.h"
 #include "ArtCore/System/Core.h"
@@ -47,6 +50,47 @@ bool Physics::CollisionTest(const Instance* object1, const Instance* object2)
 		}
 	}
 }
+void Physics::UpdateBounds(const Instance* instance)
+{
+	float min_x = std::numeric_limits<float>::infinity();
+	float min_y = std::numeric_limits<float>::infinity();
+	float max_x = -std::numeric_limits<float>::infinity();
+	float max_y = -std::numeric_limits<float>::infinity();
+	if (instance->IsCollider) {
+		if (instance->Body.Type == Instance::BodyType::Rect) {
+			const Rect mask = instance->GetBodyMask();
+			min_x = std::min(mask.X, mask.W);
+			min_y = std::min(mask.Y, mask.H);
+			max_x = std::max(mask.X, mask.W);
+			max_y = std::max(mask.Y, mask.H);
+		}
+		else if (instance->Body.Type == Instance::BodyType::Circle) {
+			// the same radius as in TestCircle2Circle
+			const float radius = std::abs(instance->Body.Value * instance->SpriteScaleX + instance->Body.Value * instance->SpriteScaleY) / 2.f;
+			min_x = instance->PosX() - radius;
+			min_y = instance->PosY() - radius;
+			max_x = instance->PosX() + radius;
+			max_y = instance->PosY() + radius;
+		}
+	}
+	const InstanceComponents::Slot& slot = instance->GetComponents();
+	slot.Values->BoundsMinX[slot.Index] = min_x;
+	slot.Values->BoundsMinY[slot.Index] = min_y;
+	slot.Values->BoundsMaxX[slot.Index] = max_x;
+	slot.Values->BoundsMaxY[slot.Index] = max_y;
+}
+
+void Physics::UpdateBounds()
+{
+	for (size_t c = 0; c < InstanceComponents::GetChunksCount(); c++) {
+		const InstanceComponents::Chunk& chunk = InstanceComponents::GetChunk(c);
+		if (chunk.InSceneCount == 0) continue;
+		for (int i = 0; i < chunk.Used; i++) {
+			if (chunk.InScene[i]) UpdateBounds(chunk.Owner[i]);
+		}
+	}
+}
+
 bool Physics::TestRect2Rect(const Instance* object1, const Instance* object2)
 {
 	const SDL_FRect object1_collision_rect = object1->GetBodyMask().ToSDL_FRect_wh();
@@ -56,15 +100,15 @@ bool Physics::TestRect2Rect(const Instance* object1, const Instance* object2)
 bool Physics::TestRect2Circle(const Instance* object1, const Instance* object2)
 {
 	const float object2_radius = (object2->Body.Value * object2->SpriteScaleX + object2->Body.Value * object2->SpriteScaleY) / 2.f;
-	return CollisionCircle2Rect( object2->PosX, object2->PosY, object2_radius, object1->GetBodyMask());
+	return CollisionCircle2Rect( object2->PosX(), object2->PosY(), object2_radius, object1->GetBodyMask());
 }
 bool Physics::TestCircle2Circle(const Instance* object1, const Instance* object2)
 {
 	const float object1_radius = (object1->Body.Value * object1->SpriteScaleX + object1->Body.Value * object1->SpriteScaleY ) /2.f;
 	const float object2_radius = (object2->Body.Value * object2->SpriteScaleX + object2->Body.Value * object2->SpriteScaleY) / 2.f;
 	return CollisionCircle2Circle(
-		object1->PosX, object1->PosY, object1_radius,
-		object2->PosX, object2->PosY, object2_radius
+		object1->PosX(), object1->PosY(), object1_radius,
+		object2->PosX(), object2->PosY(), object2_radius
 	);
 }
 
@@ -82,7 +126,7 @@ void Physics::BounceInstance(Instance* object1, Instance* object2)
 	if (object2->Body.Type == Instance::BodyType::None) return;
 
 	// direction vector
-	vec2f sender_direction_vec = Func::GetDirectionVector(object1->Direction);
+	vec2f sender_direction_vec = Func::GetDirectionVector(object1->Direction());
 	// direction of collision vector, if value is -1 then direction id opposite
 	vec2f collision_direction_vector(1.f, 1.f);
 	//Instance::BodyType::Sprite is copied to circle or rect on create
@@ -122,12 +166,12 @@ void Physics::BounceInstance(Instance* object1, Instance* object2)
 	}
 
 	sender_direction_vec *= collision_direction_vector;
-	object1->Direction = Func::GetVectorFromDirection(sender_direction_vec);
+	object1->Direction() = Func::GetVectorFromDirection(sender_direction_vec);
 
 	// move 1 unit to avoid mistakes
-	const float direction_to_object_2 = std::atan2f(object2->PosY - object1->PosY, object2->PosX - object1->PosX);
-	object1->PosX -= std::cosf(direction_to_object_2);
-	object1->PosY -= std::sinf(direction_to_object_2);
+	const float direction_to_object_2 = std::atan2f(object2->PosY() - object1->PosY(), object2->PosX() - object1->PosX());
+	object1->PosX() -= std::cosf(direction_to_object_2);
+	object1->PosY() -= std::sinf(direction_to_object_2);
 	
 }
 void Physics::BounceRectRect(vec2f& collision_vector, const Instance* object1, const Instance* object2)
@@ -215,10 +259,10 @@ void Physics::BounceCircleRect(vec2f& collision_vector, const Instance* object1,
 	const float object2RightBoundary = object2BodyMask.W;
 
 	const float radius_scale = object1->Body.Value * ((object1->SpriteScaleX + object1->SpriteScaleY) / 2.f);
-	const float object1UpBoundary = object1->PosY - radius_scale;
-	const float object1DownBoundary = object1->PosY + radius_scale;
-	const float object1LeftBoundary = object1->PosX - radius_scale;
-	const float object1RightBoundary = object1->PosX + radius_scale;
+	const float object1UpBoundary = object1->PosY() - radius_scale;
+	const float object1DownBoundary = object1->PosY() + radius_scale;
+	const float object1LeftBoundary = object1->PosX() - radius_scale;
+	const float object1RightBoundary = object1->PosX() + radius_scale;
 
 	bool LM = (object1RightBoundary > object2LeftBoundary) &&( object1RightBoundary < object2RightBoundary);
 	bool RM = (object1LeftBoundary < object2RightBoundary) &&( object1LeftBoundary > object2LeftBoundary);
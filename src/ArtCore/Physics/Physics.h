@@ -6,6 +6,10 @@ class Physics
 public:
 	// check if two objects have collision
 	static bool CollisionTest(const Instance* object1, const Instance* object2);
+	// broadphase bounds in instance components, empty if instance can not collide
+	static void UpdateBounds(const Instance* instance);
+	// bounds of every instance in scene
+	static void UpdateBounds();
 	// Change direction of object1 as its bounce of object2
 	static void BounceInstance(Instance* object1, Instance* object2);
 
@@ -14,14 +14,9 @@ Instance::Instance(const int instance_definition_id)
 	this->Tag = "undefined";
 	this->Name = "no_name";
 
-	this->InView = false;
-	this->Alive = true;
+	// position, direction and state have default values in component slot
 	this->IsCollider = false;
 
-	this->PosX = 0.0f;
-	this->PosY = 0.0f;
-	this->Direction = 0.0f;
-
 	this->SelfSprite = nullptr;
 	this->SpriteScaleX = 1.0f;
 	this->SpriteScaleY = 1.0f;
@@ -33,8 +28,10 @@ Instance::Instance(const int instance_definition_id)
 	this->SpriteAnimationSpeed = 60.0f;
 	this->SpriteAnimationLoop = true;
 	this->EventFlag = event_bit::NONE;
+	this->StepDelayedTime = 0.0;
 
 	this->_have_suspended_code = false;
+	this->_suspended_code_first = -1;
 }
 
 Instance* Instance::GiveId()
@@ -43,9 +40,18 @@ Instance* Instance::GiveId()
 	return this;
 }
 
+void Instance::SetInScene(const bool in_scene)
+{
+	if (_components.Values->InScene[_components.Index] != in_scene) {
+		_components.Values->InSceneCount += in_scene ? 1 : -1;
+	}
+	_components.Values->InScene[_components.Index] = in_scene;
+	_components.Values->Owner[_components.Index] = in_scene ? this : nullptr;
+}
+
 void Instance::Delete()
 {
-	Alive = false;
+	Alive() = false;
 	if(_have_suspended_code > 0)
 	{
 		CodeExecutor::SuspendedCodeDeleteInstance(this);
@@ -89,13 +95,13 @@ void Instance::DrawSelf()
 	if (!SpriteAnimationLoop && SpriteAnimationFrame > float(SelfSprite->GetMaxFrame())) {
 		SpriteAnimationSpeed = 0.0f;
 	}
-	Render::DrawSprite_ex(SelfSprite, PosX, PosY , (int)SpriteAnimationFrame,  SpriteScaleX, SpriteScaleY, (float)SpriteCenterX, (float)SpriteCenterY, SpriteAngle, 1.0f);
+	Render::DrawSprite_ex(SelfSprite, PosX(), PosY() , (int)SpriteAnimationFrame,  SpriteScaleX, SpriteScaleY, (float)SpriteCenterX, (float)SpriteCenterY, SpriteAngle, 1.0f);
 }
 
 bool Instance::CheckMaskClick(SDL_FPoint& point) const
 {
 	if (SelfSprite == nullptr) return false;
-	if (InView == false) return false;
+	if (InView() == false) return false;
 
 	const Sprite::mask_type MaskType = SelfSprite->GetMaskType();
 	if (MaskType == Sprite::mask_type::None) return false;
@@ -105,18 +111,18 @@ bool Instance::CheckMaskClick(SDL_FPoint& point) const
 
 	if (MaskType == Sprite::mask_type::Circle) {
 		SDL_FPoint spoint{ 
-			PosX + SelfSprite->GetCenterXRel(),
-			PosY + SelfSprite->GetCenterYRel()
+			PosX() + SelfSprite->GetCenterXRel(),
+			PosY() + SelfSprite->GetCenterYRel()
 		};
 		const float distance = Func::Distance(point, spoint);
 		return (distance <= MaskValue);
 	}
 	if (MaskType == Sprite::mask_type::Rectangle) {
 		Rect spoint{
-			PosX - SelfSprite->GetMaskValue(),
-			PosY - SelfSprite->GetMaskValue(),
-			PosX + SelfSprite->GetMaskValue(),
-			PosY + SelfSprite->GetMaskValue()
+			PosX() - SelfSprite->GetMaskValue(),
+			PosY() - SelfSprite->GetMaskValue(),
+			PosX() + SelfSprite->GetMaskValue(),
+			PosY() + SelfSprite->GetMaskValue()
 		};
 		SDL_FPoint mov{ SelfSprite->GetCenterXRel(), SelfSprite->GetCenterYRel() };
 		spoint += mov;
@@ -133,17 +139,17 @@ Rect Instance::GetBodyMask() const
 	{
 	case BodyType::Circle:
 		return {
-		(PosX - Body.Value) * SpriteScaleX,
-			(PosY - Body.Value) * SpriteScaleY,
-			(PosX + Body.Value) * SpriteScaleX,
-			(PosY + Body.Value) * SpriteScaleY
+		(PosX() - Body.Value) * SpriteScaleX,
+			(PosY() - Body.Value) * SpriteScaleY,
+			(PosX() + Body.Value) * SpriteScaleX,
+			(PosY() + Body.Value) * SpriteScaleY
 		};
 	case BodyType::Rect:
 		return {
-		(PosX - Body.Value) * SpriteScaleX,
-			(PosY - Body.Value) * SpriteScaleY,
-			(PosX + Body.Value) * SpriteScaleX,
-			(PosY + Body.Value) * SpriteScaleY
+		(PosX() - Body.Value) * SpriteScaleX,
+			(PosY() - Body.Value) * SpriteScaleY,
+			(PosX() + Body.Value) * SpriteScaleX,
+			(PosY() + Body.Value) * SpriteScaleY
 		};
 	default:
 		return {};
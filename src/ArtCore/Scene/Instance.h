@@ -3,32 +3,54 @@
 
 #include "ArtCore/Enums/Event.h"
 #include "ArtCore/Graphic/Sprite.h"
+#include "ArtCore/Scene/InstanceComponents.h"
+#include "ArtCore/Scene/InstanceTable.h"
+#include "ArtCore/Scene/InstanceVariables.h"
+#include "ArtCore/System/StringInterner.h"
 #include "FC_Fontcache/SDL_FontCache.h"
 
 class Instance final
 {
+	// restore id and id counter
+	friend class SceneSnapshot;
+	// keep position of instance in its lists
+	friend class InstanceIndex;
 public:
 	explicit Instance(int instance_definition_id);
 	// do not use, this give unique id for instance
 	Instance* GiveId();
 
 	[[nodiscard]] Uint64 GetId() const { return _id; }
+	// handle in scene instance table, null if instance is not in scene
+	[[nodiscard]] InstanceHandle GetHandle() const { return _handle; }
+	void SetHandle(const InstanceHandle handle) { _handle = handle; }
 	void Delete();
 	[[nodiscard]] int GetInstanceDefinitionId() const {	return _instance_definition_id; }
 
 	void DrawSelf();
 	bool CheckMaskClick(SDL_FPoint&) const;
 
-	std::string Tag;
-	std::string Name;
+	// interned, copy of instance do not allocate and compare is one integer test
+	StringId Tag;
+	StringId Name;
 
-	bool InView;
-	bool Alive;
+	// hot values are kept in InstanceComponents, reference is valid while instance exists
+	bool& InView() { return _components.Values->InView[_components.Index]; }
+	[[nodiscard]] bool InView() const { return _components.Values->InView[_components.Index]; }
+	bool& Alive() { return _components.Values->Alive[_components.Index]; }
+	[[nodiscard]] bool Alive() const { return _components.Values->Alive[_components.Index]; }
 	bool IsCollider;
 
-	float PosX;
-	float PosY;
-	float Direction;
+	float& PosX() { return _components.Values->PosX[_components.Index]; }
+	[[nodiscard]] float PosX() const { return _components.Values->PosX[_components.Index]; }
+	float& PosY() { return _components.Values->PosY[_components.Index]; }
+	[[nodiscard]] float PosY() const { return _components.Values->PosY[_components.Index]; }
+	float& Direction() { return _components.Values->Direction[_components.Index]; }
+	[[nodiscard]] float Direction() const { return _components.Values->Direction[_components.Index]; }
+	[[nodiscard]] const InstanceComponents::Slot& GetComponents() const { return _components; }
+	// instance in scene colony is visited by component sweeps
+	void SetInScene(bool in_scene);
+	[[nodiscard]] bool IsInScene() const { return _components.Values->InScene[_components.Index]; }
 
 	Sprite* SelfSprite;
 	float SpriteScaleX;
@@ -41,21 +63,11 @@ public:
 	float SpriteAnimationSpeed;
 	bool SpriteAnimationLoop;
 
-	std::vector<int> Variables_int;
-	std::vector<float> Variables_float;
-	std::vector<bool> Variables_bool;
-	std::vector<Instance*> Variables_instance;
-	std::vector<int> Variables_object;
-	std::vector<int> Variables_sprite;
-	std::vector<int> Variables_texture;
-	std::vector<int> Variables_sound;
-	std::vector<int> Variables_music;
-	std::vector<int> Variables_font;
-	std::vector<Rect> Variables_rect;
-	std::vector<SDL_FPoint> Variables_point;
-	std::vector<SDL_Color> Variables_color;
-	std::vector<std::string> Variables_string;
+	// script variables, layout is given by instance definition
+	InstanceVariables Variables;
 	event_bit EventFlag;
+	// game time of step events delayed by frame budget, given to next executed step
+	double StepDelayedTime;
 
 	bool SuspendedCodeAdd();
 	bool SuspendedCodePop();
@@ -63,6 +75,9 @@ public:
 	[[nodiscard]] Uint8 SuspendedCodeStateCount() const { return _have_suspended_code;  }
 	// get info if have at least one suspended code
 	[[nodiscard]] bool SuspendedCodeStateHave() const { return _have_suspended_code > (uint8_t)0;  }
+	// first suspended frame in executor pool, -1 if none. Frames of one instance are linked
+	[[nodiscard]] int SuspendedCodeFirst() const { return _suspended_code_first; }
+	void SuspendedCodeSetFirst(const int slot) { _suspended_code_first = slot; }
 public:
 	struct BodyType {
 	public:
@@ -81,6 +96,11 @@ public:
 private:
 	Uint64 _id = 0;
 	static Uint64 _cid;
+	InstanceHandle _handle;
+	// position in scene tag and name index
+	Uint32 _index_position[static_cast<int>(InstanceIndex::Kind::COUNT)]{};
+	InstanceComponents::Slot _components;
 	int _instance_definition_id;
 	uint8_t _have_suspended_code;
+	int _suspended_code_first;
 };
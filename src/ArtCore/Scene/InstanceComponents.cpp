@@ -0,0 +1,81 @@
+#include "InstanceComponents.h"
+
+#include <limits>
+
+SDL_SpinLock InstanceComponents::_lock = 0;
+
+InstanceComponents::Store& InstanceComponents::GetStore()
+{
+	static Store* store = new Store();
+	return *store;
+}
+
+size_t InstanceComponents::GetChunksCount()
+{
+	return GetStore().Chunks.size();
+}
+
+InstanceComponents::Chunk& InstanceComponents::GetChunk(const size_t index)
+{
+	return *GetStore().Chunks[index];
+}
+
+InstanceComponents::Slot::Slot()
+{
+	Store& store = GetStore();
+	SDL_AtomicLock(&_lock);
+	if (!store.Free.empty()) {
+		Values = store.Free.back().first;
+		Index = store.Free.back().second;
+		store.Free.pop_back();
+	}
+	else {
+		if (store.Chunks.empty() || store.Chunks.back()->Used == CHUNK_SIZE) {
+			store.Chunks.push_back(std::make_unique<Chunk>());
+		}
+		Values = store.Chunks.back().get();
+		Index = Values->Used++;
+	}
+	SDL_AtomicUnlock(&_lock);
+
+	Values->PosX[Index] = 0.0f;
+	Values->PosY[Index] = 0.0f;
+	Values->Direction[Index] = 0.0f;
+	Values->Alive[Index] = true;
+	Values->InView[Index] = false;
+	Values->InScene[Index] = false;
+	Values->BoundsMinX[Index] = std::numeric_limits<float>::infinity();
+	Values->BoundsMinY[Index] = std::numeric_limits<float>::infinity();
+	Values->BoundsMaxX[Index] = -std::numeric_limits<float>::infinity();
+	Values->BoundsMaxY[Index] = -std::numeric_limits<float>::infinity();
+	Values->Owner[Index] = nullptr;
+}
+
+InstanceComponents::Slot::Slot(const Slot& other) : Slot()
+{
+	*this = other;
+}
+
+InstanceComponents::Slot& InstanceComponents::Slot::operator=(const Slot& other)
+{
+	if (this == &other) return *this;
+	Values->PosX[Index] = other.Values->PosX[other.Index];
+	Values->PosY[Index] = other.Values->PosY[other.Index];
+	Values->Direction[Index] = other.Values->Direction[other.Index];
+	Values->Alive[Index] = other.Values->Alive[other.Index];
+	Values->InView[Index] = other.Values->InView[other.Index];
+	return *this;
+}
+
+InstanceComponents::Slot::~Slot()
+{
+	// released slot is skipped by sweeps
+	if (Values->InScene[Index]) Values->InSceneCount--;
+	Values->InScene[Index] = false;
+	Values->Owner[Index] = nullptr;
+	Values->BoundsMinX[Index] = std::numeric_limits<float>::infinity();
+	Values->BoundsMaxX[Index] = -std::numeric_limits<float>::infinity();
+	SDL_AtomicLock(&_lock);
+	GetStore().Free.emplace_back(Values, Index);
+	SDL_AtomicUnlock(&_lock);
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "SDL2/IncludeAll.h"
+
+class Instance;
+
+// Hot per frame values of instances in struct of arrays. Every instance own one slot,
+// slot never move, so passes over scene can sweep arrays chunk by chunk without
+// touching Instance objects. Templates and pooled instances have slots too, they
+// are skipped by InScene.
+class InstanceComponents final
+{
+public:
+	static constexpr int CHUNK_SIZE = 256;
+	struct Chunk
+	{
+		float PosX[CHUNK_SIZE];
+		float PosY[CHUNK_SIZE];
+		float Direction[CHUNK_SIZE];
+		bool Alive[CHUNK_SIZE];
+		bool InView[CHUNK_SIZE];
+		// instance is in scene colony
+		bool InScene[CHUNK_SIZE];
+		// collider bounds from last physics broadphase, empty if not collider
+		float BoundsMinX[CHUNK_SIZE];
+		float BoundsMinY[CHUNK_SIZE];
+		float BoundsMaxX[CHUNK_SIZE];
+		float BoundsMaxY[CHUNK_SIZE];
+		// set only for slots in scene
+		Instance* Owner[CHUNK_SIZE];
+		// slots after this index were never used
+		int Used = 0;
+		// count of InScene slots, sweeps over scene skip chunk without them
+		int InSceneCount = 0;
+	};
+
+	// Slot of one instance, copy get new slot with the same values
+	class Slot final
+	{
+	public:
+		Slot();
+		Slot(const Slot& other);
+		// values are copied, slot is kept
+		Slot& operator=(const Slot& other);
+		~Slot();
+
+		Chunk* Values;
+		int Index;
+	};
+
+	// chunks for sweep, read chunk again after script execution because new chunk can be added
+	[[nodiscard]] static size_t GetChunksCount();
+	[[nodiscard]] static Chunk& GetChunk(size_t index);
+
+private:
+	struct Store
+	{
+		std::vector<std::unique_ptr<Chunk>> Chunks;
+		// released slots, used again before new one
+		std::vector<std::pair<Chunk*, int>> Free;
+	};
+	// never destroyed, instances can be deleted after static destructors
+	static Store& GetStore();
+	// scripts on worker threads can spawn instances
+	static SDL_SpinLock _lock;
+};
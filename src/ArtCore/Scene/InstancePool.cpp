@@ -0,0 +1,100 @@
+#include "InstancePool.h"
+
+#include <algorithm>
+
+#include "ArtCore/Scene/Instance.h"
+
+std::vector<InstancePool::Pool> InstancePool::_pools;
+SDL_SpinLock InstancePool::_lock = 0;
+
+Instance* InstancePool::Create(const Instance& definition_template)
+{
+	const int definition = definition_template.GetInstanceDefinitionId();
+	if (definition < 0) {
+		return (new Instance(definition_template))->GiveId();
+	}
+	Instance* instance = nullptr;
+	SDL_AtomicLock(&_lock);
+	if (static_cast<size_t>(definition) >= _pools.size()) {
+		_pools.resize(definition + 1);
+	}
+	Pool& pool = _pools[definition];
+	if (!pool.Free.empty()) {
+		instance = pool.Free.back();
+		pool.Free.pop_back();
+	}
+	pool.Live++;
+	pool.HighWater = std::max(pool.HighWater, pool.Live);
+	SDL_AtomicUnlock(&_lock);
+
+	if (instance == nullptr) {
+		instance = new Instance(definition_template);
+	}
+	else {
+		// layout is the same, values are copied to old block
+		*instance = definition_template;
+	}
+	return instance->GiveId();
+}
+
+void InstancePool::Release(Instance* instance)
+{
+	if (instance == nullptr) return;
+	const int definition = instance->GetInstanceDefinitionId();
+	if (definition < 0) {
+		delete instance;
+		return;
+	}
+	SDL_AtomicLock(&_lock);
+	SDL_assert(static_cast<size_t>(definition) < _pools.size());
+	Pool& pool = _pools[definition];
+	pool.Free.push_back(instance);
+	pool.Live--;
+	SDL_AtomicUnlock(&_lock);
+}
+
+void InstancePool::Trim()
+{
+	SDL_AtomicLock(&_lock);
+	for (Pool& pool : _pools) {
+		for (const Instance* instance : pool.Free) {
+			delete instance;
+		}
+		pool.Free.clear();
+		pool.Free.shrink_to_fit();
+	}
+	SDL_AtomicUnlock(&_lock);
+}
+
+InstancePool::Stats InstancePool::GetStats()
+{
+	Stats stats;
+	SDL_AtomicLock(&_lock);
+	for (const Pool& pool : _pools) {
+		stats.Live += pool.Live;
+		stats.Free += static_cast<int>(pool.Free.size());
+		stats.HighWater += pool.HighWater;
+	}
+	SDL_AtomicUnlock(&_lock);
+	return stats;
+}
+
+InstancePool::Stats InstancePool::GetStats(const int definition)
+{
+	Stats stats;
+	SDL_AtomicLock(&_lock);
+	if (definition >= 0 && static_cast<size_t>(definition) < _pools.size()) {
+		const Pool& pool = _pools[definition];
+		stats = { pool.Live, static_cast<int>(pool.Free.size()), pool.HighWater };
+	}
+	SDL_AtomicUnlock(&_lock);
+	return stats;
+}
+
+int InstancePool::GetDefinitionsCount()
+{
+	SDL_AtomicLock(&_lock);
+	const int count = static_cast<int>(_pools.size());
+	SDL_AtomicUnlock(&_lock);
+	return count;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+
+#include "SDL2/IncludeAll.h"
+
+class Instance;
+
+// Instances of one definition are reused after delete. Released instance keep own
+// variables block, so next spawn of the same definition only copy values from template.
+// Instances without definition (scene variable holder) are not pooled.
+class InstancePool final
+{
+public:
+	struct Stats
+	{
+		int Live = 0;
+		int Free = 0;
+		// most live instances at once
+		int HighWater = 0;
+	};
+
+	// copy of definition template with new id
+	static Instance* Create(const Instance& definition_template);
+	// instance can not be used after release
+	static void Release(Instance* instance);
+	// delete free instances, statistics are kept
+	static void Trim();
+
+	// sum of all definitions
+	[[nodiscard]] static Stats GetStats();
+	[[nodiscard]] static Stats GetStats(int definition);
+	[[nodiscard]] static int GetDefinitionsCount();
+
+private:
+	struct Pool
+	{
+		std::vector<Instance*> Free;
+		int Live = 0;
+		int HighWater = 0;
+	};
+	// index is instance definition id
+	static std::vector<Pool> _pools;
+	// scripts on worker threads can spawn instances
+	static SDL_SpinLock _lock;
+};
@@ -0,0 +1,88 @@
+#include "InstanceTable.h"
+
+#include "ArtCore/Scene/Instance.h"
+
+InstanceHandle InstanceTable::Add(Instance* instance)
+{
+	Uint32 index;
+	if (_free != NO_SLOT) {
+		index = _free;
+		_free = _slots[index].NextFree;
+	}
+	else {
+		index = static_cast<Uint32>(_slots.size());
+		_slots.emplace_back();
+	}
+	Slot& slot = _slots[index];
+	slot.Value = instance;
+	slot.NextFree = NO_SLOT;
+	const InstanceHandle handle{ index, slot.Generation };
+	instance->SetHandle(handle);
+	_ids[instance->GetId()] = index;
+	return handle;
+}
+
+void InstanceTable::Remove(Instance* instance)
+{
+	const InstanceHandle handle = instance->GetHandle();
+	if (Get(handle) != instance) return;
+	Slot& slot = _slots[handle.Index];
+	slot.Value = nullptr;
+	// generation 0 is null handle
+	if (++slot.Generation == 0) slot.Generation = 1;
+	slot.NextFree = _free;
+	_free = handle.Index;
+	_ids.erase(instance->GetId());
+	instance->SetHandle({});
+}
+
+void InstanceTable::Clear()
+{
+	// generations are kept, so handles from before clear stay stale
+	_free = NO_SLOT;
+	for (Uint32 index = static_cast<Uint32>(_slots.size()); index-- > 0;) {
+		Slot& slot = _slots[index];
+		if (slot.Value != nullptr) {
+			slot.Value = nullptr;
+			if (++slot.Generation == 0) slot.Generation = 1;
+		}
+		slot.NextFree = _free;
+		_free = index;
+	}
+	_ids.clear();
+}
+
+Instance* InstanceTable::GetById(const Uint64 id) const
+{
+	const auto it = _ids.find(id);
+	return it == _ids.end() ? nullptr : _slots[it->second].Value;
+}
+
+void InstanceIndex::Add(const StringInterner::Id key, Instance* instance)
+{
+	std::vector<Instance*>& instances = _instances[key];
+	instance->_index_position[_kind] = static_cast<Uint32>(instances.size());
+	instances.push_back(instance);
+}
+
+bool InstanceIndex::Remove(const StringInterner::Id key, const Instance* instance)
+{
+	const auto it = _instances.find(key);
+	if (it == _instances.end()) return false;
+	std::vector<Instance*>& instances = it->second;
+	// position is old if instance was removed or have other key
+	const Uint32 position = instance->_index_position[_kind];
+	if (position >= instances.size() || instances[position] != instance) return false;
+	Instance* moved = instances.back();
+	instances[position] = moved;
+	moved->_index_position[_kind] = position;
+	instances.pop_back();
+	return true;
+}
+
+void InstanceIndex::Clear()
+{
+	for (auto& [key, instances] : _instances) {
+		instances.clear();
+	}
+}
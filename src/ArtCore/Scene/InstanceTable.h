@@ -0,0 +1,85 @@
+#pragma once
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "SDL2/IncludeAll.h"
+#include "ArtCore/System/StringInterner.h"
+
+class Instance;
+
+// Reference to instance that can be kept between frames. Slot of deleted instance get
+// new generation, so old handle is detected as stale and never point to reused instance.
+struct InstanceHandle
+{
+	Uint32 Index = 0;
+	// 0 is null handle
+	Uint32 Generation = 0;
+
+	[[nodiscard]] bool IsNull() const { return Generation == 0; }
+	bool operator==(const InstanceHandle& other) const = default;
+};
+
+// Slot map of instances in scene, lookup by handle and by id do not scan instances.
+// Table is changed only from main thread, when instance is spawned or deleted.
+class InstanceTable final
+{
+public:
+	// handle is also stored in instance
+	InstanceHandle Add(Instance* instance);
+	// handles of instance become stale, do nothing if instance is not in table
+	void Remove(Instance* instance);
+	// every handle become stale
+	void Clear();
+
+	// nullptr if handle is stale
+	[[nodiscard]] Instance* Get(const InstanceHandle handle) const
+	{
+		if (handle.Index >= _slots.size()) return nullptr;
+		const Slot& slot = _slots[handle.Index];
+		return slot.Generation == handle.Generation ? slot.Value : nullptr;
+	}
+	[[nodiscard]] Instance* GetById(Uint64 id) const;
+	[[nodiscard]] int Size() const { return static_cast<int>(_ids.size()); }
+
+private:
+	static constexpr Uint32 NO_SLOT = UINT32_MAX;
+	struct Slot
+	{
+		Instance* Value = nullptr;
+		Uint32 Generation = 1;
+		Uint32 NextFree = NO_SLOT;
+	};
+	std::vector<Slot> _slots;
+	Uint32 _free = NO_SLOT;
+	// instance id -> slot
+	std::unordered_map<Uint64, Uint32> _ids;
+};
+
+// Live instances by interned string (tag or name), one key can have many instances.
+// Order of instances with the same key is not kept, removed one is replaced by last.
+// Instance keep its position in index of every kind, so remove do not scan the key.
+class InstanceIndex final
+{
+public:
+	enum class Kind { Tag, Name, COUNT };
+	explicit InstanceIndex(const Kind kind) : _kind(static_cast<int>(kind)) {}
+
+	void Add(StringInterner::Id key, Instance* instance);
+	// false if instance is not in index with this key
+	bool Remove(StringInterner::Id key, const Instance* instance);
+	// keys and capacity are kept, next scene do not allocate again
+	void Clear();
+
+	// view is valid until next Add or Remove
+	[[nodiscard]] std::span<Instance* const> Get(const StringInterner::Id key) const
+	{
+		const auto it = _instances.find(key);
+		if (it == _instances.end()) return {};
+		return it->second;
+	}
+
+private:
+	int _kind;
+	std::unordered_map<StringInterner::Id, std::vector<Instance*>> _instances;
+};
@@ -0,0 +1,198 @@
+#include "InstanceVariables.h"
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace
+{
+	struct TypeInfo
+	{
+		ArtCode::variable_type Type;
+		size_t Size;
+		size_t Alignment;
+	};
+	template <ArtCode::variable_type Type>
+	constexpr TypeInfo Info()
+	{
+		return { Type, sizeof(typename VariableValue<Type>::Type), alignof(typename VariableValue<Type>::Type) };
+	}
+	// biggest alignment first, so padding is only between groups
+	constexpr TypeInfo PlainTypes[] = {
+		Info<ArtCode::INSTANCE>(),
+		Info<ArtCode::INT>(), Info<ArtCode::OBJECT>(), Info<ArtCode::SPRITE>(), Info<ArtCode::TEXTURE>(),
+		Info<ArtCode::SOUND>(), Info<ArtCode::MUSIC>(), Info<ArtCode::FONT>(),
+		Info<ArtCode::FLOAT>(), Info<ArtCode::POINT>(),
+		Info<ArtCode::COLOR>(), Info<ArtCode::BOOL>()
+	};
+	// values with constructor, copied one by one
+	constexpr TypeInfo ConstructedTypes[] = {
+		Info<ArtCode::STRING>(), Info<ArtCode::LIST>(), Info<ArtCode::RECT>()
+	};
+	constexpr size_t BLOCK_ALIGNMENT = alignof(std::max_align_t);
+
+	constexpr size_t Align(const size_t offset, const size_t alignment)
+	{
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+
+	template <ArtCode::variable_type Type>
+	void Construct(Uint8* data, const Uint16 offset, const int count, const typename VariableValue<Type>::Type& value)
+	{
+		typedef typename VariableValue<Type>::Type T;
+		for (int i = 0; i < count; i++) {
+			new (data + offset + i * sizeof(T)) T(value);
+		}
+	}
+
+	template <ArtCode::variable_type Type>
+	void CopyConstruct(Uint8* data, const Uint16 offset, const Uint8* source, const Uint16 source_offset, const int count)
+	{
+		typedef typename VariableValue<Type>::Type T;
+		for (int i = 0; i < count; i++) {
+			new (data + offset + i * sizeof(T)) T(reinterpret_cast<const T*>(source + source_offset)[i]);
+		}
+	}
+
+	template <ArtCode::variable_type Type>
+	void Assign(Uint8* data, const Uint16 offset, const Uint8* source, const Uint16 source_offset, const int count)
+	{
+		typedef typename VariableValue<Type>::Type T;
+		for (int i = 0; i < count; i++) {
+			reinterpret_cast<T*>(data + offset)[i] = reinterpret_cast<const T*>(source + source_offset)[i];
+		}
+	}
+
+	template <ArtCode::variable_type Type>
+	void Destruct(Uint8* data, const Uint16 offset, const int count)
+	{
+		typedef typename VariableValue<Type>::Type T;
+		for (int i = 0; i < count; i++) {
+			reinterpret_cast<T*>(data + offset)[i].~T();
+		}
+	}
+}
+
+InstanceVariables::InstanceVariables(const Uint16* count)
+{
+	Header header{};
+	size_t size = Align(sizeof(Header), BLOCK_ALIGNMENT);
+	for (const TypeInfo& info : PlainTypes) {
+		size = Align(size, info.Alignment);
+		header.Offset[info.Type] = static_cast<Uint16>(size);
+		header.Count[info.Type] = count[info.Type];
+		size += info.Size * count[info.Type];
+	}
+	size = Align(size, BLOCK_ALIGNMENT);
+	header.PlainSize = static_cast<Uint16>(size);
+	for (const TypeInfo& info : ConstructedTypes) {
+		size = Align(size, info.Alignment);
+		header.Offset[info.Type] = static_cast<Uint16>(size);
+		header.Count[info.Type] = count[info.Type];
+		size += info.Size * count[info.Type];
+	}
+	// 255 variables of every type still fit
+	SDL_assert(size <= UINT16_MAX);
+	header.Size = static_cast<Uint16>(size);
+
+	_data = static_cast<Uint8*>(::operator new(size, std::align_val_t{ BLOCK_ALIGNMENT }));
+	std::memcpy(_data, &header, sizeof(Header));
+	Construct<ArtCode::INT>(_data, header.Offset[ArtCode::INT], count[ArtCode::INT], 0);
+	Construct<ArtCode::FLOAT>(_data, header.Offset[ArtCode::FLOAT], count[ArtCode::FLOAT], 0.0f);
+	Construct<ArtCode::BOOL>(_data, header.Offset[ArtCode::BOOL], count[ArtCode::BOOL], false);
+	Construct<ArtCode::INSTANCE>(_data, header.Offset[ArtCode::INSTANCE], count[ArtCode::INSTANCE], InstanceHandle());
+	Construct<ArtCode::OBJECT>(_data, header.Offset[ArtCode::OBJECT], count[ArtCode::OBJECT], -1);
+	Construct<ArtCode::SPRITE>(_data, header.Offset[ArtCode::SPRITE], count[ArtCode::SPRITE], -1);
+	Construct<ArtCode::TEXTURE>(_data, header.Offset[ArtCode::TEXTURE], count[ArtCode::TEXTURE], -1);
+	Construct<ArtCode::SOUND>(_data, header.Offset[ArtCode::SOUND], count[ArtCode::SOUND], -1);
+	Construct<ArtCode::MUSIC>(_data, header.Offset[ArtCode::MUSIC], count[ArtCode::MUSIC], -1);
+	Construct<ArtCode::FONT>(_data, header.Offset[ArtCode::FONT], count[ArtCode::FONT], -1);
+	Construct<ArtCode::POINT>(_data, header.Offset[ArtCode::POINT], count[ArtCode::POINT], SDL_FPoint{ 0.0f, 0.0f });
+	Construct<ArtCode::COLOR>(_data, header.Offset[ArtCode::COLOR], count[ArtCode::COLOR], SDL_Color{ 0, 0, 0, 0 });
+	Construct<ArtCode::STRING>(_data, header.Offset[ArtCode::STRING], count[ArtCode::STRING], std::string());
+	Construct<ArtCode::LIST>(_data, header.Offset[ArtCode::LIST], count[ArtCode::LIST], ArtList());
+	Construct<ArtCode::RECT>(_data, header.Offset[ArtCode::RECT], count[ArtCode::RECT], Rect());
+}
+
+InstanceVariables::InstanceVariables(const InstanceVariables& other)
+{
+	if (other._data == nullptr) return;
+	const Header* header = other.GetHeader();
+	_data = static_cast<Uint8*>(::operator new(header->Size, std::align_val_t{ BLOCK_ALIGNMENT }));
+	// header is copied too
+	std::memcpy(_data, other._data, header->PlainSize);
+	CopyConstruct<ArtCode::STRING>(_data, header->Offset[ArtCode::STRING], other._data, header->Offset[ArtCode::STRING], header->Count[ArtCode::STRING]);
+	CopyConstruct<ArtCode::LIST>(_data, header->Offset[ArtCode::LIST], other._data, header->Offset[ArtCode::LIST], header->Count[ArtCode::LIST]);
+	CopyConstruct<ArtCode::RECT>(_data, header->Offset[ArtCode::RECT], other._data, header->Offset[ArtCode::RECT], header->Count[ArtCode::RECT]);
+}
+
+InstanceVariables::InstanceVariables(InstanceVariables&& other) noexcept
+{
+	_data = std::exchange(other._data, nullptr);
+}
+
+InstanceVariables& InstanceVariables::operator=(const InstanceVariables& other)
+{
+	if (this == &other) return *this;
+	if (_data != nullptr && other._data != nullptr && std::memcmp(_data, other._data, sizeof(Header)) == 0) {
+		// same layout, reused instance keep block and capacity of strings
+		const Header* header = GetHeader();
+		std::memcpy(_data, other._data, header->PlainSize);
+		Assign<ArtCode::STRING>(_data, header->Offset[ArtCode::STRING], other._data, header->Offset[ArtCode::STRING], header->Count[ArtCode::STRING]);
+		Assign<ArtCode::LIST>(_data, header->Offset[ArtCode::LIST], other._data, header->Offset[ArtCode::LIST], header->Count[ArtCode::LIST]);
+		Assign<ArtCode::RECT>(_data, header->Offset[ArtCode::RECT], other._data, header->Offset[ArtCode::RECT], header->Count[ArtCode::RECT]);
+		return *this;
+	}
+	InstanceVariables copy(other);
+	*this = std::move(copy);
+	return *this;
+}
+
+InstanceVariables& InstanceVariables::operator=(InstanceVariables&& other) noexcept
+{
+	if (this != &other) {
+		Destroy();
+		_data = std::exchange(other._data, nullptr);
+	}
+	return *this;
+}
+
+InstanceVariables::~InstanceVariables()
+{
+	Destroy();
+}
+
+void InstanceVariables::Destroy()
+{
+	if (_data == nullptr) return;
+	const Header* header = GetHeader();
+	Destruct<ArtCode::STRING>(_data, header->Offset[ArtCode::STRING], header->Count[ArtCode::STRING]);
+	Destruct<ArtCode::LIST>(_data, header->Offset[ArtCode::LIST], header->Count[ArtCode::LIST]);
+	Destruct<ArtCode::RECT>(_data, header->Offset[ArtCode::RECT], header->Count[ArtCode::RECT]);
+	::operator delete(_data, std::align_val_t{ BLOCK_ALIGNMENT });
+	_data = nullptr;
+}
+
+void InstanceVariables::Add(const ArtCode::variable_type type)
+{
+	SDL_assert(type > ArtCode::NUL && type < TYPES && type != ArtCode::ENUM);
+	Uint16 count[TYPES]{};
+	if (_data != nullptr) {
+		std::memcpy(count, GetHeader()->Count, sizeof(count));
+	}
+	count[type]++;
+	InstanceVariables added(count);
+	if (_data != nullptr) {
+		// values already set are kept
+		const Header* header = GetHeader();
+		const Header* added_header = added.GetHeader();
+		for (const TypeInfo& info : PlainTypes) {
+			std::memcpy(added._data + added_header->Offset[info.Type], _data + header->Offset[info.Type], info.Size * header->Count[info.Type]);
+		}
+		Assign<ArtCode::STRING>(added._data, added_header->Offset[ArtCode::STRING], _data, header->Offset[ArtCode::STRING], header->Count[ArtCode::STRING]);
+		Assign<ArtCode::LIST>(added._data, added_header->Offset[ArtCode::LIST], _data, header->Offset[ArtCode::LIST], header->Count[ArtCode::LIST]);
+		Assign<ArtCode::RECT>(added._data, added_header->Offset[ArtCode::RECT], _data, header->Offset[ArtCode::RECT], header->Count[ArtCode::RECT]);
+	}
+	*this = std::move(added);
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <string>
+
+#include "SDL2/IncludeAll.h"
+#include "ArtCore/CodeExecutor/ArtCode.h"
+#include "ArtCore/CodeExecutor/ArtList.h"
+#include "ArtCore/Scene/InstanceTable.h"
+#include "ArtCore/Structs/Rect.h"
+
+// c++ type of ArtCode variable
+template <ArtCode::variable_type Type> struct VariableValue;
+template <> struct VariableValue<ArtCode::INT> { typedef int Type; };
+template <> struct VariableValue<ArtCode::FLOAT> { typedef float Type; };
+template <> struct VariableValue<ArtCode::BOOL> { typedef bool Type; };
+// instance is kept by handle, reference to deleted instance is detected
+template <> struct VariableValue<ArtCode::INSTANCE> { typedef InstanceHandle Type; };
+template <> struct VariableValue<ArtCode::OBJECT> { typedef int Type; };
+template <> struct VariableValue<ArtCode::SPRITE> { typedef int Type; };
+template <> struct VariableValue<ArtCode::TEXTURE> { typedef int Type; };
+template <> struct VariableValue<ArtCode::SOUND> { typedef int Type; };
+template <> struct VariableValue<ArtCode::MUSIC> { typedef int Type; };
+template <> struct VariableValue<ArtCode::FONT> { typedef int Type; };
+template <> struct VariableValue<ArtCode::POINT> { typedef SDL_FPoint Type; };
+template <> struct VariableValue<ArtCode::RECT> { typedef Rect Type; };
+template <> struct VariableValue<ArtCode::COLOR> { typedef SDL_Color Type; };
+template <> struct VariableValue<ArtCode::STRING> { typedef std::string Type; };
+template <> struct VariableValue<ArtCode::LIST> { typedef ArtList Type; };
+
+// Variables of one instance in one memory block. Block begin with offset of every type,
+// values of one type are next to each other. Layout is the same for every instance of
+// definition, so copy from template is one allocation and memcpy of plain values.
+class InstanceVariables final
+{
+public:
+	InstanceVariables() = default;
+	InstanceVariables(const InstanceVariables& other);
+	InstanceVariables(InstanceVariables&& other) noexcept;
+	InstanceVariables& operator=(const InstanceVariables& other);
+	InstanceVariables& operator=(InstanceVariables&& other) noexcept;
+	~InstanceVariables();
+
+	// add variable with default value, block is created again so use it only when definition is loaded
+	void Add(ArtCode::variable_type type);
+	[[nodiscard]] int Count(ArtCode::variable_type type) const
+	{
+		return _data == nullptr ? 0 : GetHeader()->Count[type];
+	}
+	// size of block in bytes
+	[[nodiscard]] int Size() const
+	{
+		return _data == nullptr ? 0 : GetHeader()->Size;
+	}
+
+	template <ArtCode::variable_type Type>
+	typename VariableValue<Type>::Type& Get(const int index)
+	{
+		return reinterpret_cast<typename VariableValue<Type>::Type*>(_data + GetHeader()->Offset[Type])[index];
+	}
+	template <ArtCode::variable_type Type>
+	const typename VariableValue<Type>::Type& Get(const int index) const
+	{
+		return reinterpret_cast<const typename VariableValue<Type>::Type*>(_data + GetHeader()->Offset[Type])[index];
+	}
+
+private:
+	static constexpr int TYPES = ArtCode::variable_typeEND;
+	// offsets are in bytes from begin of block
+	struct Header
+	{
+		Uint16 Offset[TYPES];
+		Uint16 Count[TYPES];
+		// values before this offset can be copied by memcpy
+		Uint16 PlainSize;
+		Uint16 Size;
+	};
+	Uint8* _data = nullptr;
+
+	[[nodiscard]] const Header* GetHeader() const { return reinterpret_cast<const Header*>(_data); }
+	// create block with default values
+	explicit InstanceVariables(const Uint16* count);
+	void Destroy();
+};
@@ -4,6 +4,7 @@
 #include "ArtCore/Functions/Func.h"
 #include "ArtCore/CodeExecutor/CodeExecutor.h"
 #include "ArtCore/Enums/Event.h"
+#include "ArtCore/Scene/InstancePool.h"
 #include "ArtCore/System/Core.h"
 #include "ArtCore/System/AssetManager.h"
 
@@ -30,8 +31,8 @@ void Scene::Clear()
 {
 	if (!InstanceColony.empty()) {
 		for (plf::colony<Instance*>::iterator it = InstanceColony.begin(); it != InstanceColony.end(); ) {
-			
-			delete (*it);
+			(*it)->SetInScene(false);
+			InstancePool::Release(*it);
 			it = InstanceColony.erase(it);
 		}
 	}
@@ -39,11 +40,20 @@ void Scene::Clear()
 
 	if (!_instances_new.empty()) {
 		for (std::vector<Instance*>::iterator it = _instances_new.begin(); it != _instances_new.end(); ) {
-			delete (*it);
+			InstancePool::Release(*it);
 			it = _instances_new.erase(it);
 		}
 	}
 	_instances_new.clear();
+	_instances_size = 0;
+	_is_any_new_instances = false;
+	InstanceHandles.Clear();
+	_instances_by_tag.Clear();
+	_instances_by_name.Clear();
+	for (std::vector<Instance*>& subscribers : _subscribers) {
+		subscribers.clear();
+	}
+	_instances_deleted = 0;
 }
 Scene::~Scene()
 {
@@ -147,12 +157,19 @@ Instance* Scene::CreateInstance(const std::string& name, const float x, const fl
 {
 	Instance* ins = Core::Executor()->SpawnInstance(name);
 	if (ins == nullptr) return nullptr;
-	ins->PosX = x;
-	ins->PosY = y;
+	ins->PosX() = x;
+	ins->PosY() = y;
+	InstanceHandles.Add(ins);
 	_instances_new.push_back(ins);
 	_is_any_new_instances = true;
 	return ins;
 }
+void Scene::AddNewInstances(const std::vector<Instance*>& instances)
+{
+	if (instances.empty()) return;
+	_instances_new.insert(_instances_new.end(), instances.begin(), instances.end());
+	_is_any_new_instances = true;
+}
 void Scene::SpawnAll()
 {
 	/*
@@ -165,11 +182,12 @@ void Scene::SpawnAll()
 	if (_is_any_new_instances) {
 		const size_t new_ins_size = _instances_new.size();
 		for(size_t i = 0; i < new_ins_size; i++){
-			InstanceColony.insert(_instances_new[i]);
-			_instances_size++;
+			AddToColony(_instances_new[i]);
 		}
 		for (size_t i = 0; i < new_ins_size; i++) {
-			Core::Executor()->ExecuteScript(_instances_new[i], Event::EvOnCreate);
+			if (Core::Executor()->HaveEvent(_instances_new[i], Event::EvOnCreate)) {
+				Core::Executor()->ExecuteScript(_instances_new[i], Event::EvOnCreate);
+			}
 		}
 		_instances_new.erase(_instances_new.begin(), _instances_new.begin() + new_ins_size);
 		_is_any_new_instances = !_instances_new.empty();
@@ -184,48 +202,103 @@ void Scene::Exit()
 
 Instance* Scene::GetInstanceById(const int id)
 {
-	for (Instance* instance : InstanceColony) {
-		if (instance->GetId() == id) return instance;
-	}
-	return nullptr;
+	return InstanceHandles.GetById(static_cast<Uint64>(id));
 }
 Instance* Scene::GetInstanceByTag(const std::string& tag)
 {
-	for (Instance* instance : InstanceColony) {
-		if (instance->Tag == tag) return instance;
-	}
-	return nullptr;
+	const std::span<Instance* const> instances = GetInstancesByTag(tag);
+	return instances.empty() ? nullptr : instances.front();
 }
 Instance* Scene::GetInstanceByName(const std::string& name)
 {
-	for (Instance* instance : InstanceColony) {
-		if (instance->Name == name) return instance;
-	}
-	return nullptr;
+	const std::span<Instance* const> instances = GetInstancesByName(name);
+	return instances.empty() ? nullptr : instances.front();
 }
-std::vector<Instance*> Scene::GetInstancesByTag(const std::string& tag)
+std::span<Instance* const> Scene::GetInstancesByTag(const std::string& tag)
 {
-	std::vector<Instance*> _return;
-	for (Instance* instance : InstanceColony) {
-		if (instance->Tag == tag) _return.push_back(instance);
-	}
-	return _return;
+	// string that is not interned is not used by any instance
+	const StringInterner::Id id = StringInterner::Find(tag);
+	if (id == StringInterner::NOT_FOUND) return {};
+	return _instances_by_tag.Get(id);
 }
-std::vector<Instance*> Scene::GetInstancesByName(const std::string& name)
+std::span<Instance* const> Scene::GetInstancesByName(const std::string& name)
 {
-	std::vector<Instance*> _return;
-	for (Instance* instance : InstanceColony) {
-		if (instance->Name == name) _return.push_back(instance);
-	}
-	return _return;
+	const StringInterner::Id id = StringInterner::Find(name);
+	if (id == StringInterner::NOT_FOUND) return {};
+	return _instances_by_name.Get(id);
+}
+void Scene::SetInstanceTag(Instance* instance, const StringId& tag)
+{
+	// new instance is not in index yet, it is added with current tag in SpawnAll
+	const bool in_scene = _instances_by_tag.Remove(instance->Tag.GetId(), instance);
+	instance->Tag = tag;
+	if (in_scene) _instances_by_tag.Add(tag.GetId(), instance);
 }
 
 plf::colony<Instance*>::iterator Scene::DeleteInstance(const plf::colony<Instance*>::iterator& ptr)
 {
 	_instances_size--;
+	InstanceHandles.Remove(*ptr);
+	_instances_by_tag.Remove((*ptr)->Tag.GetId(), *ptr);
+	_instances_by_name.Remove((*ptr)->Name.GetId(), *ptr);
+	(*ptr)->SetInScene(false);
 	return InstanceColony.erase(ptr);
 }
 
+void Scene::MarkInstanceDeleted(Instance* instance)
+{
+	instance->Delete();
+	_instances_deleted++;
+}
+
+void Scene::DeleteDeadInstances()
+{
+	if (_instances_deleted == 0) return;
+	for (plf::colony<Instance*>::iterator it = InstanceColony.begin(); it != InstanceColony.end();) {
+		Instance* instance = *it;
+		if (instance->Alive()) {
+			++it;
+			continue;
+		}
+		if (EVENT_BIT_TEST(event_bit::HAVE_ON_DESTROY, instance->EventFlag)) {
+			Core::Executor()->ExecuteScript(instance, Event::EvOnDestroy);
+		}
+		it = DeleteInstance(it);
+		InstancePool::Release(instance);
+	}
+	_instances_deleted = 0;
+	// instance released above can be already reused by spawn in OnDestroy, so test scene flag not pointer
+	for (std::vector<Instance*>& subscribers : _subscribers) {
+		std::erase_if(subscribers, [](const Instance* instance) { return !instance->IsInScene(); });
+	}
+}
+
+void Scene::AddToColony(Instance* instance)
+{
+	InstanceColony.insert(instance);
+	instance->SetInScene(true);
+	AddSubscriber(instance);
+	_instances_by_tag.Add(instance->Tag.GetId(), instance);
+	_instances_by_name.Add(instance->Name.GetId(), instance);
+	_instances_size++;
+}
+
+void Scene::AddSubscriber(Instance* instance)
+{
+	if (Core::Executor()->HaveEvent(instance, Event::EvStep)) {
+		_subscribers[static_cast<int>(Subscribers::Step)].push_back(instance);
+	}
+	if (Core::Executor()->HaveEvent(instance, Event::EvDraw)) {
+		_subscribers[static_cast<int>(Subscribers::Draw)].push_back(instance);
+	}
+	if (EVENT_BIT_TEST(event_bit::HAVE_MOUSE_EVENT, instance->EventFlag)) {
+		_subscribers[static_cast<int>(Subscribers::Mouse)].push_back(instance);
+	}
+	if (EVENT_BIT_TEST(event_bit::HAVE_COLLISION, instance->EventFlag)) {
+		_subscribers[static_cast<int>(Subscribers::Collision)].push_back(instance);
+	}
+}
+
 void Scene::SetTriggerData(const std::string& trigger, const unsigned char* data, Sint64 length)
 {
 	_trigger_data[trigger] = std::pair< const unsigned char*, Sint64>(data, length);
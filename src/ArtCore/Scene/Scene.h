@@ -1,4 +1,5 @@
 #pragma once
+#include <span>
 #include <vector>
 
 #include "Instance.h"
@@ -9,7 +10,8 @@
 class Instance;
 class Scene final
 {
-	
+	// restore instances without OnCreate
+	friend class SceneSnapshot;
 public:
 	Scene();
 	~Scene();
@@ -21,6 +23,8 @@ public:
 	void Exit();
 
 	Instance* CreateInstance(const std::string& name, float x, float y);
+	// instances are added to scene in next SpawnAll
+	void AddNewInstances(const std::vector<Instance*>& instances);
 	int GetWidth() const
 	{
 		return _width;
@@ -43,8 +47,11 @@ public:
 	Instance* GetInstanceByTag(const std::string&);
 	Instance* GetInstanceByName(const std::string&);
 
-	std::vector< Instance* > GetInstancesByTag(const std::string&);
-	std::vector < Instance* > GetInstancesByName(const std::string&);
+	// instances in scene, view is valid until instances are spawned, deleted or tag is changed
+	std::span<Instance* const> GetInstancesByTag(const std::string&);
+	std::span<Instance* const> GetInstancesByName(const std::string&);
+	// keep tag index updated, use it instead of setting Tag
+	void SetInstanceTag(Instance* instance, const StringId& tag);
 
 	// collision
 	Uint64 CurrentCollisionInstanceId;
@@ -88,10 +95,31 @@ public:
 	[[nodiscard]] bool IsAnyInstances() const { return _instances_size > 0; }
 	[[nodiscard]] int GetInstancesCount() const;
 	plf::colony<Instance*> InstanceColony{};
+	// every instance created for this scene, also new ones not in colony yet
+	InstanceTable InstanceHandles{};
 	plf::colony<Instance*>::iterator DeleteInstance(const plf::colony<Instance*>::iterator& ptr);
+	// instance is not alive now and is removed from scene in next step
+	void MarkInstanceDeleted(Instance* instance);
+	// execute OnDestroy and remove instances that are not alive, colony is visited only if any was marked
+	void DeleteDeadInstances();
+
+	// instances in colony that have event, in spawn order, phases visit only these
+	enum class Subscribers { Step, Draw, Mouse, Collision, COUNT };
+	[[nodiscard]] const std::vector<Instance*>& GetSubscribers(const Subscribers event) const
+	{
+		return _subscribers[static_cast<int>(event)];
+	}
 private:
 	int _instances_size;
 	std::vector<Instance*> _instances_new{};
+	// only instances from colony, new ones are added in SpawnAll
+	InstanceIndex _instances_by_tag{ InstanceIndex::Kind::Tag };
+	InstanceIndex _instances_by_name{ InstanceIndex::Kind::Name };
+	std::vector<Instance*> _subscribers[static_cast<int>(Subscribers::COUNT)]{};
+	int _instances_deleted = 0;
+	void AddSubscriber(Instance* instance);
+	// instance must have handle already
+	void AddToColony(Instance* instance);
 private:
 	// Object that holds all scene variables, must be this way
 	// because script system is designed this way
@@ -0,0 +1,494 @@
+#include "SceneSnapshot.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "ArtCore/CodeExecutor/CodeExecutor.h"
+#include "ArtCore/Gui/Console.h"
+#include "ArtCore/Scene/Instance.h"
+#include "ArtCore/Scene/InstancePool.h"
+#include "ArtCore/Scene/Scene.h"
+#include "ArtCore/Scene/SnapshotStream.h"
+#include "ArtCore/System/AssetManager.h"
+#include "ArtCore/System/Core.h"
+
+namespace
+{
+	typedef std::unordered_map<const Instance*, Uint32> InstanceIndexes;
+	constexpr Uint32 NO_INSTANCE = UINT32_MAX;
+
+	template <ArtCode::variable_type Type>
+	void WritePlain(SnapshotWriter& writer, const InstanceVariables& variables)
+	{
+		const int count = variables.Count(Type);
+		if (count > 0) {
+			writer.WriteBytes(&variables.Get<Type>(0), sizeof(typename VariableValue<Type>::Type) * count);
+		}
+	}
+
+	template <ArtCode::variable_type Type>
+	void ReadPlain(SnapshotReader& reader, InstanceVariables& variables)
+	{
+		const int count = variables.Count(Type);
+		if (count > 0) {
+			reader.ReadBytes(&variables.Get<Type>(0), sizeof(typename VariableValue<Type>::Type) * count);
+		}
+	}
+
+	template <typename T>
+	void WriteListValues(SnapshotWriter& writer, const std::vector<T>& values)
+	{
+		writer.Write(static_cast<Uint32>(values.size()));
+		if constexpr (std::is_same_v<T, std::string>) {
+			for (const std::string& value : values) writer.WriteString(value);
+		}
+		else {
+			writer.WriteBytes(values.data(), sizeof(T) * values.size());
+		}
+	}
+
+	template <typename T>
+	void ReadListValues(SnapshotReader& reader, ArtList& list)
+	{
+		const Uint32 size = reader.Read<Uint32>();
+		// every value take at least 4 bytes, broken size do not allocate
+		if (reader.Failed || size > reader.Remaining() / 4) {
+			reader.Failed = true;
+			return;
+		}
+		std::vector<T>& values = list.SetValues<T>();
+		values.resize(size);
+		if constexpr (std::is_same_v<T, std::string>) {
+			for (std::string& value : values) value = reader.ReadString();
+		}
+		else {
+			reader.ReadBytes(values.data(), sizeof(T) * values.size());
+		}
+	}
+
+	void WriteList(SnapshotWriter& writer, const ArtList& list)
+	{
+		writer.Write(static_cast<Uint8>(list.GetTypeIndex()));
+		if (const auto* values = list.GetValues<int>()) WriteListValues(writer, *values);
+		else if (const auto* values = list.GetValues<float>()) WriteListValues(writer, *values);
+		else if (const auto* values = list.GetValues<SDL_FPoint>()) WriteListValues(writer, *values);
+		else if (const auto* values = list.GetValues<std::string>()) WriteListValues(writer, *values);
+	}
+
+	void ReadList(SnapshotReader& reader, ArtList& list)
+	{
+		list.Clear();
+		// the same order as in ArtList variant
+		switch (reader.Read<Uint8>()) {
+		case 0: break;
+		case 1: ReadListValues<int>(reader, list); break;
+		case 2: ReadListValues<float>(reader, list); break;
+		case 3: ReadListValues<SDL_FPoint>(reader, list); break;
+		case 4: ReadListValues<std::string>(reader, list); break;
+		default: reader.Failed = true; break;
+		}
+	}
+
+	void WriteVariables(SnapshotWriter& writer, const InstanceVariables& variables, const InstanceIndexes& indexes)
+	{
+		// layout is tested on read, values of other definition version are not restored
+		for (int type = 0; type < ArtCode::variable_typeEND; type++) {
+			writer.Write(static_cast<Uint16>(variables.Count(static_cast<ArtCode::variable_type>(type))));
+		}
+		WritePlain<ArtCode::INT>(writer, variables);
+		WritePlain<ArtCode::FLOAT>(writer, variables);
+		for (int i = 0; i < variables.Count(ArtCode::BOOL); i++) {
+			writer.WriteBool(variables.Get<ArtCode::BOOL>(i));
+		}
+		WritePlain<ArtCode::OBJECT>(writer, variables);
+		WritePlain<ArtCode::SPRITE>(writer, variables);
+		WritePlain<ArtCode::TEXTURE>(writer, variables);
+		WritePlain<ArtCode::SOUND>(writer, variables);
+		WritePlain<ArtCode::MUSIC>(writer, variables);
+		WritePlain<ArtCode::FONT>(writer, variables);
+		WritePlain<ArtCode::POINT>(writer, variables);
+		WritePlain<ArtCode::COLOR>(writer, variables);
+		const Scene* scene = Core::GetCurrentScene();
+		for (int i = 0; i < variables.Count(ArtCode::INSTANCE); i++) {
+			// stale handle and instance that is not saved are null
+			const Instance* target = scene->InstanceHandles.Get(variables.Get<ArtCode::INSTANCE>(i));
+			const auto it = target == nullptr ? indexes.end() : indexes.find(target);
+			writer.Write(it == indexes.end() ? NO_INSTANCE : it->second);
+		}
+		for (int i = 0; i < variables.Count(ArtCode::STRING); i++) {
+			writer.WriteString(variables.Get<ArtCode::STRING>(i));
+		}
+		for (int i = 0; i < variables.Count(ArtCode::LIST); i++) {
+			WriteList(writer, variables.Get<ArtCode::LIST>(i));
+		}
+		for (int i = 0; i < variables.Count(ArtCode::RECT); i++) {
+			const Rect& rect = variables.Get<ArtCode::RECT>(i);
+			writer.Write(rect.X);
+			writer.Write(rect.Y);
+			writer.Write(rect.W);
+			writer.Write(rect.H);
+		}
+	}
+
+	bool ReadVariables(SnapshotReader& reader, InstanceVariables& variables, std::vector<std::pair<InstanceHandle*, Uint32>>& references)
+	{
+		for (int type = 0; type < ArtCode::variable_typeEND; type++) {
+			if (reader.Read<Uint16>() != variables.Count(static_cast<ArtCode::variable_type>(type))) return false;
+		}
+		ReadPlain<ArtCode::INT>(reader, variables);
+		ReadPlain<ArtCode::FLOAT>(reader, variables);
+		for (int i = 0; i < variables.Count(ArtCode::BOOL); i++) {
+			variables.Get<ArtCode::BOOL>(i) = reader.ReadBool();
+		}
+		ReadPlain<ArtCode::OBJECT>(reader, variables);
+		ReadPlain<ArtCode::SPRITE>(reader, variables);
+		ReadPlain<ArtCode::TEXTURE>(reader, variables);
+		ReadPlain<ArtCode::SOUND>(reader, variables);
+		ReadPlain<ArtCode::MUSIC>(reader, variables);
+		ReadPlain<ArtCode::FONT>(reader, variables);
+		ReadPlain<ArtCode::POINT>(reader, variables);
+		ReadPlain<ArtCode::COLOR>(reader, variables);
+		for (int i = 0; i < variables.Count(ArtCode::INSTANCE); i++) {
+			InstanceHandle& handle = variables.Get<ArtCode::INSTANCE>(i);
+			handle = InstanceHandle();
+			if (const Uint32 index = reader.Read<Uint32>(); index != NO_INSTANCE) {
+				references.emplace_back(&handle, index);
+			}
+		}
+		for (int i = 0; i < variables.Count(ArtCode::STRING); i++) {
+			variables.Get<ArtCode::STRING>(i) = reader.ReadString();
+		}
+		for (int i = 0; i < variables.Count(ArtCode::LIST); i++) {
+			ReadList(reader, variables.Get<ArtCode::LIST>(i));
+		}
+		for (int i = 0; i < variables.Count(ArtCode::RECT); i++) {
+			Rect& rect = variables.Get<ArtCode::RECT>(i);
+			rect.X = reader.Read<float>();
+			rect.Y = reader.Read<float>();
+			rect.W = reader.Read<float>();
+			rect.H = reader.Read<float>();
+		}
+		return !reader.Failed;
+	}
+
+	void WriteInstance(SnapshotWriter& writer, const Instance* instance, const InstanceIndexes& indexes, std::unordered_map<const Sprite*, int>& sprites)
+	{
+		writer.Write(instance->GetId());
+		writer.WriteString(instance->Tag.Str());
+		writer.WriteString(instance->Name.Str());
+		writer.Write(instance->PosX());
+		writer.Write(instance->PosY());
+		writer.Write(instance->Direction());
+		writer.WriteBool(instance->InView());
+		writer.WriteBool(instance->IsCollider);
+		int sprite = -1;
+		if (instance->SelfSprite != nullptr) {
+			// most instances share few sprites
+			const auto it = sprites.find(instance->SelfSprite);
+			sprite = it != sprites.end() ? it->second : (sprites[instance->SelfSprite] = Core::GetAssetManager()->GetSpriteId(instance->SelfSprite));
+		}
+		writer.Write(sprite);
+		writer.Write(instance->SpriteScaleX);
+		writer.Write(instance->SpriteScaleY);
+		writer.Write(instance->SpriteCenterX);
+		writer.Write(instance->SpriteCenterY);
+		writer.Write(instance->SpriteAngle);
+		writer.Write(instance->SpriteAnimationFrame);
+		writer.Write(instance->SpriteAnimationSpeed);
+		writer.WriteBool(instance->SpriteAnimationLoop);
+		writer.Write(static_cast<Uint8>(instance->Body.Type));
+		writer.Write(instance->Body.Value);
+		writer.Write(instance->StepDelayedTime);
+		WriteVariables(writer, instance->Variables, indexes);
+	}
+}
+
+bool SceneSnapshot::ReadInstance(SnapshotReader& reader, Instance* instance, References& references)
+{
+	instance->_id = reader.Read<Uint64>();
+	instance->Tag = StringId(reader.ReadString());
+	instance->Name = StringId(reader.ReadString());
+	instance->PosX() = reader.Read<float>();
+	instance->PosY() = reader.Read<float>();
+	instance->Direction() = reader.Read<float>();
+	instance->InView() = reader.ReadBool();
+	instance->IsCollider = reader.ReadBool();
+	const int sprite = reader.Read<int>();
+	instance->SelfSprite = sprite == -1 ? nullptr : Core::GetAssetManager()->GetSprite(sprite);
+	instance->SpriteScaleX = reader.Read<float>();
+	instance->SpriteScaleY = reader.Read<float>();
+	instance->SpriteCenterX = reader.Read<int>();
+	instance->SpriteCenterY = reader.Read<int>();
+	instance->SpriteAngle = reader.Read<float>();
+	instance->SpriteAnimationFrame = reader.Read<float>();
+	instance->SpriteAnimationSpeed = reader.Read<float>();
+	instance->SpriteAnimationLoop = reader.ReadBool();
+	const Uint8 body = reader.Read<Uint8>();
+	if (body >= Instance::BodyType::BodyEND) return false;
+	instance->Body.Type = static_cast<Instance::BodyType::Body>(body);
+	instance->Body.Value = reader.Read<float>();
+	instance->StepDelayedTime = reader.Read<double>();
+	return ReadVariables(reader, instance->Variables, references);
+}
+
+void SceneSnapshot::WriteSuspendedCode(SnapshotWriter& writer, const std::unordered_map<const Instance*, Uint32>& indexes)
+{
+	// frame keep pointer to program, it is saved as definition and event
+	const CodeExecutor* executor = Core::Executor();
+	std::unordered_map<const Program*, std::pair<int, int>> programs;
+	for (int definition = 0; definition < static_cast<int>(executor->_instance_definitions.size()); definition++) {
+		for (int event = 0; event < Event::EventEND; event++) {
+			if (executor->_instance_definitions[definition].HaveEvent(static_cast<Event>(event))) {
+				programs[&executor->_instance_definitions[definition]._events[event].code] = { definition, event };
+			}
+		}
+	}
+	// timers in wake order, so restored code keep the same order
+	std::vector<CodeExecutor::SuspendedTimer> timers;
+	timers.reserve(CodeExecutor::_suspended_timers.size());
+	for (const CodeExecutor::SuspendedTimer& timer : CodeExecutor::_suspended_timers) {
+		const CodeExecutor::SuspendedFrame& frame = CodeExecutor::_suspended_frames[timer.Slot];
+		if (frame.Generation == timer.Generation && frame.Sender != nullptr) {
+			timers.push_back(timer);
+		}
+	}
+	std::ranges::sort(timers, [](const CodeExecutor::SuspendedTimer& a, const CodeExecutor::SuspendedTimer& b)
+	{
+		return CodeExecutor::h_suspended_timer_later(b, a);
+	});
+
+	std::vector<SuspendedFrame> frames;
+	frames.reserve(timers.size());
+	int skipped = 0;
+	for (const CodeExecutor::SuspendedTimer& timer : timers) {
+		const CodeExecutor::SuspendedFrame& frame = CodeExecutor::_suspended_frames[timer.Slot];
+		const auto sender = indexes.find(frame.Sender);
+		// scene triggers and console code are not saved
+		if (sender == indexes.end() || !programs.contains(frame.CodeData.Code)) {
+			skipped++;
+			continue;
+		}
+		frames.push_back({ sender->second, frame.CodeData.Code, frame.CodeData.Position, frame.IfTestState, frame.IfTestCount, timer.WakeTime - CodeExecutor::_suspended_clock });
+	}
+	if (skipped > 0) {
+		Console::WriteLine("SceneSnapshot: " + std::to_string(skipped) + " suspended code of scene triggers or console is not saved");
+	}
+	writer.Write(static_cast<Uint32>(frames.size()));
+	for (const SuspendedFrame& frame : frames) {
+		const std::pair<int, int>& program = programs[frame.Code];
+		writer.Write(frame.Sender);
+		writer.Write(program.first);
+		writer.Write(program.second);
+		writer.Write(frame.Position);
+		writer.Write(frame.IfTestState);
+		writer.Write(frame.IfTestCount);
+		writer.Write(frame.Time);
+	}
+}
+
+bool SceneSnapshot::ReadSuspendedCode(SnapshotReader& reader, const Uint32 instances_count, std::vector<SuspendedFrame>& frames)
+{
+	const CodeExecutor* executor = Core::Executor();
+	const Uint32 count = reader.Read<Uint32>();
+	if (reader.Failed || count > reader.Remaining()) return false;
+	frames.reserve(count);
+	for (Uint32 i = 0; i < count; i++) {
+		SuspendedFrame frame{};
+		frame.Sender = reader.Read<Uint32>();
+		const int definition = reader.Read<int>();
+		const int event = reader.Read<int>();
+		frame.Position = reader.Read<int>();
+		frame.IfTestState = reader.Read<Uint64>();
+		frame.IfTestCount = reader.Read<int>();
+		frame.Time = reader.Read<double>();
+		if (reader.Failed || frame.Sender >= instances_count) return false;
+		if (definition < 0 || definition >= static_cast<int>(executor->_instance_definitions.size())) return false;
+		if (event < 0 || event >= Event::EventEND || !executor->_instance_definitions[definition].HaveEvent(static_cast<Event>(event))) return false;
+		frame.Code = &executor->_instance_definitions[definition]._events[event].code;
+		if (frame.Position < 0 || frame.Position > frame.Code->GetSize() || frame.IfTestCount < 0 || frame.IfTestCount > 64) return false;
+		frames.push_back(frame);
+	}
+	return true;
+}
+
+void SceneSnapshot::RestoreSuspendedCode(const std::vector<SuspendedFrame>& frames, const std::vector<Instance*>& instances)
+{
+	for (const SuspendedFrame& frame : frames) {
+		Instance* sender = instances[frame.Sender];
+		if (!sender->SuspendedCodeAdd()) continue;
+		ProgramFrame code(frame.Code);
+		code.Position = frame.Position;
+		CodeExecutor::h_suspended_frame_add(sender, code, frame.IfTestState, frame.IfTestCount, std::max(frame.Time, 0.0));
+	}
+}
+
+bool SceneSnapshot::Save(std::vector<Uint8>& data)
+{
+	Scene* scene = Core::GetCurrentScene();
+	if (scene == nullptr) {
+		Console::WriteLine("SceneSnapshot: there is no scene");
+		return false;
+	}
+	// dead instances are removed in next step, they are not saved
+	std::vector<Instance*> instances;
+	instances.reserve(scene->InstanceColony.size() + scene->_instances_new.size());
+	for (Instance* instance : scene->InstanceColony) {
+		if (instance->Alive()) instances.push_back(instance);
+	}
+	const Uint32 colony_count = static_cast<Uint32>(instances.size());
+	for (Instance* instance : scene->_instances_new) {
+		if (instance->Alive()) instances.push_back(instance);
+	}
+	InstanceIndexes indexes;
+	indexes.reserve(instances.size());
+	for (Uint32 i = 0; i < instances.size(); i++) {
+		indexes[instances[i]] = i;
+	}
+
+	data.clear();
+	data.reserve(instances.size() * 256);
+	SnapshotWriter writer(data);
+	writer.Write(MAGIC);
+	writer.Write(VERSION);
+	writer.WriteString(scene->GetName());
+	writer.Write(Instance::_cid);
+	writer.Write(static_cast<Uint32>(instances.size()));
+	writer.Write(colony_count);
+	// definitions first, so restore can create every instance before references are read
+	for (const Instance* instance : instances) {
+		writer.Write(instance->GetInstanceDefinitionId());
+	}
+	std::unordered_map<const Sprite*, int> sprites;
+	for (const Instance* instance : instances) {
+		WriteInstance(writer, instance, indexes, sprites);
+	}
+	const Instance* holder = scene->GetVariableHolder();
+	writer.WriteBool(holder != nullptr);
+	if (holder != nullptr) {
+		WriteVariables(writer, holder->Variables, indexes);
+	}
+	WriteSuspendedCode(writer, indexes);
+	return true;
+}
+
+bool SceneSnapshot::Restore(const std::span<const Uint8> data)
+{
+	Scene* scene = Core::GetCurrentScene();
+	if (scene == nullptr) {
+		Console::WriteLine("SceneSnapshot: there is no scene");
+		return false;
+	}
+	SnapshotReader reader(data);
+	if (reader.Read<Uint32>() != MAGIC || reader.Read<Uint32>() != VERSION) {
+		Console::WriteLine("SceneSnapshot: data is not snapshot or have other version");
+		return false;
+	}
+	if (const std::string name = reader.ReadString(); name != scene->GetName()) {
+		Console::WriteLine("SceneSnapshot: snapshot is of scene '" + name + "', current scene is '" + scene->GetName() + "'");
+		return false;
+	}
+	const Uint64 id_counter = reader.Read<Uint64>();
+	const Uint32 count = reader.Read<Uint32>();
+	const Uint32 colony_count = reader.Read<Uint32>();
+	if (reader.Failed || colony_count > count || count > reader.Remaining() / sizeof(int)) {
+		Console::WriteLine("SceneSnapshot: data is broken");
+		return false;
+	}
+
+	// instances are prepared outside of scene, scene is changed only if all data is valid
+	std::vector<Instance*> instances;
+	instances.reserve(count);
+	References references;
+	InstanceVariables holder_variables;
+	Instance* holder = scene->GetVariableHolder();
+	std::vector<SuspendedFrame> frames;
+	bool valid = true;
+	for (Uint32 i = 0; i < count && valid; i++) {
+		const int definition = reader.Read<int>();
+		Instance* instance = Core::Executor()->GetInstanceDefinitionName(definition).empty() ? nullptr : Core::Executor()->SpawnInstance(definition);
+		valid = instance != nullptr;
+		if (valid) instances.push_back(instance);
+	}
+	for (Uint32 i = 0; i < count && valid; i++) {
+		valid = ReadInstance(reader, instances[i], references);
+	}
+	if (valid && reader.ReadBool()) {
+		valid = holder != nullptr;
+		if (valid) {
+			holder_variables = holder->Variables;
+			valid = ReadVariables(reader, holder_variables, references);
+		}
+	}
+	valid = valid && ReadSuspendedCode(reader, count, frames);
+	valid = valid && !reader.Failed && std::ranges::all_of(references, [count](const auto& reference) { return reference.second < count; });
+	if (!valid) {
+		for (Instance* instance : instances) {
+			InstancePool::Release(instance);
+		}
+		Console::WriteLine("SceneSnapshot: data is broken or do not match loaded definitions");
+		return false;
+	}
+
+	// commands recorded in this frame point to instances of replaced scene, like in scene change
+	Core::GetInstance()->DiscardCommands();
+	CodeExecutor::SuspendedCodeStop();
+	scene->Clear();
+	scene->CurrentCollisionInstance = nullptr;
+	scene->CurrentCollisionInstanceId = -1;
+	Instance::_cid = id_counter;
+	for (Uint32 i = 0; i < count; i++) {
+		scene->InstanceHandles.Add(instances[i]);
+		if (i < colony_count) {
+			// restored instance is not created again, OnCreate is not executed
+			scene->AddToColony(instances[i]);
+		}
+		else {
+			scene->_instances_new.push_back(instances[i]);
+			scene->_is_any_new_instances = true;
+		}
+	}
+	if (holder != nullptr && holder_variables.Size() > 0) {
+		holder->Variables = std::move(holder_variables);
+	}
+	// handles exist only after instances are added to scene, blocks of variables are not moved
+	for (const auto& [handle, index] : references) {
+		*handle = instances[index]->GetHandle();
+	}
+	RestoreSuspendedCode(frames, instances);
+	return true;
+}
+
+bool SceneSnapshot::SaveFile(const std::string& file)
+{
+	std::vector<Uint8> data;
+	if (!Save(data)) return false;
+	SDL_RWops* output = SDL_RWFromFile(file.c_str(), "wb");
+	if (output == nullptr) {
+		Console::WriteLine("SceneSnapshot: " + std::string(SDL_GetError()));
+		return false;
+	}
+	const bool written = SDL_RWwrite(output, data.data(), 1, data.size()) == data.size();
+	SDL_RWclose(output);
+	if (!written) {
+		Console::WriteLine("SceneSnapshot: cannot write '" + file + "'");
+	}
+	return written;
+}
+
+bool SceneSnapshot::RestoreFile(const std::string& file)
+{
+	SDL_RWops* input = SDL_RWFromFile(file.c_str(), "rb");
+	if (input == nullptr) {
+		Console::WriteLine("SceneSnapshot: " + std::string(SDL_GetError()));
+		return false;
+	}
+	const Sint64 size = SDL_RWsize(input);
+	std::vector<Uint8> data(size > 0 ? static_cast<size_t>(size) : 0);
+	const bool read = size > 0 && SDL_RWread(input, data.data(), 1, data.size()) == data.size();
+	SDL_RWclose(input);
+	if (!read) {
+		Console::WriteLine("SceneSnapshot: cannot read '" + file + "'");
+		return false;
+	}
+	return Restore(data);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SDL2/IncludeAll.h"
+#include "ArtCore/Scene/InstanceTable.h"
+
+class Instance;
+class Program;
+class SnapshotReader;
+class SnapshotWriter;
+
+// Binary copy of live state of current scene: instances with built-in fields and variables,
+// scene variables and suspended code. References between instances are saved as index in
+// snapshot. Restore replace instances of current scene without Load and Start, so it must be
+// called between frames (console commands are). Data is in native byte order, it is valid
+// only for the same build and game data.
+class SceneSnapshot final
+{
+public:
+	static bool Save(std::vector<Uint8>& data);
+	// current scene is not changed if data is broken
+	static bool Restore(std::span<const Uint8> data);
+	static bool SaveFile(const std::string& file);
+	static bool RestoreFile(const std::string& file);
+
+private:
+	static constexpr Uint32 MAGIC = 0x504E5341; // "ASNP"
+	static constexpr Uint32 VERSION = 1;
+
+	// instance variable and index of referenced instance in snapshot, set when all instances are in scene
+	typedef std::vector<std::pair<InstanceHandle*, Uint32>> References;
+	struct SuspendedFrame
+	{
+		Uint32 Sender;
+		const Program* Code;
+		int Position;
+		Uint64 IfTestState;
+		int IfTestCount;
+		double Time;
+	};
+
+	static bool ReadInstance(SnapshotReader& reader, Instance* instance, References& references);
+	static void WriteSuspendedCode(SnapshotWriter& writer, const std::unordered_map<const Instance*, Uint32>& indexes);
+	static bool ReadSuspendedCode(SnapshotReader& reader, Uint32 instances_count, std::vector<SuspendedFrame>& frames);
+	static void RestoreSuspendedCode(const std::vector<SuspendedFrame>& frames, const std::vector<Instance*>& instances);
+};
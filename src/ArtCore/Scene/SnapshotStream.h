@@ -0,0 +1,102 @@
+#pragma once
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+#ifdef tests
+#include "../../src/SDL2/SDL2/include/SDL_stdinc.h"
+#else
+#include "SDL2/IncludeAll.h"
+#endif
+
+// Byte streams of SceneSnapshot, without engine types so they can be tested alone.
+
+class SnapshotWriter final
+{
+public:
+	explicit SnapshotWriter(std::vector<Uint8>& data) : _data(data) {}
+
+	template <typename T>
+	void Write(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "only plain values are written as bytes");
+		WriteBytes(&value, sizeof(T));
+	}
+	void WriteBytes(const void* source, const size_t size)
+	{
+		if (size == 0) return;
+		const size_t position = _data.size();
+		_data.resize(position + size);
+		std::memcpy(_data.data() + position, source, size);
+	}
+	// one byte, 0 or 1
+	void WriteBool(const bool value)
+	{
+		Write(static_cast<Uint8>(value ? 1 : 0));
+	}
+	void WriteString(const std::string& value)
+	{
+		Write(static_cast<Uint32>(value.size()));
+		WriteBytes(value.data(), value.size());
+	}
+
+private:
+	std::vector<Uint8>& _data;
+};
+
+// read after end of data set Failed and give zero values, so it is tested once per part
+class SnapshotReader final
+{
+public:
+	explicit SnapshotReader(const std::span<const Uint8> data) : _data(data) {}
+
+	template <typename T>
+	T Read()
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "only plain values are read as bytes");
+		// bool with other byte than 0 or 1 is undefined, use ReadBool
+		static_assert(!std::is_same_v<T, bool>, "bool is read by ReadBool");
+		T value{};
+		ReadBytes(&value, sizeof(T));
+		return value;
+	}
+	void ReadBytes(void* target, const size_t size)
+	{
+		if (Failed || size > Remaining()) {
+			Failed = true;
+			return;
+		}
+		if (size == 0) return;
+		std::memcpy(target, _data.data() + _position, size);
+		_position += size;
+	}
+	// other byte than 0 or 1 set Failed, data is broken
+	bool ReadBool()
+	{
+		const Uint8 value = Read<Uint8>();
+		if (value > 1) {
+			Failed = true;
+			return false;
+		}
+		return value == 1;
+	}
+	std::string ReadString()
+	{
+		const Uint32 size = Read<Uint32>();
+		if (Failed || size > Remaining()) {
+			Failed = true;
+			return {};
+		}
+		std::string value(reinterpret_cast<const char*>(_data.data() + _position), size);
+		_position += size;
+		return value;
+	}
+	[[nodiscard]] size_t Remaining() const { return _data.size() - _position; }
+
+	bool Failed = false;
+
+private:
+	std::span<const Uint8> _data;
+	size_t _position = 0;
+};
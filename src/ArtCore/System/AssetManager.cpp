@@ -198,6 +198,14 @@ Sprite* AssetManager::GetSprite(const std::string& name)
 	return nullptr;
 }
 
+int AssetManager::GetSpriteId(const Sprite* sprite) const
+{
+	for (size_t i = 0; i < List_sprite_id.size(); i++) {
+		if (List_sprite_id[i] == sprite) return static_cast<int>(i);
+	}
+	return -1;
+}
+
 int AssetManager::GetSpriteId(const std::string& name) const
 {
 	int i = -1;
@@ -18,6 +18,8 @@ public:
 	Sprite* GetSprite(int id) const;
 	Sprite* GetSprite(const std::string& name);
 	int GetSpriteId(const std::string& name) const;
+	// -1 if sprite is not loaded
+	int GetSpriteId(const Sprite* sprite) const;
 	
 	GPU_Image* GetTexture(int id) const;
 	GPU_Image* GetTexture(const std::string& name);
@@ -8,8 +8,11 @@
 #include "ArtCore/CodeExecutor/CodeExecutor.h"
 #include "ArtCore/main.h" // for program version
 #include "ArtCore/Graphic/BackGroundRenderer.h"
+#include "ArtCore/Scene/InstancePool.h"
 #include "ArtCore/Scene/Scene.h"
 #include "ArtCore/Physics/Physics.h"
+#include "ArtCore/System/WorkerPool.h"
+#include "ArtCore/System/StringInterner.h"
 
 #include "ArtCore/predefined_headers/SplashScreen.h"
 #include "ArtCore/Graphic/ColorDefinitions.h"
@@ -87,6 +90,7 @@ Core::Core()
 
 Core::~Core()
 {
+    _worker_pool.Stop();
     if(_executor != nullptr)
 		_executor->Delete();
     delete _executor;
@@ -98,6 +102,7 @@ Core::~Core()
     if (_current_scene != nullptr)
     	_current_scene->Exit();
 	delete _current_scene;
+    InstancePool::Trim();
 
     Render::DestroyRender();
 
@@ -561,91 +566,194 @@ bool Core::ProcessEvents()
     return false;
 }
 
-void Core::ProcessStep() const
+void Core::StepLocalChunk(void* data, const int chunk, const int worker)
 {
+    Core* core = static_cast<Core*>(data);
+    ExecutionContext* context = &core->_step_contexts[worker];
+    const size_t begin = static_cast<size_t>(chunk) * STEP_CHUNK_SIZE;
+    const size_t end = std::min(begin + STEP_CHUNK_SIZE, core->_step_local.size());
+    for (size_t i = begin; i < end; i++) {
+        Executor()->ExecuteScript(context, core->_step_local[i], Event::EvStep);
+    }
+}
+
+void Core::ProcessStepLowPriority(const Uint64 step_start)
+{
+    _step_low_delayed = 0;
+    if (_step_low.empty()) return;
+    const double frame_delta = DeltaTime;
+    const Uint64 budget = static_cast<Uint64>(_step_budget * static_cast<double>(SDL_GetPerformanceFrequency()) / 1000.0);
+    // list is built again every frame, so waiting time give the order: every delayed instance add the same
+    // frame time, instance that wait longer always have more. New instances wait 0 and keep spawn order
+    std::ranges::stable_sort(_step_low, [](const Instance* a, const Instance* b) { return a->StepDelayedTime > b->StepDelayedTime; });
+    const size_t count = _step_low.size();
+    size_t executed = 0;
+    for (; executed < count; executed++) {
+        // one step is always executed, so every instance is stepped sometime
+        if (executed > 0 && SDL_GetPerformanceCounter() - step_start > budget) break;
+        Instance* instance = _step_low[executed];
+        // step see all time that pass from last executed step
+        DeltaTime = frame_delta + instance->StepDelayedTime;
+        instance->StepDelayedTime = 0.0;
+        Executor()->ExecuteScript(instance, Event::EvStep);
+    }
+    DeltaTime = frame_delta;
+    for (size_t i = executed; i < count; i++) {
+        _step_low[i]->StepDelayedTime += frame_delta;
+    }
+    _step_low_delayed = static_cast<int>(count - executed);
+    _step_low.clear();
+}
+
+void Core::ProcessStep()
+{
+    const Uint64 step_start = SDL_GetPerformanceCounter();
     // interface (gui) events
     const bool gui_have_event = _current_scene->GuiSystem.Events();
     // add all new instances to scene and execute OnCreate event
     _current_scene->SpawnAll();
     if (_current_scene->IsAnyInstances()) {
-        for (plf::colony<Instance*>::iterator it = _current_scene->InstanceColony.begin(); 
-            it != _current_scene->InstanceColony.end();)
-        {
-            if (Instance* c_instance = (*it); c_instance->Alive) {
-                // step
+        // local steps first, they do not see other instances so order do not matter
+        _step_local.clear();
+        if (_worker_pool.GetWorkersCount() > 1) {
+            for (Instance* instance : _current_scene->GetSubscribers(Scene::Subscribers::Step)) {
+                if (instance->Alive() && Executor()->IsStepLocal(instance)) {
+                    _step_local.push_back(instance);
+                }
+            }
+            if (_step_local.size() > STEP_CHUNK_SIZE) {
+                _worker_pool.Run(static_cast<int>((_step_local.size() + STEP_CHUNK_SIZE - 1) / STEP_CHUNK_SIZE), Core::StepLocalChunk, this);
+            }
+            else {
+                // not worth to wake workers
+                _step_local.clear();
+            }
+        }
+        const bool local_step_done = !_step_local.empty();
+        for (Instance* c_instance : _current_scene->GetSubscribers(Scene::Subscribers::Step)) {
+            if (!c_instance->Alive() || (local_step_done && Executor()->IsStepLocal(c_instance))) continue;
+            if (_step_budget > 0.0 && Executor()->IsStepLowPriority(c_instance)) {
+                _step_low.push_back(c_instance);
+            }
+            else {
                 Executor()->ExecuteScript(c_instance, Event::EvStep);
-                const event_bit c_flag = c_instance->EventFlag;
+            }
+        }
 
-                // in view
-                if (c_instance->Alive) {
-                    SDL_FPoint pos{ c_instance->PosX, c_instance->PosY };
-                    const bool oldInView = c_instance->InView;
-                    c_instance->InView = Graphic.GetScreenSpace()->PointInRect(pos);
-                    if (c_instance->InView != oldInView) {
-                        if (EVENT_BIT_TEST(event_bit::HAVE_VIEW_CHANGE, c_flag)) {
-                            if (oldInView == true) { // be inside, now exit view
-                                Executor()->ExecuteScript(c_instance, Event::EvOnViewLeave);
-                            }
-                            else {
-                                Executor()->ExecuteScript(c_instance, Event::EvOnViewEnter);
-                            }
+        // mouse input
+        if (!gui_have_event && (Mouse.LeftEvent == MouseState::ButtonState::PRESSED || Mouse.LeftEvent == MouseState::ButtonState::RELEASED)) {
+            for (Instance* c_instance : _current_scene->GetSubscribers(Scene::Subscribers::Mouse)) {
+                if (!c_instance->Alive()) continue;
+                const event_bit c_flag = c_instance->EventFlag;
+                if (Mouse.LeftEvent == MouseState::ButtonState::PRESSED) {
+                    // global click
+                    if (EVENT_BIT_TEST(event_bit::HAVE_MOUSE_EVENT_DOWN, c_flag)) {
+                        Executor()->ExecuteScript(c_instance, Event::EvOnMouseDown);
+                    }
+                    // on mask click
+                    if (EVENT_BIT_TEST(event_bit::HAVE_MOUSE_EVENT_CLICK, c_flag)) {
+                        if (c_instance->CheckMaskClick(Mouse.XYf)) {
+                            Executor()->ExecuteScript(c_instance, Event::EvClicked);
                         }
                     }
                 }
-
-                // mouse input
-                if (c_instance->Alive && (!gui_have_event)) {
-	                if (EVENT_BIT_TEST(event_bit::HAVE_MOUSE_EVENT, c_flag)) {
-		                if (Mouse.LeftEvent == MouseState::ButtonState::PRESSED) {
-			                // global click
-			                if (EVENT_BIT_TEST(event_bit::HAVE_MOUSE_EVENT_DOWN, c_flag)) {
-				                Executor()->ExecuteScript(c_instance, Event::EvOnMouseDown);
-			                }
-			                // on mask click
-			                if (EVENT_BIT_TEST(event_bit::HAVE_MOUSE_EVENT_CLICK, c_flag)) {
-				                if (c_instance->CheckMaskClick(Mouse.XYf)) {
-					                Executor()->ExecuteScript(c_instance, Event::EvClicked);
-				                }
-			                }
-		                }
-		                if (Mouse.LeftEvent == MouseState::ButtonState::RELEASED) {
-			                if (EVENT_BIT_TEST(event_bit::HAVE_MOUSE_EVENT_UP, c_flag)) {
-				                Executor()->ExecuteScript(c_instance, Event::EvOnMouseUp);
-			                }
-		                }
-	                }
-                }
-                // go to next instance
-                ++it;
-            }
-            else {
-                // delete instance if not alive
-                if (EVENT_BIT_TEST(event_bit::HAVE_ON_DESTROY, c_instance->EventFlag)) {
-                    Executor()->ExecuteScript(c_instance, Event::EvOnDestroy);
+                if (Mouse.LeftEvent == MouseState::ButtonState::RELEASED) {
+                    if (EVENT_BIT_TEST(event_bit::HAVE_MOUSE_EVENT_UP, c_flag)) {
+                        Executor()->ExecuteScript(c_instance, Event::EvOnMouseUp);
+                    }
                 }
-                delete (*it);
-                it = _instance._current_scene->DeleteInstance(it);
             }
         }
+        _current_scene->DeleteDeadInstances();
+        ProcessStepLowPriority(step_start);
         // execute all suspended code
 		CodeExecutor::SuspendedCodeExecute();
+        ProcessViewTest();
+    }
+}
+
+void Core::ProcessViewTest()
+{
+    const Rect view = *Graphic.GetScreenSpace();
+    _view_changed.clear();
+    for (size_t c = 0; c < InstanceComponents::GetChunksCount(); c++) {
+        InstanceComponents::Chunk& chunk = InstanceComponents::GetChunk(c);
+        // templates and pooled instances only
+        if (chunk.InSceneCount == 0) continue;
+        // whole chunk without branches, changes are rare
+        bool in_view[InstanceComponents::CHUNK_SIZE];
+        for (int i = 0; i < chunk.Used; i++) {
+            in_view[i] = (chunk.PosX[i] >= view.X) & (chunk.PosX[i] <= view.W) & (chunk.PosY[i] >= view.Y) & (chunk.PosY[i] <= view.H);
+        }
+        for (int i = 0; i < chunk.Used; i++) {
+            if (in_view[i] == chunk.InView[i] || !chunk.InScene[i] || !chunk.Alive[i]) continue;
+            chunk.InView[i] = in_view[i];
+            if (EVENT_BIT_TEST(event_bit::HAVE_VIEW_CHANGE, chunk.Owner[i]->EventFlag)) {
+                _view_changed.push_back(chunk.Owner[i]);
+            }
+        }
+    }
+    for (Instance* instance : _view_changed) {
+        if (!instance->Alive()) continue;
+        Executor()->ExecuteScript(instance, instance->InView() ? Event::EvOnViewEnter : Event::EvOnViewLeave);
     }
 }
 #include "ArtCore/_Debug/Time.h"
+void Core::ProcessCommands()
+{
+    CommandBuffer::Apply(_command_buffers);
+}
+
+void Core::DiscardCommands()
+{
+    for (CommandBuffer* buffer : _command_buffers) {
+        buffer->Discard();
+    }
+}
+
 void Core::ProcessPhysics() const
 {
-    for (const auto instance : _current_scene->InstanceColony) {
-        if (instance->Alive) {
-            // collision
-            if (EVENT_BIT_TEST(event_bit::HAVE_COLLISION, instance->EventFlag)) {
-                for (Instance* target : _current_scene->InstanceColony) {
-                    if (Physics::CollisionTest(instance, target)) {
-                        _current_scene->CurrentCollisionInstance = target;
-                        _current_scene->CurrentCollisionInstanceId = target->GetId();
-                        Executor()->ExecuteScript(instance, Event::EvOnCollision);
-                        _current_scene->CurrentCollisionInstance = nullptr;
-                        _current_scene->CurrentCollisionInstanceId = -1;
-                    }
+    if (_current_scene->GetSubscribers(Scene::Subscribers::Collision).empty()) return;
+    // broadphase bounds are in instance components, narrow test only if bounds overlap
+    Physics::UpdateBounds();
+    for (Instance* instance : _current_scene->GetSubscribers(Scene::Subscribers::Collision)) {
+        if (!instance->Alive()) continue;
+        const InstanceComponents::Slot& slot = instance->GetComponents();
+        float min_x, min_y, max_x, max_y;
+        const auto read_bounds = [&]()
+        {
+            min_x = slot.Values->BoundsMinX[slot.Index];
+            min_y = slot.Values->BoundsMinY[slot.Index];
+            max_x = slot.Values->BoundsMaxX[slot.Index];
+            max_y = slot.Values->BoundsMaxY[slot.Index];
+        };
+        read_bounds();
+        for (size_t c = 0; c < InstanceComponents::GetChunksCount(); c++) {
+            const InstanceComponents::Chunk& chunk = InstanceComponents::GetChunk(c);
+            if (chunk.InSceneCount == 0) continue;
+            bool overlap[InstanceComponents::CHUNK_SIZE];
+            const auto test_bounds = [&](const int from)
+            {
+                for (int i = from; i < chunk.Used; i++) {
+                    // instance deleted in step stay in colony until next step, it do not collide
+                    overlap[i] = (chunk.BoundsMinX[i] <= max_x) & (chunk.BoundsMaxX[i] >= min_x) & (chunk.BoundsMinY[i] <= max_y) & (chunk.BoundsMaxY[i] >= min_y)
+                        & chunk.Alive[i] & chunk.InScene[i];
+                }
+            };
+            test_bounds(0);
+            for (int i = 0; i < chunk.Used; i++) {
+                if (!overlap[i]) continue;
+                Instance* target = chunk.Owner[i];
+                if (Physics::CollisionTest(instance, target)) {
+                    _current_scene->CurrentCollisionInstance = target;
+                    _current_scene->CurrentCollisionInstanceId = target->GetId();
+                    Executor()->ExecuteScript(instance, Event::EvOnCollision);
+                    _current_scene->CurrentCollisionInstance = nullptr;
+                    _current_scene->CurrentCollisionInstanceId = -1;
+                    // script can move any instance, stale bounds would hide its collisions
+                    Physics::UpdateBounds();
+                    read_bounds();
+                    test_bounds(i + 1);
                 }
             }
         }
@@ -665,8 +773,8 @@ void Core::ProcessSceneRender() const
 
     // draw all instances if in view (defined in step event)
     if (_current_scene->IsAnyInstances()) {
-        for (Instance* instance : _current_scene->InstanceColony) {
-            if (instance->InView) {
+        for (Instance* instance : _current_scene->GetSubscribers(Scene::Subscribers::Draw)) {
+            if (instance->InView()) {
                 Executor()->ExecuteScript(instance, Event::EvDraw);
             }
         }
@@ -846,14 +954,18 @@ bool Core::Run()
 
         if (_instance.game_loop) {
             _instance.ProcessStep();
+            _instance.ProcessCommands();
         debug_test_counter_end(performance_step)
 
         debug_test_counter_start(performance_physics)
             _instance.ProcessPhysics();
+            _instance.ProcessCommands();
         debug_test_counter_end(performance_physics)
         }
 
         debug_test_counter_start(performance_render)
+        // gui and console events are executed also when game is paused
+        _instance.ProcessCommands();
         Render::RenderClear();
         // render scene
         _instance.ProcessSceneRender();
@@ -917,6 +1029,38 @@ bool Core::LoadData()
 		bgr.Stop();
 		return false;
 	}
+	// write scripts as c++ to build them in engine, game quit after first frame
+	if (const program_argument argument = _instance.GetProgramArgument("-transpile"); argument.first != nullptr) {
+		if (!Executor()->Transpile(argument.second != nullptr ? argument.second : "ArtNativeScripts.cpp")) {
+			bgr.Stop();
+			return false;
+		}
+		Exit();
+	}
+
+	// workers for local step events, calling thread is one of them
+	{
+		int threads = SDL_GetCPUCount() - 1;
+		if (const program_argument argument = _instance.GetProgramArgument("-step_threads"); argument.second != nullptr) {
+			threads = Func::TryGetInt(argument.second);
+		}
+		if (threads > 0) {
+			_instance._worker_pool.Start(threads);
+		}
+		_instance._step_contexts.resize(_instance._worker_pool.GetWorkersCount());
+		_instance._contexts.push_back(Executor()->GetMainContext());
+		for (ExecutionContext& context : _instance._step_contexts) {
+			_instance._contexts.push_back(&context);
+		}
+		for (ExecutionContext* context : _instance._contexts) {
+			_instance._command_buffers.push_back(&context->Commands);
+		}
+		Console::WriteLine("step workers: " + std::to_string(_instance._worker_pool.GetWorkersCount()));
+		_instance._step_budget = SD_GetFloat("StepBudgetMs", 0.f);
+		if (const program_argument argument = _instance.GetProgramArgument("-step_budget"); argument.second != nullptr) {
+			_instance._step_budget = Func::TryGetFloat(argument.second);
+		}
+	}
 	bgr.SetProgress(90);
 
 	// set starting scene
@@ -960,6 +1104,9 @@ bool Core::ChangeScene(const std::string& name)
         _current_scene->Exit();
     }
     CodeExecutor::SuspendedCodeStop();
+    DiscardCommands();
+    // key of decoded trigger is address of its code, new scene can get the same address
+    Executor()->ClearScenePrograms();
 
     Scene* new_scene = new Scene();
     if (new_scene->Load(name))
@@ -1082,20 +1229,20 @@ void Core::CoreDebug::Draw() const
     {
         if (_instance._current_scene->IsAnyInstances()) {
             for (const Instance* instance : _instance._current_scene->InstanceColony) {
-                GPU_Circle(_instance._screenTarget, instance->PosX, instance->PosY, 4, C_BLACK);
+                GPU_Circle(_instance._screenTarget, instance->PosX(), instance->PosY(), 4, C_BLACK);
                 // always draw origins point
             	if (instance->SelfSprite) {
-                    GPU_Circle(_instance._screenTarget, instance->PosX + instance->SelfSprite->GetCenterXRel(), instance->PosY + instance->SelfSprite->GetCenterYRel(), 6, C_GOLD);
+                    GPU_Circle(_instance._screenTarget, instance->PosX() + instance->SelfSprite->GetCenterXRel(), instance->PosY() + instance->SelfSprite->GetCenterYRel(), 6, C_GOLD);
                 }
                 else {
-                    GPU_Circle(_instance._screenTarget, instance->PosX, instance->PosY, 6, C_GOLD);
+                    GPU_Circle(_instance._screenTarget, instance->PosX(), instance->PosY(), 6, C_GOLD);
                 }
 
                 if(_show_directions)
                 {
                     const float prv = GPU_SetLineThickness(4.f);
-                    vec2f line_begin{ instance->PosX, instance->PosY };
-                    vec2f line_end = Func::GetDirectionVector(instance->Direction);
+                    vec2f line_begin{ instance->PosX(), instance->PosY() };
+                    vec2f line_end = Func::GetDirectionVector(instance->Direction());
                     line_end *= 42.f;
                     line_end += line_begin;
                     GPU_Line(_instance._screenTarget, line_begin.x, line_begin.y, line_end.x, line_end.y, C_DYELLOW);
@@ -1105,7 +1252,7 @@ void Core::CoreDebug::Draw() const
                 if (_show_collider) {
                     if (instance->Body.Type == Instance::BodyType::Circle) {
                         const float radius_scale = instance->Body.Value * ((instance->SpriteScaleX + instance->SpriteScaleY) / 2.f);
-                        GPU_Circle(_instance._screenTarget, instance->PosX, instance->PosY, radius_scale, C_BLUE);
+                        GPU_Circle(_instance._screenTarget, instance->PosX(), instance->PosY(), radius_scale, C_BLUE);
                     }
                     if (instance->Body.Type == Instance::BodyType::Rect) {
                         GPU_Rectangle2(_instance._screenTarget, instance->GetBodyMask().ToGPU_Rect_wh(), C_BLUE);
@@ -1113,10 +1260,10 @@ void Core::CoreDebug::Draw() const
                 }
 
                 if (_show_instance_info) {
-                    const std::string text = instance->Name + "#" + std::to_string(instance->GetId()) + "[" + std::to_string(static_cast<int>(instance->PosX)) + "," + std::to_string(static_cast<int>(instance->PosY)) + "]";
+                    const std::string text = instance->Name.Str() + "#" + std::to_string(instance->GetId()) + "[" + std::to_string(static_cast<int>(instance->PosX())) + "," + std::to_string(static_cast<int>(instance->PosY())) + "]";
                     GPU_Rect draw_surface = FC_GetBounds(_instance._global_font, 0.f, 0.f, FC_ALIGN_LEFT, { 1.f, 1.f }, text.c_str());
-                    draw_surface.x = std::clamp(instance->PosX, 0.f, static_cast<float>(GetScreenWidth()) - draw_surface.w);
-                    draw_surface.y = std::clamp(instance->PosY, 0.f, static_cast<float>(GetScreenHeight()) - draw_surface.h);
+                    draw_surface.x = std::clamp(instance->PosX(), 0.f, static_cast<float>(GetScreenWidth()) - draw_surface.w);
+                    draw_surface.y = std::clamp(instance->PosY(), 0.f, static_cast<float>(GetScreenHeight()) - draw_surface.h);
                     FC_DrawColor(_instance._global_font, _instance._screenTarget, draw_surface.x, draw_surface.y, C_RED, text.c_str());
                 }
             }
@@ -1156,11 +1303,15 @@ void Core::CoreDebug::Draw() const
 
     if(_show_performance)
     {
+        const InstancePool::Stats pool = InstancePool::GetStats();
         const std::string text =
             "instance count[colony size]: " + std::to_string(_instance._current_scene->GetInstancesCount()) + '[' + std::to_string(_instance._current_scene->InstanceColony.size()) + ']' + '\n' +
             "delta time: " + std::to_string(_instance.DeltaTime) + '\n' +
-            "Executor global stack size[capacity]: " + std::to_string(CodeExecutor::GetGlobalStackSize()) + '[' + std::to_string(CodeExecutor::GetGlobalStackSize()) + ']' + '\n' +
+            "Executor global stack size[capacity]: " + std::to_string(Core::Executor()->GetGlobalStackSize()) + '[' + std::to_string(Core::Executor()->GetGlobalStackCapacity()) + ']' + '\n' +
             "Executor if-test stack size: " + std::to_string(Core::Executor()->DebugGetIfTestResultStackSize()) + ']' + '\n' +
+            "low priority steps delayed: " + std::to_string(_instance._step_low_delayed) + '\n' +
+            "interned strings: " + std::to_string(StringInterner::GetCount()) + '\n' +
+            "instance pool live[free, high water]: " + std::to_string(pool.Live) + '[' + std::to_string(pool.Free) + ", " + std::to_string(pool.HighWater) + ']' + '\n' +
             "bloom draw: " + (_instance.use_bloom ? "enabled (" + std::to_string(_instance.use_bloom_level) + ")" : "disabled");
 
     	GPU_Rect info_rect = FC_GetBounds(_instance._global_font, 0.f, 0.f, FC_ALIGN_LEFT, FC_Scale{ 1.f, 1.f }, text.c_str());
@@ -7,12 +7,16 @@
 #include "ArtCore/Functions/Func.h"
 #include "ArtCore/Gui/Console.h"
 #include "ArtCore/Structs/Rect.h"
+#include "ArtCore/System/WorkerPool.h"
 #include "FC_Fontcache/SDL_FontCache.h"
 #include "SDL2/IncludeAll.h"
 
 class Scene;
 class AssetManager;
 class CodeExecutor;
+class Instance;
+class CommandBuffer;
+struct ExecutionContext;
 class Core final
 {
 	private:
@@ -26,8 +30,12 @@ public:
 	static void Exit();
 
 	bool ProcessEvents();
-	void ProcessStep() const;
+	void ProcessStep();
 	void ProcessPhysics() const;
+	// sync point, world changes recorded by scripts are applied
+	void ProcessCommands();
+	// drop changes recorded by scripts, they can point to instances of replaced scene
+	void DiscardCommands();
 	void ProcessSceneRender() const;
 	void ProcessPostProcessRender() const;
 	void ProcessSystemRender() const;
@@ -48,6 +56,13 @@ public:
 	static void Play() {_instance.game_loop = true;	}
 	static CodeExecutor* Executor() {return _instance._executor;}
 	bool ChangeScene(const std::string& name);
+	// milliseconds for step scripts in one frame, low priority steps over it are delayed. 0 is no budget
+	static void SetStepBudget(const double milliseconds) { _instance._step_budget = milliseconds; }
+	static double GetStepBudget() { return _instance._step_budget; }
+	// count of low priority steps delayed in last frame
+	static int GetStepDelayedCount() { return _instance._step_low_delayed; }
+	// main context first, then step contexts in worker order
+	static const std::vector<ExecutionContext*>& GetExecutionContexts() { return _instance._contexts; }
 
 	static inline double DeltaTime;
 private:
@@ -201,6 +216,24 @@ private:
 	Scene* _current_scene;
 	std::string _primary_scene;
 
+	// local step events are split to chunks and executed on all workers
+	WorkerPool _worker_pool;
+	std::vector<ExecutionContext> _step_contexts;
+	std::vector<Instance*> _step_local;
+	static constexpr size_t STEP_CHUNK_SIZE = 64;
+	static void StepLocalChunk(void* data, int chunk, int worker);
+	// low priority steps are executed after other steps while budget last, longest waiting first
+	double _step_budget = 0.0;
+	std::vector<Instance*> _step_low;
+	int _step_low_delayed = 0;
+	void ProcessStepLowPriority(Uint64 step_start);
+	// view test is one sweep over instance components, events are executed after it
+	std::vector<Instance*> _view_changed;
+	void ProcessViewTest();
+	// main context first, then step contexts in worker order
+	std::vector<ExecutionContext*> _contexts;
+	std::vector<CommandBuffer*> _command_buffers;
+
 	static Core _instance;
 	SDL_Window* _window;
 #ifdef _DEBUG
@@ -0,0 +1,58 @@
+#include "StringInterner.h"
+
+StringInterner::StringInterner()
+{
+	_strings.emplace_back();
+	_ids.emplace(_strings.back(), EMPTY);
+}
+
+StringInterner& StringInterner::Table()
+{
+	static StringInterner instance;
+	return instance;
+}
+
+StringInterner::Id StringInterner::Intern(const std::string_view value)
+{
+	StringInterner& interner = Table();
+	SDL_AtomicLock(&interner._lock);
+	Id id;
+	if (const auto it = interner._ids.find(value); it != interner._ids.end()) {
+		id = it->second;
+	}
+	else {
+		id = static_cast<Id>(interner._strings.size());
+		interner._strings.emplace_back(value);
+		interner._ids.emplace(interner._strings.back(), id);
+	}
+	SDL_AtomicUnlock(&interner._lock);
+	return id;
+}
+
+StringInterner::Id StringInterner::Find(const std::string_view value)
+{
+	StringInterner& interner = Table();
+	SDL_AtomicLock(&interner._lock);
+	const auto it = interner._ids.find(value);
+	const Id id = it != interner._ids.end() ? it->second : NOT_FOUND;
+	SDL_AtomicUnlock(&interner._lock);
+	return id;
+}
+
+const std::string& StringInterner::Get(const Id id)
+{
+	StringInterner& interner = Table();
+	SDL_AtomicLock(&interner._lock);
+	const std::string& value = id < interner._strings.size() ? interner._strings[id] : interner._strings.front();
+	SDL_AtomicUnlock(&interner._lock);
+	return value;
+}
+
+size_t StringInterner::GetCount()
+{
+	StringInterner& interner = Table();
+	SDL_AtomicLock(&interner._lock);
+	const size_t count = interner._strings.size();
+	SDL_AtomicUnlock(&interner._lock);
+	return count;
+}
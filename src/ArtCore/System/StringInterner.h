@@ -0,0 +1,52 @@
+#pragma once
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "SDL2/IncludeAll.h"
+
+// Engine wide table of strings, equal strings have equal id so compare is one integer test.
+// Strings are never removed, use it for tags, names and other strings that repeat.
+class StringInterner final
+{
+public:
+	typedef Uint32 Id;
+	// id of empty string
+	static constexpr Id EMPTY = 0;
+	static constexpr Id NOT_FOUND = UINT32_MAX;
+
+	// add string if not exists
+	static Id Intern(std::string_view value);
+	// id of string or NOT_FOUND, do not add anything
+	static Id Find(std::string_view value);
+	// reference is valid until end of program
+	static const std::string& Get(Id id);
+	static size_t GetCount();
+
+private:
+	StringInterner();
+	static StringInterner& Table();
+
+	// deque do not move strings, so views in map stay valid
+	std::deque<std::string> _strings;
+	std::unordered_map<std::string_view, Id> _ids;
+	// scripts on worker threads can set tags
+	SDL_SpinLock _lock = 0;
+};
+
+// Interned string stored by value, copy is free and equality is integer compare
+class StringId final
+{
+public:
+	StringId() = default;
+	StringId(const std::string& value) : _id(StringInterner::Intern(value)) {}
+	StringId(const char* value) : _id(StringInterner::Intern(value)) {}
+
+	[[nodiscard]] const std::string& Str() const { return StringInterner::Get(_id); }
+	[[nodiscard]] StringInterner::Id GetId() const { return _id; }
+	bool operator==(const StringId& other) const { return _id == other._id; }
+
+private:
+	StringInterner::Id _id = StringInterner::EMPTY;
+};
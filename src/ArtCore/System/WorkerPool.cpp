@@ -0,0 +1,125 @@
+#include "WorkerPool.h"
+
+#include <string>
+
+#include "ArtCore/Gui/Console.h"
+
+WorkerPool::~WorkerPool()
+{
+	Stop();
+}
+
+bool WorkerPool::Start(const int threads)
+{
+	if (_mutex != nullptr) {
+		Console::WriteLine("WorkerPool: can not start, pool is running!");
+		return false;
+	}
+	_mutex = SDL_CreateMutex();
+	_start = SDL_CreateCond();
+	_done = SDL_CreateCond();
+	if (_mutex == nullptr || _start == nullptr || _done == nullptr) {
+		Console::WriteLine("WorkerPool: " + std::string(SDL_GetError()));
+		Stop();
+		return false;
+	}
+	_stop = false;
+	// pointers to workers are given to threads, vector can not grow later
+	_workers.reserve(threads);
+	for (int i = 0; i < threads; i++) {
+		_workers.push_back({ this, i + 1 });
+		SDL_Thread* thread = SDL_CreateThread(WorkerPool::ThreadFunction, "art_worker", &_workers.back());
+		if (thread == nullptr) {
+			Console::WriteLine("WorkerPool: " + std::string(SDL_GetError()));
+			_workers.pop_back();
+			break;
+		}
+		_threads.push_back(thread);
+	}
+	return true;
+}
+
+void WorkerPool::Stop()
+{
+	if (_mutex == nullptr) return;
+	SDL_LockMutex(_mutex);
+	_stop = true;
+	SDL_CondBroadcast(_start);
+	SDL_UnlockMutex(_mutex);
+	for (SDL_Thread* thread : _threads) {
+		SDL_WaitThread(thread, nullptr);
+	}
+	_threads.clear();
+	_workers.clear();
+	SDL_DestroyCond(_done);
+	SDL_DestroyCond(_start);
+	SDL_DestroyMutex(_mutex);
+	_done = nullptr;
+	_start = nullptr;
+	_mutex = nullptr;
+}
+
+void WorkerPool::Run(const int chunks, const Job job, void* data)
+{
+	if (chunks <= 0) return;
+	if (_threads.empty()) {
+		for (int i = 0; i < chunks; i++) {
+			job(data, i, 0);
+		}
+		return;
+	}
+
+	SDL_LockMutex(_mutex);
+	_job = job;
+	_data = data;
+	_chunks = chunks;
+	SDL_AtomicSet(&_next_chunk, 0);
+	_generation++;
+	SDL_CondBroadcast(_start);
+	SDL_UnlockMutex(_mutex);
+
+	Work(0);
+
+	// worker that wake up late can still take chunk, wait for all of them
+	SDL_LockMutex(_mutex);
+	while (_active > 0 || SDL_AtomicGet(&_next_chunk) < _chunks) {
+		SDL_CondWait(_done, _mutex);
+	}
+	_job = nullptr;
+	_data = nullptr;
+	SDL_UnlockMutex(_mutex);
+}
+
+void WorkerPool::Work(const int worker)
+{
+	for (int chunk = SDL_AtomicAdd(&_next_chunk, 1); chunk < _chunks; chunk = SDL_AtomicAdd(&_next_chunk, 1)) {
+		_job(_data, chunk, worker);
+	}
+}
+
+int WorkerPool::ThreadFunction(void* data)
+{
+	const Worker* worker = static_cast<Worker*>(data);
+	WorkerPool* pool = worker->Pool;
+	Uint64 generation = 0;
+	for (;;) {
+		SDL_LockMutex(pool->_mutex);
+		while (!pool->_stop && pool->_generation == generation) {
+			SDL_CondWait(pool->_start, pool->_mutex);
+		}
+		if (pool->_stop) {
+			SDL_UnlockMutex(pool->_mutex);
+			return 0;
+		}
+		generation = pool->_generation;
+		pool->_active++;
+		SDL_UnlockMutex(pool->_mutex);
+
+		pool->Work(worker->Index);
+
+		SDL_LockMutex(pool->_mutex);
+		pool->_active--;
+		SDL_CondSignal(pool->_done);
+		SDL_UnlockMutex(pool->_mutex);
+	}
+}
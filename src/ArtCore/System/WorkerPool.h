@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+
+#include "SDL2/IncludeAll.h"
+
+// Fixed set of threads that execute chunks of one job, calling thread work too.
+// Run return when every chunk is done, so job data can live on caller stack.
+class WorkerPool final
+{
+public:
+	// worker 0 is calling thread, other are pool threads
+	typedef void (*Job)(void* data, int chunk, int worker);
+
+	WorkerPool() = default;
+	~WorkerPool();
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	bool Start(int threads);
+	void Stop();
+	void Run(int chunks, Job job, void* data);
+
+	// count of workers including calling thread
+	[[nodiscard]] int GetWorkersCount() const { return static_cast<int>(_threads.size()) + 1; }
+
+private:
+	struct Worker
+	{
+		WorkerPool* Pool;
+		int Index;
+	};
+	static int ThreadFunction(void* data);
+	void Work(int worker);
+
+	std::vector<SDL_Thread*> _threads;
+	std::vector<Worker> _workers;
+	SDL_mutex* _mutex = nullptr;
+	// new job is ready or pool is stopped
+	SDL_cond* _start = nullptr;
+	// all workers are back to wait
+	SDL_cond* _done = nullptr;
+
+	// job data, changed only when no worker is active
+	Job _job = nullptr;
+	void* _data = nullptr;
+	int _chunks = 0;
+	Uint64 _generation = 0;
+	int _active = 0;
+	bool _stop = false;
+	SDL_atomic_t _next_chunk{};
+};
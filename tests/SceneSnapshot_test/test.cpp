@@ -0,0 +1,72 @@
+#include "pch.h"
+
+#define tests
+#include "../../src/ArtCore/Scene/SnapshotStream.h"
+
+class SnapshotStreamTest : public ::testing::Test
+{
+public:
+	std::vector<Uint8> Data;
+	SnapshotWriter Writer{ Data };
+};
+
+TEST_F(SnapshotStreamTest, test_values_round_trip)
+{
+	Writer.Write<Uint64>(123456789012ULL);
+	Writer.Write(-5);
+	Writer.Write(1.25f);
+	Writer.WriteBool(true);
+	Writer.WriteBool(false);
+	Writer.WriteString("tag");
+	Writer.WriteString("");
+
+	SnapshotReader reader(Data);
+	EXPECT_EQ(reader.Read<Uint64>(), 123456789012ULL);
+	EXPECT_EQ(reader.Read<int>(), -5);
+	EXPECT_EQ(reader.Read<float>(), 1.25f);
+	EXPECT_EQ(reader.ReadBool(), true);
+	EXPECT_EQ(reader.ReadBool(), false);
+	EXPECT_EQ(reader.ReadString(), "tag");
+	EXPECT_EQ(reader.ReadString(), "");
+	EXPECT_EQ(reader.Remaining(), 0u);
+	EXPECT_EQ(reader.Failed, false);
+}
+
+TEST_F(SnapshotStreamTest, test_bool_only_zero_or_one)
+{
+	Writer.Write<Uint8>(1);
+	Writer.Write<Uint8>(2);
+	Writer.Write<Uint8>(0);
+
+	SnapshotReader reader(Data);
+	EXPECT_EQ(reader.ReadBool(), true);
+	EXPECT_EQ(reader.Failed, false);
+	EXPECT_EQ(reader.ReadBool(), false);
+	EXPECT_EQ(reader.Failed, true);
+	// broken data stay broken
+	EXPECT_EQ(reader.ReadBool(), false);
+	EXPECT_EQ(reader.Failed, true);
+}
+
+TEST_F(SnapshotStreamTest, test_read_after_end)
+{
+	Writer.Write<Uint16>(7);
+
+	SnapshotReader reader(Data);
+	EXPECT_EQ(reader.Read<Uint32>(), 0u);
+	EXPECT_EQ(reader.Failed, true);
+	// nothing is read after fail, even if there is enough data
+	EXPECT_EQ(reader.Read<Uint8>(), 0);
+	EXPECT_EQ(reader.Remaining(), 2u);
+}
+
+TEST_F(SnapshotStreamTest, test_string_size_after_end)
+{
+	// size bigger than data do not allocate and fail
+	Writer.Write<Uint32>(UINT32_MAX);
+	Writer.WriteBytes("abc", 3);
+
+	SnapshotReader reader(Data);
+	EXPECT_EQ(reader.ReadString(), "");
+	EXPECT_EQ(reader.Failed, true);
+}
@@ -3,6 +3,7 @@
 #include <random>
 #define tests
 #include "../../src/ArtCore/CodeExecutor/Stack.h"
+#include "../../src/ArtCore/CodeExecutor/OperandStack.h"
 
 class StackTest : public ::testing::Test
 {
@@ -81,4 +82,89 @@ TEST_F(StackTest, test_erase_stack)
 
 	EXPECT_EQ(StackInt.Size(), 0);
 	EXPECT_EQ(StackFloat.Size(), 0);
-}
\ No newline at end of file
+}
+
+class OperandStackTest : public ::testing::Test
+{
+public:
+	OperandStack Stack = OperandStack(4, 2);
+};
+
+TEST_F(OperandStackTest, test_mixed_values_order)
+{
+	Stack.PushInt(7);
+	Stack.PushFloat(2.5f);
+	Stack.PushString("text");
+	Stack.PushBool(true);
+	EXPECT_EQ(Stack.Size(), 4);
+	EXPECT_EQ(Stack.Top(), OperandStack::SlotType::BOOL);
+
+	EXPECT_EQ(Stack.PopBool(), true);
+	EXPECT_EQ(Stack.PopString(), "text");
+	EXPECT_EQ(Stack.PopFloat(), 2.5f);
+	EXPECT_EQ(Stack.PopInt(), 7);
+	EXPECT_EQ(Stack.IsEmpty(), true);
+}
+
+TEST_F(OperandStackTest, test_grow_and_erase)
+{
+	for (int i = 0; i < 1024; i++) {
+		Stack.PushInt(i);
+		Stack.PushString(std::to_string(i));
+	}
+	EXPECT_EQ(Stack.Size(), 2048);
+	EXPECT_EQ(Stack.PopString(), "1023");
+	EXPECT_EQ(Stack.PopInt(), 1023);
+
+	Stack.Erase();
+	EXPECT_EQ(Stack.IsEmpty(), true);
+	EXPECT_EQ(Stack.PopInt(), 0);
+	EXPECT_EQ(Stack.PopString(), "");
+}
+
+TEST_F(OperandStackTest, test_truncate_to_mark)
+{
+	Stack.PushInt(1);
+	Stack.PushString("kept");
+	const OperandStack::Mark mark = Stack.GetMark();
+	// values of call that are never popped
+	Stack.PushFloat(1.5f);
+	Stack.PushString("dropped");
+	Stack.PushString("dropped too");
+	Stack.Truncate(mark);
+	EXPECT_EQ(Stack.Size(), 2);
+
+	Stack.PushString("new");
+	EXPECT_EQ(Stack.PopString(), "new");
+	EXPECT_EQ(Stack.PopString(), "kept");
+	EXPECT_EQ(Stack.PopInt(), 1);
+	EXPECT_EQ(Stack.IsEmpty(), true);
+}
+
+TEST_F(OperandStackTest, test_strings_equal)
+{
+	// both interned, only ids are compared
+	Stack.PushString("enemy", 3);
+	Stack.PushString("enemy", 3);
+	EXPECT_EQ(Stack.PopStringsEqual(), true);
+	Stack.PushString("enemy", 3);
+	Stack.PushString("player", 4);
+	EXPECT_EQ(Stack.PopStringsEqual(), false);
+	// one is not interned, compare by content
+	Stack.PushString("enemy", 3);
+	Stack.PushString("enemy");
+	EXPECT_EQ(Stack.PopStringsEqual(), true);
+	Stack.PushString("enemy");
+	Stack.PushString("player");
+	EXPECT_EQ(Stack.PopStringsEqual(), false);
+	EXPECT_EQ(Stack.IsEmpty(), true);
+
+	// string pool is released by compare
+	Stack.PushInt(1);
+	Stack.PushString("first");
+	Stack.PushString("first");
+	Stack.PopStringsEqual();
+	Stack.PushString("next");
+	EXPECT_EQ(Stack.PopString(), "next");
+	EXPECT_EQ(Stack.PopInt(), 1);
+}